@@ -266,6 +266,12 @@ GEOSHausdorffDistanceDensify(const Geometry *g1, const Geometry *g2, double dens
     return GEOSHausdorffDistanceDensify_r( handle, g1, g2, densifyFrac, dist );
 }
 
+char
+GEOSHausdorffDistanceWithin(const Geometry *g1, const Geometry *g2, double maxDistance)
+{
+    return GEOSHausdorffDistanceWithin_r( handle, g1, g2, maxDistance );
+}
+
 int
 GEOSArea(const Geometry *g, double *area)
 {
@@ -436,6 +442,12 @@ GEOSUnaryUnion(const Geometry *g1)
     return GEOSUnaryUnion_r( handle, g1);
 }
 
+Geometry *
+GEOSCoverageUnion(const Geometry *g1)
+{
+    return GEOSCoverageUnion_r( handle, g1);
+}
+
 Geometry *
 GEOSUnionCascaded(const Geometry *g1)
 {
@@ -821,6 +833,12 @@ GEOSTopologyPreserveSimplify(const Geometry *g1, double tolerance)
     return GEOSTopologyPreserveSimplify_r( handle, g1, tolerance );
 }
 
+Geometry *
+GEOSSimplifyVW(const Geometry *g1, double tolerance)
+{
+    return GEOSSimplifyVW_r( handle, g1, tolerance );
+}
+
 
 /* WKT Reader */
 WKTReader *
@@ -998,6 +1016,12 @@ GEOSPreparedGeom_destroy(const geos::geom::prep::PreparedGeometry *a)
     GEOSPreparedGeom_destroy_r( handle, a );
 }
 
+int
+GEOSPreparedGeom_freeze(const geos::geom::prep::PreparedGeometry *pg)
+{
+    return GEOSPreparedGeom_freeze_r( handle, pg );
+}
+
 char
 GEOSPreparedContains(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2)
 {
@@ -1058,6 +1082,13 @@ GEOSPreparedWithin(const geos::geom::prep::PreparedGeometry *pg1, const Geometry
     return GEOSPreparedWithin_r( handle, pg1, g2 );
 }
 
+int
+GEOSPreparedContainsXY_many(const geos::geom::prep::PreparedGeometry *pg,
+        unsigned int n, const double *x, const double *y, char *result)
+{
+    return GEOSPreparedContainsXY_many_r( handle, pg, n, x, y, result );
+}
+
 STRtree *
 GEOSSTRtree_create (size_t nodeCapacity)
 {
@@ -1110,6 +1141,13 @@ GEOSProject (const geos::geom::Geometry *g,
     return GEOSProject_r (handle, g, p);
 }
 
+int
+GEOSProjectXY_many(const geos::geom::Geometry *g, unsigned int n,
+        const double *x, const double *y, double *result)
+{
+    return GEOSProjectXY_many_r(handle, g, n, x, y, result);
+}
+
 geos::geom::Geometry *
 GEOSInterpolate (const geos::geom::Geometry *g,
                  double d)
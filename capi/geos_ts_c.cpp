@@ -20,6 +20,7 @@
 #include <geos/geom/Geometry.h> 
 #include <geos/geom/prep/PreparedGeometry.h> 
 #include <geos/geom/prep/PreparedGeometryFactory.h> 
+#include <geos/geom/prep/PreparedPolygon.h> 
 #include <geos/geom/GeometryCollection.h> 
 #include <geos/geom/Polygon.h> 
 #include <geos/geom/Point.h> 
@@ -45,17 +46,21 @@
 #include <geos/algorithm/BoundaryNodeRule.h>
 #include <geos/simplify/DouglasPeuckerSimplifier.h>
 #include <geos/simplify/TopologyPreservingSimplifier.h>
+#include <geos/simplify/VWSimplifier.h>
 #include <geos/operation/valid/IsValidOp.h>
 #include <geos/operation/polygonize/Polygonizer.h>
 #include <geos/operation/linemerge/LineMerger.h>
 #include <geos/operation/overlay/OverlayOp.h>
 #include <geos/operation/union/CascadedPolygonUnion.h>
+#include <geos/operation/union/CoverageUnion.h>
 #include <geos/operation/buffer/BufferOp.h>
 #include <geos/operation/buffer/BufferParameters.h>
 #include <geos/operation/buffer/BufferBuilder.h>
+#include <geos/operation/buffer/FilletTemplateCache.h>
 #include <geos/operation/relate/RelateOp.h>
 #include <geos/operation/sharedpaths/SharedPathsOp.h>
 #include <geos/linearref/LengthIndexedLine.h>
+#include <geos/linearref/IndexedLengthIndexedLine.h>
 #include <geos/geom/BinaryOp.h>
 #include <geos/util/IllegalArgumentException.h>
 #include <geos/util/UniqueCoordinateArrayFilter.h>
@@ -122,6 +127,7 @@ using geos::operation::overlay::overlayOp;
 using geos::operation::geounion::CascadedPolygonUnion;
 using geos::operation::buffer::BufferParameters;
 using geos::operation::buffer::BufferBuilder;
+using geos::operation::buffer::FilletTemplateCache;
 using geos::util::IllegalArgumentException;
 using geos::algorithm::distance::DiscreteHausdorffDistance;
 
@@ -135,6 +141,8 @@ typedef struct GEOSContextHandleInternal
     int WKBOutputDims;
     int WKBByteOrder;
     int initialized;
+    // shared by all buffer operations run on this context
+    FilletTemplateCache *filletTemplateCache;
 } GEOSContextHandleInternal_t;
 
 // CAPI_ItemVisitor is used internally by the CAPI STRtree
@@ -201,6 +209,7 @@ initGEOS_r(GEOSMessageHandler nf, GEOSMessageHandler ef)
         handle->geomFactory = GeometryFactory::getDefaultInstance();
         handle->WKBOutputDims = 2;
         handle->WKBByteOrder = getMachineByteOrder();
+        handle->filletTemplateCache = new FilletTemplateCache();
         handle->initialized = 1;
     }
 
@@ -244,6 +253,13 @@ GEOSContext_setErrorHandler_r(GEOSContextHandle_t extHandle, GEOSMessageHandler
 void
 finishGEOS_r(GEOSContextHandle_t extHandle)
 {
+    if ( 0 != extHandle )
+    {
+        GEOSContextHandleInternal_t *handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        delete handle->filletTemplateCache;
+    }
+
     // Fix up freeing handle w.r.t. malloc above
     std::free(extHandle);
     extHandle = NULL;
@@ -1075,6 +1091,39 @@ GEOSHausdorffDistanceDensify_r(GEOSContextHandle_t extHandle, const Geometry *g1
     return 0;
 }
 
+char
+GEOSHausdorffDistanceWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double maxDistance)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        bool result = DiscreteHausdorffDistance::isWithinDistance(*g1, *g2,
+                                                       maxDistance);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 2;
+}
+
 int
 GEOSArea_r(GEOSContextHandle_t extHandle, const Geometry *g, double *area)
 {
@@ -1640,7 +1689,12 @@ GEOSBuffer_r(GEOSContextHandle_t extHandle, const Geometry *g1, double width, in
 
     try
     {
-        Geometry *g3 = g1->buffer(width, quadrantsegments);
+        using geos::operation::buffer::BufferOp;
+
+        BufferOp op(g1);
+        op.setQuadrantSegments(quadrantsegments);
+        op.setFilletTemplateCache(handle->filletTemplateCache);
+        Geometry *g3 = op.getResultGeometry(width);
         return g3;
     }
     catch (const std::exception &e)
@@ -1696,6 +1750,7 @@ GEOSBufferWithStyle_r(GEOSContextHandle_t extHandle, const Geometry *g1, double
         );
         bp.setMitreLimit(mitreLimit);
         BufferOp op(g1, bp);
+        op.setFilletTemplateCache(handle->filletTemplateCache);
         Geometry *g3 = op.getResultGeometry(width);
         return g3;
     }
@@ -1741,7 +1796,8 @@ GEOSOffsetCurve_r(GEOSContextHandle_t extHandle, const Geometry *g1, double widt
           width = -width;
         }
         BufferBuilder bufBuilder (bp);
-        Geometry *g3 = bufBuilder.bufferLineSingleSided(g1, width, isLeftSide);
+        bufBuilder.setFilletTemplateCache(handle->filletTemplateCache);
+        Geometry *g3 = bufBuilder.offsetCurve(g1, width, isLeftSide);
 
         return g3;
     }
@@ -1784,7 +1840,8 @@ GEOSSingleSidedBuffer_r(GEOSContextHandle_t extHandle, const Geometry *g1, doubl
 
         bool isLeftSide = leftSide == 0 ? false : true;
         BufferBuilder bufBuilder (bp);
-        Geometry *g3 = bufBuilder.bufferLineSingleSided(g1, width, isLeftSide);
+        bufBuilder.setFilletTemplateCache(handle->filletTemplateCache);
+        Geometry *g3 = bufBuilder.offsetCurve(g1, width, isLeftSide);
 
         return g3;
     }
@@ -2017,6 +2074,39 @@ GEOSUnaryUnion_r(GEOSContextHandle_t extHandle, const Geometry *g)
     return NULL;
 }
 
+Geometry *
+GEOSCoverageUnion_r(GEOSContextHandle_t extHandle, const Geometry *g)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        using geos::operation::geounion::CoverageUnion;
+        GeomAutoPtr g3 ( CoverageUnion::Union(*g) );
+        return g3.release();
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return NULL;
+}
+
 Geometry *
 GEOSUnionCascaded_r(GEOSContextHandle_t extHandle, const Geometry *g1)
 {
@@ -4104,6 +4194,39 @@ GEOSTopologyPreserveSimplify_r(GEOSContextHandle_t extHandle, const Geometry *g1
     return NULL;
 }
 
+Geometry *
+GEOSSimplifyVW_r(GEOSContextHandle_t extHandle, const Geometry *g1, double tolerance)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        using namespace geos::simplify;
+        Geometry::AutoPtr g(VWSimplifier::simplify(g1, tolerance));
+        return g.release();
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return NULL;
+}
+
 
 /* WKT Reader */
 WKTReader *
@@ -5022,6 +5145,41 @@ GEOSPreparedGeom_destroy_r(GEOSContextHandle_t extHandle, const geos::geom::prep
     }
 }
 
+int
+GEOSPreparedGeom_freeze_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg)
+{
+    assert(0 != pg);
+
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try 
+    {
+        pg->freeze();
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
 char
 GEOSPreparedContains_r(GEOSContextHandle_t extHandle,
         const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
@@ -5382,6 +5540,66 @@ GEOSPreparedWithin_r(GEOSContextHandle_t extHandle,
     return 2;
 }
 
+int
+GEOSPreparedContainsXY_many_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, unsigned int n,
+        const double *x, const double *y, char *result)
+{
+    assert(0 != pg);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    if ( 0 == n ) return 1;
+    assert(0 != x);
+    assert(0 != y);
+    assert(0 != result);
+
+    try 
+    {
+        using geos::geom::prep::PreparedPolygon;
+
+        const PreparedPolygon* ppoly =
+            dynamic_cast<const PreparedPolygon*>(pg);
+        if ( ppoly )
+        {
+            ppoly->containsXY(n, x, y,
+                              reinterpret_cast<unsigned char*>(result));
+            return 1;
+        }
+
+        // Not polygonal: test one point at a time
+        using geos::geom::Coordinate;
+        using geos::geom::Point;
+        const GeometryFactory* gf = pg->getGeometry().getFactory();
+        for ( unsigned int i = 0; i < n; ++i )
+        {
+            std::auto_ptr<Point> pt(gf->createPoint(Coordinate(x[i], y[i])));
+            result[i] = pg->contains(pt.get());
+        }
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 0;
+}
+
 //-----------------------------------------------------------------
 // STRtree
 //-----------------------------------------------------------------
@@ -5672,6 +5890,39 @@ GEOSProject_r(GEOSContextHandle_t extHandle,
 }
 
 
+int
+GEOSProjectXY_many_r(GEOSContextHandle_t extHandle, const Geometry *g,
+        unsigned int n, const double *x, const double *y, double *result)
+{
+    if ( 0 == extHandle ) return 0;
+    GEOSContextHandleInternal_t *handle =
+        reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( handle->initialized == 0 ) return 0;
+
+    if ( 0 == n ) return 1;
+    if ( 0 == x || 0 == y || 0 == result )
+    {
+        handle->ERROR_MESSAGE("GEOSProjectXY_many: null coordinate or result array");
+        return 0;
+    }
+
+    try {
+        geos::linearref::IndexedLengthIndexedLine lil(g);
+        for ( unsigned int i = 0; i < n; ++i )
+        {
+            result[i] = lil.project(geos::geom::Coordinate(x[i], y[i]));
+        }
+        return 1;
+    } catch (const std::exception &e) {
+        handle->ERROR_MESSAGE("%s", e.what());
+        return 0;
+    } catch (...) {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+        return 0;
+    }
+}
+
+
 Geometry*
 GEOSInterpolate_r(GEOSContextHandle_t extHandle, const Geometry *g, double d)
 {
@@ -6093,6 +6344,7 @@ GEOSBufferWithParams_r(GEOSContextHandle_t extHandle, const Geometry *g1, const
     try
     {
         BufferOp op(g1, *bp);
+        op.setFilletTemplateCache(handle->filletTemplateCache);
         Geometry *g3 = op.getResultGeometry(width);
         return g3;
     }
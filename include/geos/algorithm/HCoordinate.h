@@ -63,6 +63,22 @@ public:
 				 const geom::Coordinate &q2,
 				 geom::Coordinate &ret);
 
+	/** \brief
+	 * Same as intersection(), but reports a non-representable
+	 * intersection (parallel or nearly parallel lines) by
+	 * returning false instead of throwing.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @return true if an intersection point was computed into ret,
+	 *         false otherwise (ret is left untouched)
+	 */
+	static bool tryIntersection(const geom::Coordinate &p1,
+				 const geom::Coordinate &p2,
+				 const geom::Coordinate &q1,
+				 const geom::Coordinate &q2,
+				 geom::Coordinate &ret);
+
 	double x,y,w;
 
 	HCoordinate();
@@ -23,6 +23,7 @@
 #include <geos/export.h>
 
 #include <vector>
+#include <cstddef> // for std::size_t
 
 // forward declarations
 namespace geos {
@@ -93,6 +94,24 @@ public:
 	static int locatePointInRing(const geom::Coordinate& p,
 	         const std::vector<const geom::Coordinate*>& ring);
 
+	/** \brief
+	 * Semantically equal to the above, for a ring stored as
+	 * a contiguous array of coordinates.
+	 *
+	 * Segments are scanned in blocks, discarding the ones
+	 * lying entirely above, below or left of the point
+	 * with branch-free comparisons, so that only the few
+	 * segments which may touch the ray get counted.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param p the point to test
+	 * @param ring the ring vertices
+	 * @param n the number of ring vertices
+	 */
+	static int locatePointInRing(const geom::Coordinate& p,
+	         const geom::Coordinate* ring, std::size_t n);
+
 	RayCrossingCounter(const geom::Coordinate& point)
 	:	point( point),
 		crossingCount( 0),
@@ -55,6 +55,12 @@ public:
 	 * Computes the sign of the determinant of the 2x2 matrix
 	 * with the given entries, in a robust way.
 	 *
+	 * The determinant is first evaluated in floating point:
+	 * when its magnitude exceeds a bound on the rounding error
+	 * (as in Shewchuk's adaptive predicates) that sign is
+	 * returned right away. Only nearly degenerate or non-finite
+	 * inputs go through the exact algorithm.
+	 *
 	 * @return -1 if the determinant is negative,
 	 * @return  1 if the determinant is positive,
 	 * @return  0 if the determinant is 0.
@@ -96,6 +96,12 @@ namespace distance { // geos::algorithm::distance
  *   DHD(A, B) = 22.360679774997898
  *   HD(A, B) ~= 47.8
  * </pre>
+ *
+ * The distance from each discrete point to the other geometry is
+ * only computed when it may raise the maximum found so far: a
+ * point is skipped as soon as a segment closer than that maximum
+ * is found. Segments of large geometries are looked up through an
+ * STRtree.
  */
 class GEOS_DLL DiscreteHausdorffDistance
 {
@@ -107,6 +113,21 @@ public:
 	static double distance(const geom::Geometry& g0,
 	                       const geom::Geometry& g1, double densifyFrac);
 
+	/** \brief
+	 * Tests whether the discrete Hausdorff distance between
+	 * two geometries is at most the given distance.
+	 *
+	 * Stops at the first discrete point farther than maxDistance
+	 * from the other geometry.
+	 */
+	static bool isWithinDistance(const geom::Geometry& g0,
+	                             const geom::Geometry& g1,
+	                             double maxDistance);
+
+	static bool isWithinDistance(const geom::Geometry& g0,
+	                             const geom::Geometry& g1,
+	                             double maxDistance, double densifyFrac);
+
 	DiscreteHausdorffDistance(const geom::Geometry& g0,
 	                          const geom::Geometry& g1)
 		:
@@ -147,6 +168,16 @@ public:
 		return ptDist.getDistance();
 	}
 
+	/** \brief
+	 * Tests whether the distance is at most maxDistance,
+	 * without computing it.
+	 */
+	bool isWithinDistance(double maxDistance)
+	{
+		return isOrientedWithinDistance(g0, g1, maxDistance) &&
+		       isOrientedWithinDistance(g1, g0, maxDistance);
+	}
+
 	const std::vector<geom::Coordinate> getCoordinates() const
 	{
 		return ptDist.getCoordinates();
@@ -232,6 +263,10 @@ private:
 	                             const geom::Geometry& geom,
 	                             PointPairDistance& ptDist);
 
+	bool isOrientedWithinDistance(const geom::Geometry& discreteGeom,
+	                              const geom::Geometry& geom,
+	                              double maxDistance);
+
 	const geom::Geometry& g0;
 
 	const geom::Geometry& g1;
@@ -20,6 +20,7 @@
 #include <geos/index/ItemVisitor.h> // inherited
 
 #include <vector> // composition
+#include <cstddef> // for std::size_t
 
 namespace geos {
 	namespace algorithm {
@@ -66,11 +67,17 @@ private:
 		// To keep track of allocated LineSegments
 		std::vector< geom::LineSegment* > allocatedSegments;
 
+		// Sum of the y extents of the indexed segments
+		double totalSegmentHeight;
+
 	public:
 		IntervalIndexedGeometry( const geom::Geometry & g);
 		~IntervalIndexedGeometry();
 
 		void query(double min, double max, index::ItemVisitor * visitor);
+
+		/// Returns the mean y extent of the indexed segments
+		double getAverageSegmentHeight() const;
 	};
 
 
@@ -117,6 +124,25 @@ public:
 	 */
 	int locate( const geom::Coordinate * /*const*/ p);
 
+	/** \brief
+	 * Determines the {@link Location} of many points in an
+	 * areal {@link Geometry}.
+	 *
+	 * Gives the same results as calling locate() for each point,
+	 * but the points are processed in order of y so that nearby
+	 * points share a single traversal of the interval index.
+	 * Points with a NaN ordinate are reported as exterior.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param n the number of points
+	 * @param xs the n x ordinates of the points
+	 * @param ys the n y ordinates of the points
+	 * @param locations receives the n locations, in input order
+	 */
+	void locate(std::size_t n, const double* xs, const double* ys,
+	            int* locations);
+
 };
 
 } // geos::algorithm::locate
@@ -171,6 +171,12 @@ public:
 	 */
 	bool within(const geom::Geometry * g) const;
 
+	/**
+	 * Computes the envelopes of all the base geometry components
+	 * and the dimension of their coordinate sequences.
+	 */
+	void freeze() const;
+
 	std::string toString();
 
 };
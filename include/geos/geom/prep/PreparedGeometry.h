@@ -48,6 +48,12 @@ namespace prep { // geos::geom::prep
  * and delegate others. 
  * See the implementing classes for documentation about which methods and situations
  * they optimize.
+ *
+ * Indexes are built lazily, on the first predicate needing them.
+ * Once freeze() has been called, the predicates no longer modify the
+ * prepared geometry nor its base geometry, so they can be evaluated
+ * by concurrent threads sharing a single PreparedGeometry.
+ * The test geometries are not frozen: each thread needs its own.
  * 
  */
 class GEOS_DLL PreparedGeometry {
@@ -191,6 +197,20 @@ public:
 	 * @see Geometry#within(Geometry)
 	 */
 	virtual bool within(const geom::Geometry *geom) const =0;
+
+	/**
+	 * Builds now all the state otherwise computed on first use,
+	 * by this prepared geometry (indexes) and by the base
+	 * {@link Geometry} (component envelopes).
+	 *
+	 * After this call, the predicates of this PreparedGeometry can be
+	 * called by any number of concurrent threads, as long as no
+	 * thread modifies the base Geometry and no test Geometry is
+	 * shared between threads.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	virtual void freeze() const =0;
 };
 
 
@@ -60,6 +60,9 @@ public:
 
 	bool intersects(const geom::Geometry * g) const;
 
+	/// Also builds the intersection finder
+	void freeze() const;
+
 };
 
 } // namespace geos::geom::prep
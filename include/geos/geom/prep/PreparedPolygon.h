@@ -23,6 +23,8 @@
 #include <geos/geom/prep/BasicPreparedGeometry.h> // for inheritance
 #include <geos/noding/SegmentString.h> 
 
+#include <cstddef> // for std::size_t
+
 namespace geos {
 	namespace noding {
 		class FastSegmentSetIntersectionFinder;
@@ -66,6 +68,27 @@ public:
 	bool covers( const geom::Geometry* g) const;
 	bool intersects( const geom::Geometry* g) const;
 
+	/** \brief
+	 * Tests whether this polygon contains each of many points,
+	 * given as raw coordinates.
+	 *
+	 * Equivalent to calling contains() with a Point for each
+	 * coordinate pair, without creating any geometry.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param n the number of points
+	 * @param xs the n x ordinates of the points
+	 * @param ys the n y ordinates of the points
+	 * @param results receives 1 for each contained point and
+	 *                0 otherwise, in input order
+	 */
+	void containsXY(std::size_t n, const double* xs, const double* ys,
+	                unsigned char* results) const;
+
+	/// Also builds the intersection finder and the point locator
+	void freeze() const;
+
 };
 
 } // namespace geos::geom::prep
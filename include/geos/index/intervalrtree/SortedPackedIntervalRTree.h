@@ -84,6 +84,16 @@ public:
 	 */
 	void query( double min, double max, index::ItemVisitor * visitor);
 
+	/**
+	 * Builds the index now rather than on the first query.
+	 *
+	 * Once built, queries do not modify the index, so it can be
+	 * queried by concurrent threads.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	void build() { init(); }
+
 };
 
 } // geos::intervalrtree
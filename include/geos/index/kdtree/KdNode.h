@@ -0,0 +1,102 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: index/kdtree/KdNode.java rev 1.12 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_KDTREE_KDNODE_H
+#define GEOS_INDEX_KDTREE_KDNODE_H
+
+#include <geos/export.h>
+
+#include <geos/geom/Coordinate.h> // for composition
+
+namespace geos {
+namespace index { // geos::index
+namespace kdtree { // geos::index::kdtree
+
+/** \brief
+ * A node of a {@link KdTree}, which represents one or more points
+ * in the same location.
+ *
+ * Nodes are owned by the KdTree they were inserted into.
+ */
+class GEOS_DLL KdNode {
+
+public:
+
+	/**
+	 * Creates a new KdNode.
+	 *
+	 * @param p the point location of the new node
+	 * @param data a data object to associate with this node,
+	 *             ownership left to caller
+	 */
+	KdNode(const geom::Coordinate& p, void* data)
+		:
+		p(p),
+		data(data),
+		left(0),
+		right(0),
+		count(1)
+	{}
+
+	/// Returns the X coordinate of the node
+	double getX() const { return p.x; }
+
+	/// Returns the Y coordinate of the node
+	double getY() const { return p.y; }
+
+	/// Returns the location of this node
+	const geom::Coordinate& getCoordinate() const { return p; }
+
+	/// Gets the user data object associated with this node
+	void* getData() const { return data; }
+
+	/// Returns the left node of the tree
+	KdNode* getLeft() const { return left; }
+
+	/// Returns the right node of the tree
+	KdNode* getRight() const { return right; }
+
+	/// Increments the count of points at this location
+	void increment() { ++count; }
+
+	/// Returns the number of inserted points that are coincident
+	/// at this location
+	int getCount() const { return count; }
+
+	/// Tests whether more than one point with this value have
+	/// been inserted (up to the tolerance)
+	bool isRepeated() const { return count > 1; }
+
+	/// Sets the left node value
+	void setLeft(KdNode* nLeft) { left = nLeft; }
+
+	/// Sets the right node value
+	void setRight(KdNode* nRight) { right = nRight; }
+
+private:
+
+	geom::Coordinate p;
+	void* data;
+	KdNode* left;
+	KdNode* right;
+	int count;
+};
+
+} // namespace geos::index::kdtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_KDTREE_KDNODE_H
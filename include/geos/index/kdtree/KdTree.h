@@ -0,0 +1,155 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: index/kdtree/KdTree.java rev 1.12 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_KDTREE_KDTREE_H
+#define GEOS_INDEX_KDTREE_KDTREE_H
+
+#include <geos/export.h>
+
+#include <geos/index/kdtree/KdNode.h> // for composition
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+		class Envelope;
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace kdtree { // geos::index::kdtree
+
+/** \brief
+ * An implementation of a 2-D KD-Tree.
+ *
+ * KD-trees provide fast range searching on point data.
+ *
+ * This implementation supports detecting and snapping points
+ * which are closer than a given tolerance value.
+ * If the same point (up to tolerance) is inserted more than once,
+ * it is snapped to the existing node.
+ * In other words, if a point is inserted which lies within the
+ * tolerance of a node already in the index, it is snapped to that
+ * node.
+ * When a point is snapped to a node then a new node is not created
+ * but the count of the existing node is incremented.
+ * If more than one node in the tree is within tolerance of an
+ * inserted point, the closest one is chosen.
+ *
+ * Note that the structure of a KD-Tree depends on the order of
+ * insertion of the points.
+ * A tree may become imbalanced if the inserted points are coherent
+ * (e.g. monotonic in one or both dimensions).
+ * A perfectly balanced tree has depth of only log2(N),
+ * but an imbalanced tree may be much deeper.
+ * Inserting coherent points in a random order avoids this.
+ *
+ * Insertion and queries are not recursive, so deep trees are
+ * slow but never exhaust the stack.
+ */
+class GEOS_DLL KdTree {
+
+public:
+
+	/// Creates a new instance of a KdTree with a snapping tolerance
+	/// of 0.0 (i.e. distinct points will <i>not</i> be snapped)
+	KdTree();
+
+	/**
+	 * Creates a new instance of a KdTree, specifying a snapping
+	 * distance tolerance.
+	 *
+	 * Points which lie closer than the tolerance to a point already
+	 * in the tree will be treated as identical to the existing point.
+	 *
+	 * @param tolerance the tolerance distance for considering two
+	 *                  points equal
+	 */
+	explicit KdTree(double tolerance);
+
+	/// Tests whether the index contains any items
+	bool isEmpty() const { return root == 0; }
+
+	/// Returns the number of distinct nodes in the tree
+	std::size_t size() const { return nodes.size(); }
+
+	/**
+	 * Inserts a new point in the kd-tree, with no data.
+	 *
+	 * @param p the point to insert
+	 * @return the kdnode containing the point, owned by the tree
+	 */
+	KdNode* insert(const geom::Coordinate& p);
+
+	/**
+	 * Inserts a new point into the kd-tree.
+	 *
+	 * @param p the point to insert
+	 * @param data a data item for the point, ownership left to caller
+	 * @return returns a new KdNode if a new point is inserted,
+	 *         else an existing node is returned with its counter
+	 *         incremented. This can be checked by testing
+	 *         returnedNode.getCount() > 1.
+	 */
+	KdNode* insert(const geom::Coordinate& p, void* data);
+
+	/**
+	 * Performs a range search of the points in the index.
+	 *
+	 * @param queryEnv the range rectangle to query
+	 * @param result a vector to which the KdNodes found are added
+	 */
+	void query(const geom::Envelope& queryEnv,
+	           std::vector<KdNode*>& result) const;
+
+private:
+
+	KdNode* root;
+
+	double tolerance;
+
+	/// Owns the nodes, a deque keeps their addresses stable
+	std::deque<KdNode> nodes;
+
+	/// Finds the node closest to p within the tolerance, if any
+	KdNode* findBestMatchNode(const geom::Coordinate& p) const;
+
+	KdNode* insertExact(const geom::Coordinate& p, void* data);
+
+	// Declare type as noncopyable
+	KdTree(const KdTree& other);
+	KdTree& operator=(const KdTree& rhs);
+};
+
+} // namespace geos::index::kdtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_KDTREE_KDTREE_H
@@ -119,12 +119,14 @@ public:
 
 	void insert(const geom::Envelope *itemEnv,void* item);
 
-	//static double centreX(const geom::Envelope *e);
-
 	static double avg(double a, double b) {
 		return (a + b) / 2.0;
 	}
 
+	static double centreX(const geom::Envelope *e) {
+		return STRtree::avg(e->getMinX(), e->getMaxX());
+	}
+
 	static double centreY(const geom::Envelope *e) {
 		return STRtree::avg(e->getMinY(), e->getMaxY());
 	}
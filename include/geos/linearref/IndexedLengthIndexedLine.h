@@ -0,0 +1,227 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_LINEARREF_INDEXEDLENGTHINDEXEDLINE_H
+#define GEOS_LINEARREF_INDEXEDLENGTHINDEXEDLINE_H
+
+#include <geos/export.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/linearref/LinearLocation.h>
+
+#include <vector>
+#include <memory> // for auto_ptr
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+	}
+}
+
+namespace geos
+{
+namespace linearref   // geos::linearref
+{
+
+/** \brief
+ * A {@link LengthIndexedLine} which precomputes the cumulative
+ * length at each vertex of the line.
+ *
+ * Locating an index takes O(log n) time instead of walking the
+ * line, and a batch of ascending indices is located in a single
+ * sweep of the line.
+ * Points are projected onto the line through an STRtree of its
+ * segments, built on the first projection.
+ * Results are identical to those of LengthIndexedLine, which
+ * should be preferred when only a few lookups are made.
+ *
+ * The linear geometry must not be modified nor destroyed
+ * while this object is in use.
+ */
+class GEOS_DLL IndexedLengthIndexedLine
+{
+
+public:
+
+	/** \brief
+	 * Constructs an object which allows a linear {@link Geometry}
+	 * to be linearly referenced using length as an index.
+	 *
+	 * Takes O(n) time in the number of vertices of the geometry.
+	 *
+	 * @param linearGeom the linear geometry to reference along
+	 */
+	IndexedLengthIndexedLine(const geom::Geometry *linearGeom);
+
+	~IndexedLengthIndexedLine();
+
+	/// See LengthIndexedLine::extractPoint(double)
+	geom::Coordinate extractPoint(double index) const;
+
+	/// See LengthIndexedLine::extractPoint(double, double)
+	geom::Coordinate extractPoint(double index, double offsetDistance) const;
+
+	/** \brief
+	 * Computes the {@link Coordinate} of the point at each of
+	 * the given indices, as extractPoint(double) would.
+	 *
+	 * Runs of ascending indices are located by sweeping the line
+	 * forward, so that sorting the indices beforehand makes the
+	 * whole batch take time linear in the size of the line and
+	 * of the batch.
+	 *
+	 * @param indices the indices of the desired points
+	 * @param result the vector to append the points to
+	 */
+	void extractPoints(const std::vector<double>& indices,
+	                   std::vector<geom::Coordinate>& result) const;
+
+	/// See LengthIndexedLine::extractLine
+	geom::Geometry *extractLine(double startIndex, double endIndex) const;
+
+	/** \brief
+	 * Computes the {@link LinearLocation} of an index,
+	 * resolved to the lowest possible location value.
+	 */
+	LinearLocation locationOf(double index) const;
+
+	/** \brief
+	 * Computes the {@link LinearLocation} of an index.
+	 *
+	 * @param index the length index
+	 * @param resolveLower if false, an index at the end of a
+	 *                     component is resolved to the start of
+	 *                     the next one
+	 */
+	LinearLocation locationOf(double index, bool resolveLower) const;
+
+	/** \brief
+	 * Computes the length index of a {@link LinearLocation}
+	 * on the line.
+	 */
+	double indexOf(const LinearLocation& loc) const;
+
+	/// See LengthIndexedLine::indexOf(const Coordinate&)
+	double indexOf(const geom::Coordinate& pt) const;
+
+	/// See LengthIndexedLine::indexOfAfter
+	double indexOfAfter(const geom::Coordinate& pt, double minIndex) const;
+
+	/** \brief
+	 * Computes the index for the closest point on the line to
+	 * the given point.
+	 *
+	 * If more than one point has the closest distance the first
+	 * one along the line is returned.
+	 * Only the segments near the point are looked at, except for
+	 * the first call, which indexes the segments of the line.
+	 *
+	 * @param pt a point
+	 * @return the index of the closest point on the line
+	 */
+	double project(const geom::Coordinate& pt) const;
+
+	/// See LengthIndexedLine::indicesOf
+	double* indicesOf(const geom::Geometry *subLine) const;
+
+	double getStartIndex() const;
+
+	double getEndIndex() const;
+
+	bool isValidIndex(double index) const;
+
+	double clampIndex(double index) const;
+
+private:
+
+	/*
+	 * A position of a LinearIterator over the line: either
+	 * a segment, or the last vertex of a component.
+	 */
+	struct Position {
+		/// Length along the line up to the segment start
+		double start;
+		/// Segment length, or -1 at the end of a component
+		double length;
+		unsigned int componentIndex;
+		unsigned int vertexIndex;
+
+		bool isEndOfLine() const { return length < 0.0; }
+
+		/*
+		 * Length at which LengthLocationMap compares this
+		 * position to the searched length.
+		 * Non-decreasing along the line.
+		 */
+		double key() const
+		{
+			return isEndOfLine() ? start : start + length;
+		}
+	};
+
+	class SegmentIndex;
+
+	const geom::Geometry *linearGeom;
+
+	/// Positions in iteration order
+	std::vector<Position> positions;
+
+	/// The geometry length, as measured by Geometry::getLength()
+	double lineLength;
+
+	/// The sum of the segment lengths
+	double totalLength;
+
+	/// Built on the first projection
+	mutable std::auto_ptr<SegmentIndex> segmentIndex;
+
+	/*
+	 * Index of the closest point on the line to pt, among those
+	 * whose index is greater than minIndex; minIndex if none.
+	 */
+	double indexOfFromStart(const geom::Coordinate& pt, double minIndex) const;
+
+	double positiveIndex(double index) const;
+
+	/*
+	 * Returns the first position from 'from' at which
+	 * LengthLocationMap stops walking for the given non-negative
+	 * length, or the number of positions if there is none.
+	 */
+	std::size_t findPosition(double length, std::size_t from) const;
+
+	/*
+	 * Computes the location of a non-negative length found at
+	 * the given position.
+	 */
+	LinearLocation locationAt(std::size_t pos, double length) const;
+
+	LinearLocation locationOfForward(double length) const;
+
+	// Declare type as noncopyable
+	IndexedLengthIndexedLine(const IndexedLengthIndexedLine& other);
+	IndexedLengthIndexedLine& operator=(const IndexedLengthIndexedLine& rhs);
+};
+
+} // geos::linearref
+} // geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_LINEARREF_INDEXEDLENGTHINDEXEDLINE_H
@@ -93,6 +93,18 @@ public:
 	 */
 	static double getLength(const geom::Geometry *linearGeom, const LinearLocation& loc);
 
+	/**
+	 * \brief
+	 * Resolves a location at the end of a component to the start
+	 * of the next component of non-zero length, if any.
+	 *
+	 * @param linearGeom the linear geometry loc refers to
+	 * @param loc a location on linearGeom
+	 * @return the highest location equivalent to loc
+	 */
+	static LinearLocation resolveHigher(const geom::Geometry *linearGeom,
+	                                    const LinearLocation& loc);
+
 	LengthLocationMap(const geom::Geometry *linearGeom);
 
 	/**
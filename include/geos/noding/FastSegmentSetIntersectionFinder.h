@@ -50,7 +50,6 @@ class FastSegmentSetIntersectionFinder
 {
 private:
 	MCIndexSegmentSetMutualIntersector * segSetMutInt; 
-	geos::algorithm::LineIntersector * lineIntersector;
 
 protected:
 public:
@@ -69,8 +68,14 @@ public:
 		return segSetMutInt;
 	}
 
-	bool intersects( SegmentString::ConstVect * segStrings);
-	bool intersects( SegmentString::ConstVect * segStrings, SegmentIntersectionDetector * intDetector);
+	/**
+	 * Tests whether the given SegmentStrings intersect the base ones.
+	 *
+	 * The tests do not modify this object, so they can be run
+	 * by concurrent threads.
+	 */
+	bool intersects( SegmentString::ConstVect * segStrings) const;
+	bool intersects( SegmentString::ConstVect * segStrings, SegmentIntersectionDetector * intDetector) const;
 
 };
 
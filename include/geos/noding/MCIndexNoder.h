@@ -28,6 +28,7 @@
 #include <geos/index/strtree/STRtree.h> // for composition
 #include <geos/util.h>
 
+#include <cstddef> // for size_t
 #include <vector>
 #include <iostream>
 
@@ -58,11 +59,48 @@ namespace noding { // geos.noding
  * envelope (range) queries efficiently (such as a index::quadtree::Quadtree
  * or index::strtree::STRtree.
  *
+ * The search for overlapping chains can be split into partitions,
+ * which callers can run concurrently: see partitionOverlaps(),
+ * computePartitionOverlaps() and mergePartitionOverlaps(), or
+ * setPartitionRunner() to have computeNodes() use them.
+ *
  * Last port: noding/MCIndexNoder.java rev. 1.4 (JTS-1.7)
  */
 class GEOS_DLL MCIndexNoder : public SinglePassNoder {
 
+public:
+
+	/** \brief
+	 * Runs the overlap partitions of a MCIndexNoder, possibly
+	 * concurrently.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	class GEOS_DLL PartitionRunner {
+	public:
+		virtual ~PartitionRunner() {}
+
+		/**
+		 * Calls noder.computePartitionOverlaps(i) once for each
+		 * i in [0, noder.getNumPartitions()), from any threads,
+		 * and returns once all the calls have returned.
+		 * An exception thrown by a call must be rethrown here.
+		 */
+		virtual void runPartitions(MCIndexNoder& noder) = 0;
+	};
+
 private:
+
+	/// A pair of segments whose envelopes overlap
+	struct SegmentPair {
+		SegmentString* ss1;
+		std::size_t start1;
+		SegmentString* ss2;
+		std::size_t start2;
+	};
+
+	class SegmentPairCollector;
+
 	std::vector<index::chain::MonotoneChain*> monoChains;
 	index::strtree::STRtree index;
 	int idCounter;
@@ -70,6 +108,13 @@ private:
 	// statistics
 	int nOverlaps;
 
+	PartitionRunner* partitionRunner;
+	std::size_t maxPartitionSize;
+
+	std::size_t partitionSize;
+	std::vector< std::vector<SegmentPair> > partitionPairs;
+	std::vector<int> partitionOverlapCounts;
+
 	void intersectChains();
 
 	void add(SegmentString* segStr);
@@ -81,11 +126,82 @@ public:
 		SinglePassNoder(nSegInt),
 		idCounter(0),
 		nodedSegStrings(NULL),
-		nOverlaps(0)
+		nOverlaps(0),
+		partitionRunner(NULL),
+		maxPartitionSize(0),
+		partitionSize(0)
 	{}
 
 	~MCIndexNoder();
 
+	/**
+	 * Makes computeNodes() run the overlap search in partitions
+	 * through a runner, then merge them.
+	 *
+	 * The noded result is the same as without a runner.
+	 *
+	 * @param runner the runner, externally owned, or NULL to
+	 *        search serially (the default)
+	 * @param maxChains the max number of query chains of a
+	 *        partition
+	 *
+	 * @throws IllegalArgumentException if a runner is given
+	 *         and maxChains is 0
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	void setPartitionRunner(PartitionRunner* runner,
+	                        std::size_t maxChains);
+
+	/**
+	 * Indexes the monotone chains of the segment strings, and
+	 * splits the overlap search into partitions of consecutive
+	 * query chains.
+	 *
+	 * This replaces the first step of computeNodes().
+	 * Call computePartitionOverlaps() for every partition, then
+	 * mergePartitionOverlaps().
+	 *
+	 * @param inputSegStrings the segment strings to node
+	 * @param maxChains the max number of query chains of a
+	 *        partition
+	 *
+	 * @throws IllegalArgumentException if maxChains is 0
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	void partitionOverlaps(std::vector<SegmentString*>* inputSegStrings,
+	                       std::size_t maxChains);
+
+	/// Returns the number of overlap partitions
+	std::size_t getNumPartitions() const
+	{
+		return partitionPairs.size();
+	}
+
+	/**
+	 * Finds the overlapping segments of the query chains of a
+	 * partition, without calling the SegmentIntersector.
+	 *
+	 * Only reads the index and the segment strings, so different
+	 * partitions can be computed from different threads at once.
+	 * The segment strings must not be modified meanwhile.
+	 *
+	 * @param i the partition index
+	 */
+	void computePartitionOverlaps(std::size_t i);
+
+	/**
+	 * Passes the overlapping segments found by every partition
+	 * to the SegmentIntersector, in partition order.
+	 *
+	 * This is the same order as the serial search, so the nodes
+	 * added do not depend on how the partitions were run.
+	 * Must be called from a single thread, once all partitions
+	 * have been computed.
+	 */
+	void mergePartitionOverlaps();
+
 	/// Return a reference to this instance's std::vector of MonotoneChains
 	std::vector<index::chain::MonotoneChain*>& getMonotoneChains() { return monoChains; }
 
@@ -78,6 +78,29 @@ public:
 	// NOTE: re-populates the MonotoneChain vector with newly created chains
 	void process(SegmentString::ConstVect* segStrings);
 
+	/**
+	 * Runs the given SegmentIntersector on the intersections of
+	 * the given SegmentStrings with the base ones.
+	 *
+	 * Unlike process(SegmentString::ConstVect*) this keeps the
+	 * monotone chains of segStrings local to the call and does not
+	 * change the state of this object, provided buildIndex
+	 * has been called: concurrent calls, each with its own
+	 * SegmentIntersector, are then safe.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	void process(SegmentString::ConstVect* segStrings,
+	             SegmentIntersector& segInt) const;
+
+	/**
+	 * Builds the index of the base segments now rather than on
+	 * the first query. No base segments can be added afterwards.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	void buildIndex();
+
     class SegmentOverlapAction : public index::chain::MonotoneChainOverlapAction
     {
     private:
@@ -22,6 +22,7 @@
 #include <geos/export.h>
 
 #include <geos/noding/Noder.h> // for inheritance
+#include <geos/noding/MCIndexNoder.h> // for PartitionRunner
 #include <geos/noding/NodedSegmentString.h> // for inlines
 #include <geos/noding/snapround/MCIndexPointSnapper.h> // for inines
 #include <geos/algorithm/LineIntersector.h> // for composition
@@ -42,7 +43,6 @@ namespace geos {
 	}
 	namespace noding {
 		class SegmentString;
-		class MCIndexNoder;
 	}
 }
 
@@ -79,9 +79,26 @@ public:
     :
 		pm(nPm),
 		scaleFactor(nPm.getScale()),
-		pointSnapper(0)
+		pointSnapper(0),
+		partitionRunner(NULL),
+		maxPartitionSize(0)
   {}
 
+	/**
+	 * Sets the runner of the overlap partitions of the
+	 * MCIndexNoder used to find the interior intersections.
+	 *
+	 * @see MCIndexNoder::setPartitionRunner
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	void setPartitionRunner(MCIndexNoder::PartitionRunner* runner,
+	                        std::size_t maxChains)
+	{
+		partitionRunner = runner;
+		maxPartitionSize = maxChains;
+	}
+
 	std::vector<SegmentString*>* getNodedSubstrings() const {
 	  return NodedSegmentString::getNodedSubstrings(*nodedSegStrings);
   }
@@ -92,6 +109,8 @@ public:
 	 * Computes nodes introduced as a result of
 	 * snapping segments to vertices of other segments
 	 *
+	 * Vertices shared by several edges are snapped once.
+	 *
 	 * @param edges the list of segment strings to snap together
 	 *        NOTE: they *must* be instances of NodedSegmentString, or
 	 * 	            an assertion will fail.
@@ -111,6 +130,10 @@ private:
 
 	std::auto_ptr<MCIndexPointSnapper> pointSnapper;
 
+	MCIndexNoder::PartitionRunner* partitionRunner;
+
+	std::size_t maxPartitionSize;
+
 	void snapRound(MCIndexNoder& noder, std::vector<SegmentString*>* segStrings);
 
 	
@@ -128,14 +151,17 @@ private:
 	/**
 	 * Computes nodes introduced as a result of snapping
 	 * segments to snap points (hot pixels)
+	 *
+	 * Each distinct snap point is snapped only once.
 	 */
 	void computeIntersectionSnaps(std::vector<geom::Coordinate>& snapPts);
 
 	/**
-	 * Performs a brute-force comparison of every segment in each {@link SegmentString}.
-	 * This has n^2 performance.
+	 * Computes nodes introduced as a result of snapping
+	 * segments to the vertex at index i of edge e,
+	 * excluding the segment starting at that vertex.
 	 */
-	void computeVertexSnaps(NodedSegmentString* e);
+	void computeVertexSnaps(NodedSegmentString* e, unsigned int i);
 	
 	void checkCorrectness(std::vector<SegmentString*>& inputSegmentStrings);
 
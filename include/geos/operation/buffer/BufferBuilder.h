@@ -28,6 +28,7 @@
 #include <geos/operation/buffer/BufferOp.h> // for inlines (BufferOp enums)
 #include <geos/operation/buffer/OffsetCurveBuilder.h> // for inline (OffsetCurveBuilder enums)
 #include <geos/geomgraph/EdgeList.h> // for composition
+#include <geos/noding/MCIndexNoder.h> // for PartitionRunner
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -58,6 +59,7 @@ namespace geos {
 	namespace operation {
 		namespace buffer {
 			class BufferSubgraph;
+			class FilletTemplateCache;
 		}
 		namespace overlay {
 			class PolygonBuilder;
@@ -106,7 +108,10 @@ public:
 		intersectionAdder(NULL),
 		workingNoder(NULL),
 		geomFact(NULL),
-		edgeList()
+		edgeList(),
+		templateCache(NULL),
+		noderPartitionRunner(NULL),
+		noderMaxPartitionSize(0)
 	{}
 
 	~BufferBuilder();
@@ -135,6 +140,42 @@ public:
 	 */
 	void setNoder(noding::Noder* newNoder) { workingNoder = newNoder; }
 
+	/**
+	 * Sets the runner of the overlap partitions of the
+	 * noding::MCIndexNoder used when no noder is set.
+	 *
+	 * @see noding::MCIndexNoder::setPartitionRunner
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param runner the runner, not owned by the builder, or NULL
+	 * @param maxChains the max number of query chains of a partition
+	 */
+	void setNoderPartitionRunner(
+			noding::MCIndexNoder::PartitionRunner* runner,
+			std::size_t maxChains)
+	{
+		noderPartitionRunner = runner;
+		noderMaxPartitionSize = maxChains;
+	}
+
+	/**
+	 * Sets the cache of unit circle templates used to build
+	 * round joins, caps and point buffers.
+	 *
+	 * Sharing a cache among many builders saves recomputing
+	 * the same fillet vertices for every buffer run.
+	 * If no cache is set a private one is used for each run.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param cache the cache to use, not owned by the builder
+	 */
+	void setFilletTemplateCache(FilletTemplateCache* cache)
+	{
+		templateCache = cache;
+	}
+
 	geom::Geometry* buffer(const geom::Geometry *g, double distance);
 		// throw (GEOSException);
 
@@ -143,6 +184,35 @@ public:
 	                                double distance, bool leftSide ) ;
 		// throw (GEOSException);
 
+	/**
+	 * Computes the offset curve of a line on one side,
+	 * without building the buffer polygon.
+	 *
+	 * The raw single-sided curve is generated by an
+	 * OffsetCurveBuilder and noded against itself, the raw curve
+	 * of the other side and the flat caps joining them.
+	 * The noded portions lying wholly closer than the offset
+	 * distance to the input line (loops formed at inside turns and
+	 * where the line comes back near itself) are dropped, and the
+	 * ends are trimmed as in bufferLineSingleSided.
+	 * No buffer polygon is built, so this is much cheaper than
+	 * bufferLineSingleSided.
+	 * The remaining portions keep the orientation of the raw
+	 * curve, which is reversed for the right side.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param g the LineString to offset
+	 * @param distance the offset distance, must be positive
+	 * @param leftSide true to compute the curve on the left side
+	 *                 of the line, false for the right side
+	 * @return a LineString or MultiLineString, ownership
+	 *         transferred to caller
+	 */
+	geom::Geometry* offsetCurve( const geom::Geometry* g,
+	                                double distance, bool leftSide ) ;
+		// throw (GEOSException);
+
 private:
 
 	/**
@@ -166,6 +236,12 @@ private:
 
 	std::vector<geomgraph::Label *> newLabels;
 
+	FilletTemplateCache* templateCache;
+
+	noding::MCIndexNoder::PartitionRunner* noderPartitionRunner;
+
+	std::size_t noderMaxPartitionSize;
+
 	void computeNodedEdges(std::vector<noding::SegmentString*>& bufSegStr,
 			const geom::PrecisionModel *precisionModel);
 			// throw(GEOSException);
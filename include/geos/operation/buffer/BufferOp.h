@@ -37,6 +37,11 @@ namespace geos {
 		class PrecisionModel;
 		class Geometry;
 	}
+	namespace operation {
+		namespace buffer {
+			class FilletTemplateCache;
+		}
+	}
 }
 
 namespace geos {
@@ -88,6 +93,15 @@ private:
 	 */
 	static const int MAX_PRECISION_DIGITS = 12;
 
+	/**
+	 *  The max number of significant digits of the coordinates
+	 *  scaled to a reduced precision, above which the snap-rounding
+	 *  grid can not be represented exactly by double-precision values.
+	 *
+	 *  Not in JTS: this is a GEOS extension
+	 */
+	static const int MAX_SCALED_DIGITS = 15;
+
 	/**
 	 * Compute a reasonable scale factor to limit the precision of
 	 * a given combination of Geometry and buffer distance.
@@ -107,6 +121,24 @@ private:
 	static double precisionScaleFactor(const geom::Geometry *g,
 			double distance, int maxPrecisionDigits);
 
+	/**
+	 * Compute the number of precision digits to start the
+	 * reduced precision attempts from.
+	 *
+	 * This is MAX_PRECISION_DIGITS unless the coordinates are large
+	 * with respect to the size of the buffer, in which case
+	 * scaling them by precisionScaleFactor would need more than
+	 * MAX_SCALED_DIGITS digits.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param g the Geometry being buffered
+	 * @param distance the buffer distance
+	 * @return the number of digits, in [0, MAX_PRECISION_DIGITS]
+	 */
+	static int startPrecisionDigits(const geom::Geometry *g,
+			double distance);
+
 	const geom::Geometry *argGeom;
 
 	util::TopologyException saveException;
@@ -117,18 +149,39 @@ private:
 	//int endCapStyle;
 	BufferParameters bufParams;
 
+	FilletTemplateCache* templateCache;
+
 	geom::Geometry* resultGeometry;
 
+	int resultPrecisionDigits;
+
 	void computeGeometry();
 
 	void bufferOriginalPrecision();
 
-	void bufferReducedPrecision(int precisionDigits);
-
 	void bufferReducedPrecision();
 
+	bool tryReducedPrecision(int precisionDigits);
+
 	void bufferFixedPrecision(const geom::PrecisionModel& fixedPM);
 
+protected:
+
+	/**
+	 * Computes the buffer with a precision model of the given
+	 * number of digits, snap-rounding the noded edges.
+	 *
+	 * Success is not monotone in the number of digits, so
+	 * subclasses can override this to simulate failures at
+	 * arbitrary precisions.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param precisionDigits the number of digits of precision
+	 * @throws TopologyException on a robustness failure
+	 */
+	virtual void bufferReducedPrecision(int precisionDigits);
+
 public:
 
 	enum {
@@ -171,7 +224,9 @@ public:
 		:
 		argGeom(g),
 		bufParams(),
-		resultGeometry(NULL)
+		templateCache(NULL),
+		resultGeometry(NULL),
+		resultPrecisionDigits(-1)
 	{
 	}
 
@@ -187,10 +242,14 @@ public:
 		:
 		argGeom(g),
 		bufParams(params),
-		resultGeometry(NULL)
+		templateCache(NULL),
+		resultGeometry(NULL),
+		resultPrecisionDigits(-1)
 	{
 	}
 
+	virtual ~BufferOp() {}
+
 	/**
 	 * Specifies the end cap style of the generated buffer.
 	 * The styles supported are CAP_ROUND, CAP_BUTT, and CAP_SQUARE.
@@ -231,6 +290,20 @@ public:
 	 */
 	inline void setSingleSided(bool isSingleSided);
 
+	/**
+	 * Sets a cache of unit circle templates to be shared by
+	 * the BufferBuilder runs of this operation, and possibly
+	 * by other operations using the same cache.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param cache the cache to use, not owned by this object
+	 */
+	void setFilletTemplateCache(FilletTemplateCache* cache)
+	{
+		templateCache = cache;
+	}
+
 	/**
 	 * Returns the buffer computed for a geometry for a given buffer
 	 * distance.
@@ -241,6 +314,21 @@ public:
 	 */
 	geom::Geometry* getResultGeometry(double nDistance);
 
+	/**
+	 * Returns the number of precision digits the last result
+	 * was computed with, after a robustness failure at the
+	 * original precision.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @return the number of precision digits, or -1 if the result
+	 *         was computed with the precision of the input geometry
+	 */
+	int getResultPrecisionDigits() const
+	{
+		return resultPrecisionDigits;
+	}
+
 };
 
 // BufferOp inlines
@@ -0,0 +1,100 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_BUFFER_FILLETTEMPLATECACHE_H
+#define GEOS_OP_BUFFER_FILLETTEMPLATECACHE_H
+
+#include <geos/export.h>
+
+#include <geos/geom/Coordinate.h> // for composition
+
+#include <map>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+namespace operation { // geos.operation
+namespace buffer { // geos.operation.buffer
+
+/** \brief
+ * Caches unit-circle vertex templates used to build round
+ * joins, caps and point buffers.
+ *
+ * The vertices of a fillet only depend on the number of
+ * quadrant segments, so they can be computed once and then
+ * rotated, scaled and translated into place by
+ * OffsetSegmentGenerator instead of calling sin/cos for
+ * every generated vertex.
+ *
+ * A cache can be shared by any number of BufferBuilder runs,
+ * but it is not synchronized: use one cache per thread.
+ *
+ * Not in JTS: this is a GEOS extension
+ */
+class GEOS_DLL FilletTemplateCache {
+
+public:
+
+	FilletTemplateCache() {}
+
+	/** \brief
+	 * Gets the vertices of the unit circle approximated
+	 * with the given number of quadrant segments.
+	 *
+	 * Vertices run clockwise starting at angle 0, so vertex k
+	 * lies at angle -k * PI/2/quadrantSegments, for k in
+	 * [0, 4*quadrantSegments).
+	 * Due to accumulated rounding the vector may hold one more
+	 * vertex, nearly coincident with the first one: this
+	 * matches what OffsetSegmentGenerator computes for a circle.
+	 *
+	 * The returned reference stays valid until clear() is called
+	 * or the cache is destroyed.
+	 *
+	 * @param quadrantSegments the number of segments used to
+	 *                         approximate a quarter circle (>= 1)
+	 */
+	const std::vector<geom::Coordinate>& getUnitCircle(int quadrantSegments);
+
+	/// Drops all cached templates
+	void clear() { templates.clear(); }
+
+	/// Returns the number of cached templates
+	size_t size() const { return templates.size(); }
+
+private:
+
+	typedef std::map<int, std::vector<geom::Coordinate> > TemplateMap;
+
+	TemplateMap templates;
+
+	static void computeUnitCircle(int quadrantSegments,
+	                              std::vector<geom::Coordinate>& pts);
+
+	// Declare type as noncopyable
+	FilletTemplateCache(const FilletTemplateCache& other);
+	FilletTemplateCache& operator=(const FilletTemplateCache& rhs);
+};
+
+} // namespace geos::operation::buffer
+} // namespace geos::operation
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_OP_BUFFER_FILLETTEMPLATECACHE_H
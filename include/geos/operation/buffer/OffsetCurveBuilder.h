@@ -68,13 +68,18 @@ public:
 	 *                   so caller must make sure the object is
 	 *                   kept alive for the whole lifetime of
 	 *                   the buffer builder.
+	 * @param nTemplateCache unit circle templates for round joins
+	 *                   and caps (not owned, may be NULL).
+	 *                   This is a GEOS extension.
 	 */
 	OffsetCurveBuilder(const geom::PrecisionModel *newPrecisionModel,
-			const BufferParameters& nBufParams)
+			const BufferParameters& nBufParams,
+			FilletTemplateCache* nTemplateCache=NULL)
 		:
 		distance(0.0),
 		precisionModel(newPrecisionModel),
-		bufParams(nBufParams)
+		bufParams(nBufParams),
+		templateCache(nTemplateCache)
   {}
 
   /**
@@ -120,6 +125,20 @@ public:
 	     double distance, std::vector<geom::CoordinateSequence*>& lineList,
 	     bool leftSide, bool rightSide ) ;
 
+	/**
+	 * Gets the simplified version of the input line from which
+	 * getSingleSidedLineCurve generates the curve for the given side.
+	 *
+	 * Points of the raw curve lie at the offset distance from
+	 * this line, which makes it the reference to tell valid
+	 * portions of the curve from loops.
+	 *
+	 * NOTE: this is a GEOS extension
+	 */
+	std::auto_ptr<geom::CoordinateSequence> getSingleSidedSimplifiedLine(
+	     const geom::CoordinateSequence* inputPts,
+	     double distance, bool leftSide);
+
 	/**
 	 * This method handles the degenerate cases of single points and lines,
 	 * as well as rings.
@@ -140,6 +159,8 @@ private:
 
 	const BufferParameters& bufParams; 
 
+	FilletTemplateCache* templateCache;
+
 	/**
 	 * Use a value which results in a potential distance error which is
 	 * significantly less than the error due to
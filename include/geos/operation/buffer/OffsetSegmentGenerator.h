@@ -40,6 +40,11 @@ namespace geos {
     class CoordinateSequence;
     class PrecisionModel;
   }
+  namespace operation {
+    namespace buffer {
+      class FilletTemplateCache;
+    }
+  }
 }
 
 namespace geos {
@@ -68,9 +73,14 @@ public:
    *                   so caller must make sure the object is
    *                   kept alive for the whole lifetime of
    *                   the buffer builder.
+   * @param templateCache cache of unit circle templates to build
+   *                   round joins and caps from, or NULL to compute
+   *                   fillet vertices directly. The cache is
+   *                   not owned and must outlive this object.
    */
   OffsetSegmentGenerator(const geom::PrecisionModel *newPrecisionModel,
-      const BufferParameters& bufParams, double distance);
+      const BufferParameters& bufParams, double distance,
+      FilletTemplateCache* templateCache=NULL);
 
   /**
    * Tests whether the input has a narrow concave angle
@@ -175,6 +185,18 @@ private:
    */
   double filletAngleQuantum;
 
+  /// \brief
+  /// Unit circle vertices for the current quadrant segments,
+  /// from a FilletTemplateCache (not owned, may be NULL)
+  ///
+  /// Not in JTS: this is a GEOS extension
+  ///
+  const std::vector<geom::Coordinate>* unitCircle;
+
+  /// Max difference from filletAngleQuantum for an angle increment
+  /// to be taken from the unitCircle template
+  static const double TEMPLATE_ANGLE_TOLERANCE; // 1.0E-12
+
   /// The Closing Segment Factor controls how long "closing
   /// segments" are.  Closing segments are added at the middle of
   /// inside corners to ensure a smoother boundary for the buffer
@@ -331,6 +353,11 @@ private:
    * The start and end point for the fillet are not added -
    * the caller must add them if required.
    *
+   * Vertices are obtained by rotating the radius vector rather
+   * than evaluating sin/cos for each of them. Arcs made of
+   * whole quadrant segments (caps, reversals) are rotated
+   * copies of the cached unit circle template, if any.
+   *
    * @param direction is -1 for a CW angle, 1 for a CCW angle
    * @param radius the radius of the fillet
    */
@@ -0,0 +1,156 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_BUFFER_PARTITIONEDBUFFEROP_H
+#define GEOS_OP_BUFFER_PARTITIONEDBUFFEROP_H
+
+#include <geos/export.h>
+
+#include <geos/operation/buffer/BufferParameters.h> // for composition
+
+#include <cstddef> // for size_t
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+	}
+	namespace operation {
+		namespace buffer {
+			class FilletTemplateCache;
+		}
+	}
+}
+
+namespace geos {
+namespace operation { // geos.operation
+namespace buffer { // geos.operation.buffer
+
+/** \brief
+ * Splits the buffer of a large collection into independent jobs,
+ * which callers can run concurrently.
+ *
+ * The components of the input are sorted into spatially clustered
+ * groups using Sort-Tile-Recursive order.
+ * Each group can then be buffered on its own with bufferGroup(),
+ * and the group buffers merged with unionGroupBuffers().
+ * For a positive distance the buffer of a union is the union of the
+ * buffers, so the result matches the one of BufferOp topologically.
+ *
+ * bufferGroup() only reads this object and its own group, so it can
+ * be called from several threads at once for different groups,
+ * each thread using its own FilletTemplateCache (or none).
+ * Running the groups one after another is slower than a single
+ * BufferOp, because of the final union.
+ *
+ * Groups are buffered at the precision of the input, without the
+ * reduced precision fallback of BufferOp: when a group throws a
+ * TopologyException, buffer the whole input with BufferOp instead,
+ * so that a single reduced precision is used for all of it.
+ *
+ * The input geometry must not be modified nor destroyed while this
+ * object is in use.
+ *
+ * Not in JTS: this is a GEOS extension
+ */
+class GEOS_DLL PartitionedBufferOp {
+
+public:
+
+	/**
+	 * Sorts the components of a geometry into groups.
+	 *
+	 * @param g the geometry to buffer; unless it is a collection
+	 *          it makes a single group
+	 * @param maxGroupSize the max number of components of a group
+	 * @param params the buffer parameters to use; they must not
+	 *               be single-sided
+	 *
+	 * @throws IllegalArgumentException if maxGroupSize is 0 or
+	 *         the parameters are single-sided
+	 */
+	PartitionedBufferOp(const geom::Geometry* g, std::size_t maxGroupSize,
+	                    const BufferParameters& params = BufferParameters());
+
+	~PartitionedBufferOp();
+
+	/// Returns the number of groups
+	std::size_t getNumGroups() const
+	{
+		return groups.size();
+	}
+
+	/// Returns the collection of the components of a group
+	const geom::Geometry* getGroup(std::size_t i) const
+	{
+		return groups[i];
+	}
+
+	/**
+	 * Computes the buffer of a group, at the precision of the input.
+	 *
+	 * @param i the group index
+	 * @param distance the buffer distance, which must be positive
+	 * @param cache a cache of fillet templates, or NULL;
+	 *              not shared with other threads
+	 * @return the buffer of the group, owned by the caller
+	 *
+	 * @throws IllegalArgumentException if distance is not positive
+	 * @throws TopologyException on a robustness failure
+	 */
+	geom::Geometry* bufferGroup(std::size_t i, double distance,
+	                            FilletTemplateCache* cache = NULL) const;
+
+	/**
+	 * Merges the buffers of the groups.
+	 *
+	 * @param groupBuffers the group buffers, whose ownership is
+	 *        transferred: they are deleted and the vector emptied,
+	 *        even when an exception is thrown
+	 * @return the union of the buffers, owned by the caller
+	 *
+	 * @throws TopologyException on a robustness failure
+	 */
+	geom::Geometry* unionGroupBuffers(
+			std::vector<geom::Geometry*>& groupBuffers) const;
+
+private:
+
+	const geom::Geometry* argGeom;
+
+	BufferParameters bufParams;
+
+	/// Owned collections of cloned components
+	std::vector<geom::Geometry*> groups;
+
+	void buildGroups(std::size_t maxGroupSize);
+
+	// Declare type as noncopyable
+	PartitionedBufferOp(const PartitionedBufferOp& other);
+	PartitionedBufferOp& operator=(const PartitionedBufferOp& rhs);
+};
+
+} // namespace geos::operation::buffer
+} // namespace geos::operation
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_OP_BUFFER_PARTITIONEDBUFFEROP_H
@@ -21,9 +21,16 @@
 
 #include <geos/export.h>
 
+#include <cstddef> // for size_t
 #include <vector>
 
-#include <geos/geom/LineSegment.h> // for composition
+#include <geos/geom/Envelope.h> // for composition
+#include <geos/index/strtree/STRtree.h> // for composition
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
 
 // Forward declarations
 namespace geos {
@@ -60,25 +67,57 @@ class GEOS_DLL SubgraphDepthLocater {
 
 public:
 
-	SubgraphDepthLocater(std::vector<BufferSubgraph*> *newSubgraphs)
-		:
-		subgraphs(newSubgraphs)
-	{}
+	/**
+	 * @param newSubgraphs the subgraphs to locate against.
+	 *        Their envelopes are indexed by the first getDepth
+	 *        call, so the vector must not change afterwards.
+	 */
+	SubgraphDepthLocater(const std::vector<BufferSubgraph*> *newSubgraphs);
+
+	~SubgraphDepthLocater();
 
-	~SubgraphDepthLocater() {}
+	/**
+	 * Only locates against the first n subgraphs (all of them
+	 * by default).
+	 *
+	 * This lets a single locater, indexed once, locate each
+	 * subgraph against the ones processed before it.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 */
+	void setNumProcessed(std::size_t n) { numProcessed = n; }
 
 	int getDepth(const geom::Coordinate &p);
 
 private:
 
-	std::vector<BufferSubgraph*> *subgraphs;
+	/// Interval index of the segments of a subgraph, keyed on y
+	class SegmentIndex;
 
-	geom::LineSegment seg;
+	const std::vector<BufferSubgraph*> *subgraphs;
+
+	std::size_t numProcessed;
+
+	/// Envelopes of the subgraphs, in the same order
+	std::vector<geom::Envelope> subgraphEnvs;
+
+	/// Index of subgraphEnvs, built on the first getDepth call
+	index::strtree::STRtree envTree;
+
+	/// Segment indexes of the subgraphs, in the same order,
+	/// built the first time the stabbing line hits a subgraph
+	/// envelope (owned)
+	std::vector<SegmentIndex*> segIndexes;
 
 	/**
 	 * Finds all non-horizontal segments intersecting the stabbing line.
 	 * The stabbing line is the ray to the right of stabbingRayLeftPt.
 	 *
+	 * The processed subgraphs whose envelope contains
+	 * stabbingRayLeftPt are looked up in the envelope tree, and their
+	 * segments in their y-keyed segment index. Segments are reported
+	 * in subgraph, DirectedEdge and segment order.
+	 *
 	 * @param stabbingRayLeftPt the left-hand origin of the stabbing line
 	 * @param stabbedSegments a vector to which DepthSegments intersecting
 	 *        the stabbing line will be added.
@@ -86,32 +125,9 @@ private:
 	void findStabbedSegments(const geom::Coordinate &stabbingRayLeftPt,
 			std::vector<DepthSegment*>& stabbedSegments);
 
-	/**
-	 * Finds all non-horizontal segments intersecting the stabbing line
-	 * in the list of dirEdges.
-	 * The stabbing line is the ray to the right of stabbingRayLeftPt.
-	 *
-	 * @param stabbingRayLeftPt the left-hand origin of the stabbing line
-	 * @param stabbedSegments the current vector of DepthSegments
-	 *        intersecting the stabbing line will be added.
-	 */
-	void findStabbedSegments(const geom::Coordinate &stabbingRayLeftPt,
-			std::vector<geomgraph::DirectedEdge*> *dirEdges,
-			std::vector<DepthSegment*>& stabbedSegments);
-
-	/**
-	 * Finds all non-horizontal segments intersecting the stabbing line
-	 * in the input dirEdge.
-	 * The stabbing line is the ray to the right of stabbingRayLeftPt.
-	 *
-	 * @param stabbingRayLeftPt the left-hand origin of the stabbing line
-	 * @param stabbedSegments the current list of DepthSegments intersecting
-	 *        the stabbing line
-	 */
-	void findStabbedSegments(const geom::Coordinate &stabbingRayLeftPt,
-			geomgraph::DirectedEdge *dirEdge,
-			std::vector<DepthSegment*>& stabbedSegments);
-
+	// Declare type as noncopyable
+	SubgraphDepthLocater(const SubgraphDepthLocater& other);
+	SubgraphDepthLocater& operator=(const SubgraphDepthLocater& rhs);
 };
 
 
@@ -119,6 +135,10 @@ private:
 } // namespace geos::operation
 } // namespace geos
 
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 #endif // ndef GEOS_OP_BUFFER_SUBGRAPHDEPTHLOCATER_H
 
 /**********************************************************************
@@ -26,6 +26,7 @@
 #include <geos/algorithm/PointLocator.h> // for composition
 #include <geos/geomgraph/PlanarGraph.h> // for inline (GeometryGraph->PlanarGraph)
 
+#include <cstddef>
 #include <vector>
 
 #ifdef _MSC_VER
@@ -48,6 +49,16 @@ namespace geos {
 		class Edge;
 		class Node;
 	}
+	namespace algorithm {
+		namespace locate {
+			class IndexedPointInAreaLocator;
+		}
+	}
+	namespace index {
+		namespace strtree {
+			class STRtree;
+		}
+	}
 	namespace operation {
 		namespace overlay {
 			class ElevationMatrix;
@@ -159,6 +170,20 @@ private:
 
 	std::vector<geom::Point*> *resultPointList;
 
+	/// Minimum number of points for a result polygon to be
+	/// given an IndexedPointInAreaLocator by isCoveredByResultPolygons
+	static const std::size_t MIN_INDEXED_POLYGON_POINTS = 64;
+
+	/// Index of the resultPolyList envelopes, built on first use
+	index::strtree::STRtree *resultPolyIndex;
+
+	/// Point in area locators of the resultPolyList elements,
+	/// built on first use, owned (NULL for small polygons)
+	std::vector<algorithm::locate::IndexedPointInAreaLocator*> resultPolyLocators;
+
+	/// Index of the resultLineList envelopes, built on first use
+	index::strtree::STRtree *resultLineIndex;
+
 	void computeOverlay(OpCode opCode); // throw(TopologyException *);
 
 	void insertUniqueEdges(std::vector<geomgraph::Edge*> *edges);
@@ -288,6 +313,23 @@ private:
 	bool isCovered(const geom::Coordinate& coord,
 			std::vector<geom::LineString*> *geomList);
 
+	/**
+	 * Same as isCovered(coord, resultPolyList), only
+	 * locating the coord in the polygons whose envelope covers it,
+	 * using an IndexedPointInAreaLocator for the larger ones.
+	 *
+	 * Not in JTS
+	 */
+	bool isCoveredByResultPolygons(const geom::Coordinate& coord);
+
+	/**
+	 * Same as isCovered(coord, resultLineList), only
+	 * locating the coord on the lines whose envelope covers it.
+	 *
+	 * Not in JTS
+	 */
+	bool isCoveredByResultLines(const geom::Coordinate& coord);
+
 	/**
 	 * Build a Geometry containing all Geometries in the given vectors.
 	 * Takes element's ownership, vector control is left to caller. 
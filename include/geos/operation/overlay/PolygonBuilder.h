@@ -92,6 +92,10 @@ public:
 
 private:
 
+	/// Spatial index of the shells, used by placeFreeHoles
+	class ShellIndex;
+
+
 	const geom::GeometryFactory *geometryFactory;
 
 	std::vector<geomgraph::EdgeRing*> shellList;
@@ -164,6 +168,8 @@ private:
 	 * parent shell) would have formed part of a MaximalEdgeRing
 	 * and been handled in a previous step.
 	 *
+	 * Shells are looked up through a ShellIndex.
+	 *
 	 * @throws TopologyException if a hole cannot be assigned to a shell
 	 */
 	void placeFreeHoles(std::vector<geomgraph::EdgeRing*>& newShellList,
@@ -185,11 +191,14 @@ private:
 	 * (which is guaranteed to be the case if the hole does not touch
 	 * its shell)
 	 *
+	 * Only the shells whose envelope contains the one of testEr
+	 * are tested, in shell list order.
+	 *
 	 * @return containing geomgraph::EdgeRing, if there is one
 	 * @return NULL if no containing geomgraph::EdgeRing is found
 	 */
 	geomgraph::EdgeRing* findEdgeRingContaining(geomgraph::EdgeRing *testEr,
-		std::vector<geomgraph::EdgeRing*>& newShellList);
+		ShellIndex& shellIndex);
 
 	std::vector<geom::Geometry*>* computePolygons(
 			std::vector<geomgraph::EdgeRing*>& newShellList);
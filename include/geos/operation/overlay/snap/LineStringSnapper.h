@@ -24,7 +24,9 @@
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/CoordinateList.h>
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 // Forward declarations
 namespace geos {
@@ -34,6 +36,13 @@ namespace geos {
 		class CoordinateList;
 		class Geometry;
 	}
+	namespace operation {
+		namespace overlay {
+			namespace snap {
+				class SnapPointIndex;
+			}
+		}
+	}
 }
 
 namespace geos {
@@ -47,6 +56,11 @@ namespace snap { // geos::operation::overlay::snap
  *
  * A snapping distance tolerance is used to control where snapping is performed.
  *
+ * Snap points and source segments are looked up through spatial
+ * indexes, but the result is the same as comparing every source
+ * vertex with every snap point and every snap point with every
+ * source segment, in order.
+ *
  */
 class GEOS_DLL LineStringSnapper {
 
@@ -73,6 +87,17 @@ public:
 	// Snap points are assumed to be all distinct points (a set would be better, uh ?)
 	std::auto_ptr<geom::Coordinate::Vect> snapTo(const geom::Coordinate::ConstVect& snapPts);
 
+	/**
+	 * Snaps to the points of the given index.
+	 *
+	 * Use this to snap many lines to the same points,
+	 * sharing the index.
+	 *
+	 * @param snapIndex index of the snap points, which are assumed
+	 *                  to be all distinct
+	 */
+	std::auto_ptr<geom::Coordinate::Vect> snapTo(SnapPointIndex& snapIndex);
+
 	void setAllowSnappingToSourceVertices(bool allow) {
 		allowSnappingToSourceVertices = allow;
 	}
@@ -89,12 +114,14 @@ private:
 
 	// Modifies first arg
 	void snapVertices(geom::CoordinateList& srcCoords,
-			const geom::Coordinate::ConstVect& snapPts);
+			SnapPointIndex& snapIndex);
 
 
-	// Returns snapPts.end() if no snap point is close enough (within snapTol distance)
-	geom::Coordinate::ConstVect::const_iterator findSnapForVertex(const geom::Coordinate& pt,
-			const geom::Coordinate::ConstVect& snapPts);
+	// Returns the first snap point (in snap points order) within
+	// snapTol distance, or NULL if none is close enough or the
+	// first one is equal to pt
+	const geom::Coordinate* findSnapForVertex(const geom::Coordinate& pt,
+			SnapPointIndex& snapIndex);
 
   /** \brief
    * Snap segments of the source to nearby snap vertices.
@@ -110,9 +137,10 @@ private:
    *
    * @param srcCoords the coordinates of the source linestring to be snapped
    *                  the object will be modified (coords snapped)
-   * @param snapPts the target snap vertices                                       */
+   * @param snapIndex index of the target snap vertices
+   */
   void snapSegments(geom::CoordinateList& srcCoords,
-                    const geom::Coordinate::ConstVect& snapPts);
+                    SnapPointIndex& snapIndex);
 
 	/// \brief
 	/// Finds a src segment which snaps to (is close to) the given snap
@@ -130,21 +158,31 @@ private:
 	/// coordinate list, no snapping is performed (may be changed
 	/// using setAllowSnappingToSourceVertices).
 	///
-	/// @param from
-	///        an iterator to first point of first segment to be checked
+	/// @param vertices
+	///        iterators to the source vertices, segment i goes
+	///        (possibly through previously snapped points) from
+	///        vertices[i] to vertices[i+1]
+	///
+	/// @param chains
+	///        ascending indexes of the segments to be checked
+	///
+	/// @param match
+	///        set to an iterator to the first point of the
+	///        sub-segment to be snapped, if any
 	///
-	/// @param too_far
-	///        an iterator to last point of last segment to be checked
+	/// @param matchChain
+	///        set to the index of the segment to be snapped, if any
 	///
-	/// @returns an iterator to the snapped segment or
-	///          too_far if no segment needs snapping
+	/// @returns false if no segment needs snapping
 	///          (either none within snapTol distance,
 	///           or one found on the snapPt)
 	///
-	geom::CoordinateList::iterator findSegmentToSnap(
+	bool findSegmentToSnap(
 			const geom::Coordinate& snapPt,
-			geom::CoordinateList::iterator from,
-			geom::CoordinateList::iterator too_far);
+			const std::vector<geom::CoordinateList::iterator>& vertices,
+			const std::vector<std::size_t>& chains,
+			geom::CoordinateList::iterator& match,
+			std::size_t& matchChain);
 
     // Declare type as noncopyable
     LineStringSnapper(const LineStringSnapper& other);
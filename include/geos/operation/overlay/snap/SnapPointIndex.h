@@ -0,0 +1,95 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_OVERLAY_SNAP_SNAPPOINTINDEX_H
+#define GEOS_OP_OVERLAY_SNAP_SNAPPOINTINDEX_H
+
+#include <geos/export.h>
+
+#include <geos/geom/Coordinate.h> // for ConstVect
+#include <geos/geom/Envelope.h> // for composition
+#include <geos/index/strtree/STRtree.h> // for composition
+
+#include <cstddef>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+namespace operation { // geos::operation
+namespace overlay { // geos::operation::overlay
+namespace snap { // geos::operation::overlay::snap
+
+/** \brief
+ * A spatial index over the target vertices of a snapping operation.
+ *
+ * Snapping is order dependent: queries report the positions of
+ * the matching points in the snap point vector, in ascending order,
+ * so that indexed lookups pick the same point a linear scan would.
+ *
+ * An index can be shared by the LineStringSnapper of every
+ * component of a geometry.
+ *
+ * Not in JTS: this is a GEOS extension
+ */
+class GEOS_DLL SnapPointIndex {
+
+public:
+
+	/**
+	 * @param nSnapPts the snap points, must outlive this object
+	 *                 and not change while it is in use
+	 */
+	SnapPointIndex(const geom::Coordinate::ConstVect& nSnapPts);
+
+	/// Returns the indexed snap points
+	const geom::Coordinate::ConstVect& getSnapPoints() const {
+		return snapPts;
+	}
+
+	/**
+	 * Finds the snap points lying within the given envelope.
+	 *
+	 * @param searchEnv the envelope to search
+	 * @param result the ascending positions, in the snap points
+	 *               vector, of the points found are appended here
+	 */
+	void query(const geom::Envelope& searchEnv,
+	           std::vector<std::size_t>& result);
+
+private:
+
+	const geom::Coordinate::ConstVect& snapPts;
+
+	/// One (point) envelope per snap point, items of the tree
+	std::vector<geom::Envelope> envs;
+
+	index::strtree::STRtree tree;
+
+	// Declare type as noncopyable
+	SnapPointIndex(const SnapPointIndex& other);
+	SnapPointIndex& operator=(const SnapPointIndex& rhs);
+};
+
+} // namespace geos::operation::overlay::snap
+} // namespace geos::operation::overlay
+} // namespace geos::operation
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_OP_OVERLAY_SNAP_SNAPPOINTINDEX_H
@@ -0,0 +1,117 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_UNION_COVERAGEUNION_H
+#define GEOS_OP_UNION_COVERAGEUNION_H
+
+#include <memory>
+#include <vector>
+
+#include <geos/export.h>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+    namespace geom {
+        class GeometryFactory;
+        class Geometry;
+        class Polygon;
+    }
+}
+
+namespace geos {
+namespace operation { // geos::operation
+namespace geounion {  // geos::operation::geounion
+
+/**
+ * \brief
+ * Unions the polygons of a polygonal coverage.
+ *
+ * A polygonal coverage is a set of polygons which do not overlap
+ * and whose shared boundaries have exactly the same vertices,
+ * such as parcels or administrative units.
+ *
+ * Edges shared by two polygons of a coverage cancel out in their
+ * union, so rather than overlaying the polygons the segments of
+ * their rings are matched on exact coordinates, the ones occurring
+ * twice are dropped and the remaining linework is polygonized with
+ * {@link polygonize::Polygonizer}.
+ * No noding is performed, which makes this much faster than
+ * {@link UnaryUnionOp} on coverages.
+ *
+ * The result is only correct for valid coverages.
+ * A segment occurring more than twice, or twice with the same
+ * orientation (which happens with overlapping polygons), raises a
+ * TopologyException, but other violations of the coverage
+ * conditions are not detected.
+ *
+ * Not in JTS: this is a GEOS extension
+ */
+class GEOS_DLL CoverageUnion
+{
+public:
+
+  /**
+   * \brief
+   * Computes the union of the polygons of a coverage.
+   *
+   * @param geom a Polygon, a MultiPolygon or a GeometryCollection
+   *             of them, forming a valid polygonal coverage
+   * @return a Polygon, a MultiPolygon or, if the input is empty,
+   *         an empty GEOMETRYCOLLECTION
+   * @throws IllegalArgumentException if the input has non-empty
+   *         components which are not polygons
+   * @throws TopologyException if the input is found not to be a
+   *         valid coverage
+   */
+  static std::auto_ptr<geom::Geometry> Union(const geom::Geometry& geom)
+  {
+    CoverageUnion op(geom);
+    return op.Union();
+  }
+
+  CoverageUnion(const geom::Geometry& geom);
+
+  /**
+   * \brief
+   * Gets the union of the input polygons.
+   *
+   * @see Union(const geom::Geometry&)
+   */
+  std::auto_ptr<geom::Geometry> Union();
+
+private:
+
+  void extract(const geom::Geometry& geom);
+
+  std::vector<const geom::Polygon*> polygons;
+
+  const geom::GeometryFactory* geomFact;
+
+  // Declare type as noncopyable
+  CoverageUnion(const CoverageUnion& other);
+  CoverageUnion& operator=(const CoverageUnion& rhs);
+};
+
+} // namespace geos::operation::union
+} // namespace geos::operation
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
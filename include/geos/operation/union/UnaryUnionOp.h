@@ -30,9 +30,9 @@
 #include <geos/geom/util/GeometryExtracter.h>
 #include <geos/operation/overlay/snap/SnapIfNeededOverlayOp.h>
 
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
 #endif
 
 // Forward declarations
@@ -108,7 +108,8 @@ public:
   template <class T>
   UnaryUnionOp(const T& geoms, geom::GeometryFactory& geomFactIn)
       :
-      geomFact(&geomFactIn)
+      geomFact(&geomFactIn),
+      mergeLines(false)
   {
     extractGeoms(geoms);
   }
@@ -116,14 +117,16 @@ public:
   template <class T>
   UnaryUnionOp(const T& geoms)
       :
-      geomFact(0)
+      geomFact(0),
+      mergeLines(false)
   {
     extractGeoms(geoms);
   }
 
   UnaryUnionOp(const geom::Geometry& geom)
       :
-      geomFact(geom.getFactory())
+      geomFact(geom.getFactory()),
+      mergeLines(false)
   {
     extract(geom);
   }
@@ -140,6 +143,22 @@ public:
    */
   std::auto_ptr<geom::Geometry> Union();
 
+  /**
+   * \brief
+   * Sets whether the linear part of the union is merged into
+   * maximal linestrings.
+   *
+   * By default the lines of the union are split at every node,
+   * as they would be by an overlay operation.
+   * When set, lines meeting at nodes of degree 2 are joined
+   * using {@link linemerge::LineMerger}.
+   *
+   * Not in JTS
+   *
+   * @param merge true to merge the lines of the union
+   */
+  void setMergeLines(bool merge) { mergeLines = merge; }
+
 private:
 
   template <typename T>
@@ -202,12 +221,32 @@ private:
   std::auto_ptr<geom::Geometry> unionWithNull(std::auto_ptr<geom::Geometry> g0,
                                               std::auto_ptr<geom::Geometry> g1);
 
+  /**
+   * Computes the union of the input points by sorting them and
+   * merging the coincident ones, giving the same result as overlay.
+   *
+   * @return the union of the points, or null if they are all empty
+   */
+  std::auto_ptr<geom::Geometry> unionPointsBySorting();
+
+  /**
+   * Computes the union of the input lines by noding them all
+   * at once and dropping the duplicated noded substrings.
+   *
+   * @return the union of the lines, or null if the noding
+   *         could not be computed robustly, in which case
+   *         overlay must be used instead
+   */
+  std::auto_ptr<geom::Geometry> unionLinesByNoding();
+
   std::vector<const geom::Polygon*> polygons;
   std::vector<const geom::LineString*> lines;
   std::vector<const geom::Point*> points;
 
   const geom::GeometryFactory* geomFact;
 
+  bool mergeLines;
+
   std::auto_ptr<geom::Geometry> empty;
 };
  
@@ -216,8 +255,8 @@ private:
 } // namespace geos::operation
 } // namespace geos
 
-#ifdef _MSC_VER
-#pragma warning(pop)
+#ifdef _MSC_VER
+#pragma warning(pop)
 #endif
 
 #endif
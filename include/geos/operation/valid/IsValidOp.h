@@ -42,6 +42,9 @@ namespace geos {
 		class MultiPolygon;
 		class MultiLineString;
 	}
+	namespace algorithm {
+		class PointInRing;
+	}
 	namespace geomgraph {
 		class DirectedEdge;
 		class EdgeIntersectionList;
@@ -111,6 +114,9 @@ private:
 	 * provide the point is chosen such that it does not lie on the
 	 * boundary of the shell.
 	 *
+	 * Hole points outside the shell envelope are rejected without
+	 * building the shell index.
+	 *
 	 * @param p the polygon to be tested for hole inclusion
 	 * @param graph a geomgraph::GeometryGraph incorporating the polygon
 	 */
@@ -145,6 +151,9 @@ private:
 	 * This routine relies on the fact that while polygon shells
 	 * may touch at one or more vertices, they cannot touch at
 	 * ALL vertices.
+	 *
+	 * Only the pairs of shells with intersecting envelopes,
+	 * found using an STRtree, are tested.
 	 */
 	void checkShellsNotNested(const geom::MultiPolygon *mp,
 			geomgraph::GeometryGraph *graph);
@@ -159,9 +168,12 @@ private:
 	 * properly contained.
 	 * E.g. they cannot partially overlap (this has been previously
 	 * checked by <code>checkRelateConsistency</code>
+	 *
+	 * @param polyShellLocator locates points in the shell of p
 	 */
 	void checkShellNotNested(const geom::LinearRing *shell,
 			const geom::Polygon *p,
+			algorithm::PointInRing& polyShellLocator,
 			geomgraph::GeometryGraph *graph);
 
 	/**
@@ -87,6 +87,14 @@ private:
 
 	void simplifySection(std::size_t i, std::size_t j);
 
+	/*
+	 * Returns the index of the point between i and j furthest
+	 * from segment i-j, and sets maxDistance to its distance
+	 * (-1 if there are no such points)
+	 */
+	std::size_t findFurthestPoint(std::size_t i, std::size_t j,
+	                              double& maxDistance) const;
+
     // Declare type as noncopyable
     DouglasPeuckerLineSimplifier(const DouglasPeuckerLineSimplifier& other);
     DouglasPeuckerLineSimplifier& operator=(const DouglasPeuckerLineSimplifier& rhs);
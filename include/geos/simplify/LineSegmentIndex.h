@@ -41,16 +41,23 @@ namespace geos {
 	namespace simplify {
 		class TaggedLineString;
 	}
-	namespace index {
-		namespace quadtree {
-			class Quadtree;
-		}
-	}
 }
 
 namespace geos {
 namespace simplify { // geos::simplify
 
+/** \brief
+ * An index of the segments of the lines being simplified,
+ * supporting removal and envelope queries.
+ *
+ * Segments are kept by value in STR-packed trees stored in flat
+ * arrays, rather than in a Quadtree.
+ * Segments added since the last query are kept in a small buffer,
+ * which is packed into a new tree when it grows, merging the
+ * smaller trees into it so that there are O(log n) trees.
+ * Removed segments are only flagged, and dropped when their tree
+ * is rebuilt.
+ */
 class GEOS_DLL LineSegmentIndex {
 
 public:
@@ -68,12 +75,38 @@ public:
 	std::auto_ptr< std::vector<geom::LineSegment*> >
 			query(const geom::LineSegment* seg) const;
 
+	/** \brief
+	 * Appends to result the segments whose envelope intersects
+	 * the envelope of seg.
+	 */
+	void query(const geom::LineSegment* seg,
+	           std::vector<geom::LineSegment*>& result) const;
+
 private:
 
-	std::auto_ptr<index::quadtree::Quadtree> index;
+	/// A segment and its envelope
+	struct Item {
+		double minx;
+		double miny;
+		double maxx;
+		double maxy;
+		const geom::LineSegment* seg;
+	};
+
+	static Item makeItem(const geom::LineSegment* seg);
+
+	class PackedTree;
+
+	// The index is reorganized lazily, on queries
+
+	/// Segments added since the last reorganization
+	mutable std::vector<Item> pending;
+
+	/// Packed trees, in decreasing size order
+	mutable std::vector<PackedTree*> trees;
+
+	void flush() const;
 
-	std::vector<geom::Envelope*> newEnvelopes;
-	
 	// Copying is turned off
 	LineSegmentIndex(const LineSegmentIndex&);
 	LineSegmentIndex& operator=(const LineSegmentIndex&);
@@ -27,6 +27,7 @@
 #define GEOS_SIMPLIFY_TAGGEDLINESSIMPLIFIER_H
 
 #include <geos/export.h>
+#include <cstddef> // for size_t
 #include <vector>
 #include <memory>
 #include <cassert>
@@ -52,6 +53,11 @@ namespace simplify { // geos::simplify
 /** \brief
  * Simplifies a collection of TaggedLineStrings, preserving topology
  * (in the sense that no new intersections are introduced).
+ *
+ * Lines only constrain the simplification of lines whose envelope
+ * intersects theirs. computeClusters() sorts lines into clusters
+ * which callers can simplify independently, e.g. concurrently, each
+ * with its own TaggedLinesSimplifier.
  */
 class GEOS_DLL TaggedLinesSimplifier {
 
@@ -101,6 +107,29 @@ public:
 	}
 
 
+	/**
+	 * Sorts lines into clusters which can be simplified
+	 * independently.
+	 *
+	 * Two lines are in the same cluster if a chain of lines with
+	 * intersecting envelopes joins them. Simplifying each cluster
+	 * with its own TaggedLinesSimplifier, with its lines in the given
+	 * order, gives the same result as simplifying all the lines
+	 * together: the segments of other clusters are outside of every
+	 * envelope queried.
+	 * Clusters share no TaggedLineString, so they can be simplified
+	 * from different threads, each with its own simplifier.
+	 *
+	 * Not in JTS: this is a GEOS extension
+	 *
+	 * @param lines the lines to simplify
+	 * @param clusters receives the clusters, in order of their first
+	 *        line; each is the list of the positions of its lines in
+	 *        lines, in increasing order
+	 */
+	static void computeClusters(const std::vector<TaggedLineString*>& lines,
+			std::vector< std::vector<std::size_t> >& clusters);
+
 private:
 
 	void simplify(TaggedLineString& line);
@@ -0,0 +1,123 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_SIMPLIFY_VWLINESIMPLIFIER_H
+#define GEOS_SIMPLIFY_VWLINESIMPLIFIER_H
+
+#include <geos/export.h>
+#include <vector>
+#include <memory> // for auto_ptr
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+	}
+}
+
+namespace geos {
+namespace simplify { // geos::simplify
+
+/** \brief
+ * Simplifies a linestring (sequence of points) using
+ * the Visvalingam-Whyatt algorithm.
+ *
+ * The vertex forming the smallest triangle with its neighbours
+ * is removed repeatedly, until all triangle areas are at least
+ * the square of the distance tolerance.
+ * The endpoints are never removed.
+ *
+ * The triangle areas are kept in an indexed min-heap, so that
+ * simplifying n points takes O(n log n) time.
+ *
+ * The elimination can also be run once, with getEffectiveAreas(),
+ * to simplify the line at any tolerance afterwards in linear time.
+ */
+class GEOS_DLL VWLineSimplifier {
+
+public:
+
+	typedef std::vector<geom::Coordinate> CoordsVect;
+	typedef std::auto_ptr<CoordsVect> CoordsVectAutoPtr;
+
+	typedef std::vector<double> AreasVect;
+	typedef std::auto_ptr<AreasVect> AreasVectAutoPtr;
+
+	/** \brief
+	 * Returns a newly allocated Coordinate vector, wrapped
+	 * into an auto_ptr
+	 */
+	static CoordsVectAutoPtr simplify(
+			const CoordsVect& nPts,
+			double distanceTolerance);
+
+	/** \brief
+	 * Returns the vertices of a line whose effective area is
+	 * at least the square of the distance tolerance.
+	 *
+	 * Gives the same result as simplify(nPts, distanceTolerance).
+	 *
+	 * @param nPts the line
+	 * @param areas the effective areas of nPts, as computed by
+	 *        getEffectiveAreas()
+	 * @param distanceTolerance the approximation tolerance to use
+	 */
+	static CoordsVectAutoPtr simplify(
+			const CoordsVect& nPts,
+			const AreasVect& areas,
+			double distanceTolerance);
+
+	/** \brief
+	 * Computes the effective area of each vertex of a line.
+	 *
+	 * The effective area of a vertex is the area of the triangle
+	 * it formed with its neighbours when it was eliminated, raised
+	 * to the effective area of the vertices eliminated before it.
+	 * Effective areas thus follow the elimination order.
+	 * The endpoints are given an infinite effective area.
+	 *
+	 * @param nPts the line
+	 * @return a newly allocated vector of nPts.size() areas
+	 */
+	static AreasVectAutoPtr getEffectiveAreas(const CoordsVect& nPts);
+
+	VWLineSimplifier(const CoordsVect& nPts, double nDistanceTolerance);
+
+	/** \brief
+	 * Returns a newly allocated Coordinate vector, wrapped
+	 * into an auto_ptr
+	 */
+	CoordsVectAutoPtr simplify();
+
+private:
+
+	const CoordsVect& pts;
+	double distanceTolerance;
+
+    // Declare type as noncopyable
+    VWLineSimplifier(const VWLineSimplifier& other);
+    VWLineSimplifier& operator=(const VWLineSimplifier& rhs);
+};
+
+} // namespace geos::simplify
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_SIMPLIFY_VWLINESIMPLIFIER_H
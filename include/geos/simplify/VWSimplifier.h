@@ -0,0 +1,80 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_SIMPLIFY_VWSIMPLIFIER_H
+#define GEOS_SIMPLIFY_VWSIMPLIFIER_H
+
+#include <geos/export.h>
+#include <memory> // for auto_ptr
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+	}
+}
+
+namespace geos {
+namespace simplify { // geos::simplify
+
+
+/** \brief
+ * Simplifies a Geometry using the Visvalingam-Whyatt algorithm.
+ *
+ * Vertices are removed in order of increasing area of the triangle
+ * they form with their neighbours, as long as that area is less
+ * than the square of the distance tolerance.
+ * This tends to give smoother results than Douglas-Peucker at
+ * similar vertex counts.
+ * See VWLineSimplifier.
+ *
+ * As with DouglasPeuckerSimplifier, polygonal geometries returned
+ * are made valid, but topology is not preserved in general.
+ */
+class GEOS_DLL VWSimplifier {
+
+public:
+
+	static std::auto_ptr<geom::Geometry> simplify(
+			const geom::Geometry* geom,
+			double tolerance);
+
+	VWSimplifier(const geom::Geometry* geom);
+
+	/** \brief
+	 * Sets the distance tolerance for the simplification.
+	 *
+	 * Vertices are removed while the smallest triangle they form
+	 * with their neighbours has an area less than the square of
+	 * this tolerance.
+	 * The tolerance value must be non-negative.  A tolerance value
+	 * of zero is effectively a no-op.
+	 *
+	 * @param distanceTolerance the approximation tolerance to use
+	 */
+	void setDistanceTolerance(double tolerance);
+
+	std::auto_ptr<geom::Geometry> getResultGeometry();
+
+
+private:
+
+	const geom::Geometry* inputGeom;
+
+	double distanceTolerance;
+};
+
+
+} // namespace geos::simplify
+} // namespace geos
+
+#endif // GEOS_SIMPLIFY_VWSIMPLIFIER_H
@@ -18,7 +18,6 @@
 
 #include <geos/export.h>
 #include <cassert>
-#include <set>
 #include <vector>
 
 #include <geos/geom/CoordinateFilter.h>
@@ -48,7 +47,7 @@ public:
 	 * @param target The destination set. 
 	 */
 	UniqueCoordinateArrayFilter(geom::Coordinate::ConstVect &target)
-		: pts(target)
+		: pts(target), table(), tableCount(0)
 	{}
 
 	/**
@@ -64,17 +63,20 @@ public:
 	 * @param coord The "read-only" Coordinate to which
 	 * 				the filter is applied.
 	 */
-	virtual void filter_ro(const geom::Coordinate *coord)
-	{
-		if ( uniqPts.insert(coord).second )
-		{
-			pts.push_back(coord);
-		}
-    }
+	virtual void filter_ro(const geom::Coordinate *coord);
 
 private:
 	geom::Coordinate::ConstVect &pts;	// target set reference
-	geom::Coordinate::ConstSet uniqPts; 	// unique points set
+
+	// Open addressing hash table of the unique points, keyed on
+	// the bits of their x and y. Its size is a power of two and
+	// null entries are free.
+	std::vector<const geom::Coordinate*> table;
+	std::size_t tableCount;
+
+	void grow();
+
+	static std::size_t hash(const geom::Coordinate& c);
 
     // Declare type as noncopyable
     UniqueCoordinateArrayFilter(const UniqueCoordinateArrayFilter& other);
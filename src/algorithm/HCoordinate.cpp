@@ -44,6 +44,17 @@ void
 HCoordinate::intersection(const Coordinate &p1, const Coordinate &p2,
 	const Coordinate &q1, const Coordinate &q2, Coordinate &ret)
 {
+	if ( ! tryIntersection(p1, p2, q1, q2, ret) )
+	{
+		throw NotRepresentableException();
+	}
+}
+
+/*public static*/
+bool
+HCoordinate::tryIntersection(const Coordinate &p1, const Coordinate &p2,
+	const Coordinate &q1, const Coordinate &q2, Coordinate &ret)
+{
 
 #if GEOS_DEBUG
 	cerr << __FUNCTION__ << ":" << endl
@@ -73,10 +84,11 @@ HCoordinate::intersection(const Coordinate &p1, const Coordinate &p2,
 
 	if ( (!FINITE(xInt)) || (!FINITE(yInt)) )
 	{
-		throw NotRepresentableException();
+		return false;
 	}
 
 	ret = Coordinate(xInt, yInt);
+	return true;
 }
 
 /*public*/
@@ -20,7 +20,6 @@
 #include <geos/algorithm/LineIntersector.h>
 #include <geos/algorithm/CGAlgorithms.h>
 #include <geos/algorithm/HCoordinate.h>
-#include <geos/algorithm/NotRepresentableException.h>
 #include <geos/algorithm/CentralEndpointIntersector.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/PrecisionModel.h>
@@ -841,16 +840,16 @@ LineIntersector::safeHCoordinateIntersection(const Coordinate& p1,
 		const Coordinate& p2, const Coordinate& q1,
 		const Coordinate& q2, Coordinate& intPt) const
 {
-	try {
-		HCoordinate::intersection(p1, p2, q1, q2, intPt);
+	if ( HCoordinate::tryIntersection(p1, p2, q1, q2, intPt) )
+	{
 #if GEOS_DEBUG
 		cerr<<" HCoordinate found intersection h:"<<intPt.toString()<<endl;
 #endif
+		return;
+	}
 
-	} catch (const NotRepresentableException& /* e */) {
-		// compute an approximate result
-		intPt = CentralEndpointIntersector::getIntersection(p1, p2, q1, q2);
-    	}
+	// compute an approximate result
+	intPt = CentralEndpointIntersector::getIntersection(p1, p2, q1, q2);
 }
 
 } // namespace geos.algorithm
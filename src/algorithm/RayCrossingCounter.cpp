@@ -22,10 +22,22 @@
 #include <geos/geom/Location.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateArraySequence.h>
 
 
 namespace geos {
 namespace algorithm {
+
+namespace {
+
+/*
+ * Number of segments tested at once by the contiguous ring kernel.
+ * Each segment gets a bit in the skip masks.
+ */
+const std::size_t SEGMENT_BLOCK_SIZE = 4;
+
+} // anonymous namespace
+
 //
 // private:
 //
@@ -41,6 +53,15 @@ namespace algorithm {
 RayCrossingCounter::locatePointInRing(const geom::Coordinate& point,
                          const geom::CoordinateSequence& ring) 
 {
+	const geom::CoordinateArraySequence* cas =
+		dynamic_cast<const geom::CoordinateArraySequence*>(&ring);
+	if ( cas )
+	{
+		const std::vector<geom::Coordinate>& v = *(cas->toVector());
+		if ( v.empty() ) return geom::Location::EXTERIOR;
+		return locatePointInRing(point, &v[0], v.size());
+	}
+
 	RayCrossingCounter rcc(point);
 
 	for (int i = 1, ni = ring.size(); i < ni; i++) 
@@ -76,6 +97,61 @@ RayCrossingCounter::locatePointInRing(const geom::Coordinate& point,
 }
 
 
+/*static*/ int
+RayCrossingCounter::locatePointInRing(const geom::Coordinate& point,
+	         const geom::Coordinate* ring, std::size_t n)
+{
+	RayCrossingCounter rcc(point);
+
+	double const px = point.x;
+	double const py = point.y;
+
+	std::size_t i = 1;
+
+	// Block i covers the segments ending at vertices i .. i+3.
+	// A segment can be skipped when both of its endpoints are
+	// strictly above, strictly below or strictly left of the
+	// point: countSegment() would not change the count for it.
+	for ( ; i + SEGMENT_BLOCK_SIZE <= n; i += SEGMENT_BLOCK_SIZE )
+	{
+		const geom::Coordinate* c = ring + i - 1;
+
+		unsigned int below = 0, above = 0, left = 0;
+		for ( std::size_t k = 0; k <= SEGMENT_BLOCK_SIZE; ++k )
+		{
+			below |= static_cast<unsigned int>(c[k].y < py) << k;
+			above |= static_cast<unsigned int>(c[k].y > py) << k;
+			left  |= static_cast<unsigned int>(c[k].x < px) << k;
+		}
+
+		unsigned int const skip = ( below & (below >> 1) )
+		                        | ( above & (above >> 1) )
+		                        | ( left & (left >> 1) );
+
+		unsigned int const allSkipped = (1u << SEGMENT_BLOCK_SIZE) - 1;
+		if ( ( skip & allSkipped ) == allSkipped ) continue;
+
+		for ( std::size_t k = 0; k < SEGMENT_BLOCK_SIZE; ++k )
+		{
+			if ( skip & (1u << k) ) continue;
+
+			rcc.countSegment(c[k + 1], c[k]);
+
+			if ( rcc.isOnSegment() )
+				return rcc.getLocation();
+		}
+	}
+
+	for ( ; i < n; ++i )
+	{
+		rcc.countSegment(ring[ i ], ring[ i - 1 ]);
+
+		if ( rcc.isOnSegment() )
+			return rcc.getLocation();
+	}
+	return rcc.getLocation();
+}
+
 void 
 RayCrossingCounter::countSegment(const geom::Coordinate& p1,
                                  const geom::Coordinate& p2) 
@@ -135,9 +211,8 @@ RayCrossingCounter::countSegment(const geom::Coordinate& p1,
 		// Compute the sign of the ordinate of intersection
 		// with the x-axis. (y2 != y1, so denominator
 		// will never be 0.0)
-                        // MD - faster & more robust computation?
-                double xIntSign = RobustDeterminant::signOfDet2x2(x1, y1, x2, y2);
-		if (xIntSign == 0.0) 
+		int xIntSign = RobustDeterminant::signOfDet2x2(x1, y1, x2, y2);
+		if (xIntSign == 0) 
 		{
 			isPointOnSegment = true;
 			return;
@@ -147,7 +222,7 @@ RayCrossingCounter::countSegment(const geom::Coordinate& p1,
 			xIntSign = -xIntSign;
 
 		// The segment crosses the ray if the sign is strictly positive.
-		if (xIntSign > 0.0) 
+		if (xIntSign > 0) 
 			crossingCount++;
 	}
 }
@@ -22,6 +22,7 @@
 #include <geos/util/IllegalArgumentException.h>
 
 #include <cmath>
+#include <limits>
 
 #include <geos/platform.h> // for ISNAN, FINITE
 
@@ -34,11 +35,40 @@ using namespace std; // for isfinite..
 namespace geos {
 namespace algorithm { // geos.algorithm
 
+namespace {
+
+/*
+ * Bound on the relative error of the floating point evaluation of
+ * a 2x2 determinant: Shewchuk's ccwerrboundA, (3 + 16 * eps) * eps,
+ * with eps being half the machine epsilon.
+ */
+const double DET_ERR_BOUND =
+	(3.0 + 8.0 * std::numeric_limits<double>::epsilon()) *
+	0.5 * std::numeric_limits<double>::epsilon();
+
+/*
+ * The relative bound does not hold when the products underflow,
+ * so determinants smaller than this are never trusted.
+ */
+const double DET_MIN_TRUSTED = std::numeric_limits<double>::min();
+
+} // anonymous namespace
 
 int RobustDeterminant::signOfDet2x2(double x1,double y1,double x2,double y2) {
 	// returns -1 if the determinant is negative,
 	// returns  1 if the determinant is positive,
 	// retunrs  0 if the determinant is null.
+
+	// Floating point filter. Comparisons involving NaN are false,
+	// so non-finite input always falls through to the checks below.
+	double const detLeft = x1 * y2;
+	double const detRight = y1 * x2;
+	double const det = detLeft - detRight;
+	double const errBound = DET_ERR_BOUND *
+		( fabs(detLeft) + fabs(detRight) ) + DET_MIN_TRUSTED;
+	if ( det > errBound ) return 1;
+	if ( -det > errBound ) return -1;
+
 	int sign=1;
 	double swap;
 	double k;
@@ -18,16 +18,25 @@
 
 #include <geos/algorithm/distance/DiscreteHausdorffDistance.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/LineSegment.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/platform.h> // for DoubleMax
 
 //#include <geos/algorithm/CGAlgorithms.h>
 //#include <geos/geom/Geometry.h>
-//#include <geos/geom/Polygon.h>
-//#include <geos/geom/GeometryCollection.h>
 //#include <geos/geom/Location.h>
-//#include <geos/geom/LineString.h>
 
 #include <typeinfo>
 #include <cassert>
+#include <cmath> // for fabs
+#include <algorithm> // for max
+#include <limits>
+#include <memory> // for auto_ptr
+#include <vector>
 
 using namespace geos::geom;
 
@@ -35,6 +44,374 @@ namespace geos {
 namespace algorithm { // geos.algorithm
 namespace distance { // geos.algorithm.distance
 
+namespace {
+
+/// Number of facets from which they are looked up through an STRtree
+const std::size_t MIN_INDEXED_FACETS = 64;
+
+/*
+ * The segments and points of a geometry, with the same orientation
+ * and in the same order as DistanceToPoint visits them, so that
+ * closest points and ties come out the same.
+ */
+class FacetDistanceFinder
+{
+public:
+
+	FacetDistanceFinder(const Geometry& geom)
+		:
+		initialRadius(0.0)
+	{
+		add(geom);
+		if ( facets.size() >= MIN_INDEXED_FACETS ) buildIndex();
+	}
+
+	/*
+	 * Tests whether the distance from pt to the geometry is
+	 * greater than bound, which is always the case for a negative
+	 * bound. If so, sets minPtDist to the closest point pair, as
+	 * DistanceToPoint::computeDistance would.
+	 */
+	bool exceeds(const Coordinate& pt, double bound,
+	             PointPairDistance& minPtDist)
+	{
+		if ( ! tree.get() || ! isFinite(pt) )
+			return exceedsByScan(pt, bound, minPtDist);
+
+		// Query boxes of doubling size until one holds a facet,
+		// then the box reaching the closest one
+		Envelope ptEnv(pt);
+		double radius = initialRadius + env.distance(&ptEnv);
+		if ( ! (radius > 0.0) ) radius = std::numeric_limits<double>::min();
+
+		for (;;)
+		{
+			query(pt, radius);
+			if ( ! candidates.empty() ) break;
+			radius *= 2;
+		}
+
+		Coordinate closestPt;
+		double minDistance = closest(pt, bound, closestPt);
+		if ( minDistance <= bound ) return false;
+
+		double r = reach(pt, minDistance);
+		if ( r >= radius )
+		{
+			query(pt, r);
+			if ( closest(pt, bound, closestPt) <= bound ) return false;
+		}
+
+		minPtDist.setMinimum(closestPt, pt);
+		return true;
+	}
+
+private:
+
+	struct Facet {
+		LineSegment seg;
+		bool isPoint;
+		Envelope env;
+
+		const Coordinate& closestPoint(const Coordinate& pt,
+		                               Coordinate& closestPt) const
+		{
+			if ( isPoint ) return seg.p0;
+			seg.closestPoint(pt, closestPt);
+			return closestPt;
+		}
+	};
+
+	std::vector<Facet> facets;
+
+	std::auto_ptr<index::strtree::STRtree> tree;
+
+	/// Envelope of the facets
+	Envelope env;
+
+	/// Mean size of the facets, or of their spacing if larger
+	double initialRadius;
+
+	std::vector<void*> candidates;
+
+	void add(const Geometry& geom)
+	{
+		if ( const LineString* ls = dynamic_cast<const LineString*>(&geom) )
+		{
+			addLine(*ls);
+		}
+		else if ( const Polygon* pl = dynamic_cast<const Polygon*>(&geom) )
+		{
+			addLine(*pl->getExteriorRing());
+			for (std::size_t i=0, n=pl->getNumInteriorRing(); i<n; ++i)
+			{
+				addLine(*pl->getInteriorRingN(i));
+			}
+		}
+		else if ( const GeometryCollection* gc = dynamic_cast<const GeometryCollection*>(&geom) )
+		{
+			for (std::size_t i=0, n=gc->getNumGeometries(); i<n; ++i)
+			{
+				add(*gc->getGeometryN(i));
+			}
+		}
+		else if ( const Coordinate* c = geom.getCoordinate() )
+		{
+			// assume geom is Point
+			Facet f;
+			f.seg.p0 = f.seg.p1 = *c;
+			f.isPoint = true;
+			facets.push_back(f);
+		}
+	}
+
+	void addLine(const LineString& line)
+	{
+		const CoordinateSequence& coords = *line.getCoordinatesRO();
+
+		// DistanceToPoint reuses the segment, replacing
+		// its endpoints in turn
+		Facet f;
+		f.isPoint = false;
+		for (std::size_t i=1, n=coords.size(); i<n; ++i)
+		{
+			if ( i % 2 ) {
+				f.seg.p0 = coords.getAt(i-1);
+				f.seg.p1 = coords.getAt(i);
+			}
+			else {
+				f.seg.p0 = coords.getAt(i);
+				f.seg.p1 = coords.getAt(i-1);
+			}
+			facets.push_back(f);
+		}
+	}
+
+	void buildIndex()
+	{
+		double totalSize = 0.0;
+		tree.reset(new index::strtree::STRtree());
+		for (std::size_t i=0, n=facets.size(); i<n; ++i)
+		{
+			Facet& f = facets[i];
+			f.env.init(f.seg.p0, f.seg.p1);
+			env.expandToInclude(&f.env);
+			totalSize += f.env.getWidth() + f.env.getHeight();
+			tree->insert(&f.env, &f);
+		}
+		// points have no size
+		totalSize = std::max(totalSize, env.getWidth() + env.getHeight());
+		initialRadius = totalSize / facets.size();
+	}
+
+	static bool isFinite(const Coordinate& pt)
+	{
+		return std::fabs(pt.x) <= DoubleMax && std::fabs(pt.y) <= DoubleMax;
+	}
+
+	/*
+	 * Half size of a box around pt holding all facets within
+	 * distance of it, allowing for rounding of the box bounds
+	 */
+	static double reach(const Coordinate& pt, double distance)
+	{
+		return distance + 4 * std::numeric_limits<double>::epsilon() *
+		       ( distance + std::fabs(pt.x) + std::fabs(pt.y) );
+	}
+
+	void query(const Coordinate& pt, double radius)
+	{
+		Envelope box(pt.x - radius, pt.x + radius,
+		             pt.y - radius, pt.y + radius);
+		candidates.clear();
+		tree->query(&box, candidates);
+	}
+
+	/*
+	 * Finds the closest point to pt on the candidates, on the
+	 * first facet in order among equally close ones, and
+	 * returns its distance to pt.
+	 * Stops at the first candidate not farther than bound.
+	 */
+	double closest(const Coordinate& pt, double bound,
+	               Coordinate& closestPt) const
+	{
+		const Facet* best = 0;
+		double minDistance = 0.0;
+		Coordinate c;
+		for (std::size_t i=0, n=candidates.size(); i<n; ++i)
+		{
+			const Facet* f = static_cast<const Facet*>(candidates[i]);
+			const Coordinate& fc = f->closestPoint(pt, c);
+			double d = fc.distance(pt);
+			if ( d <= bound ) return d;
+			if ( best && ( d > minDistance ||
+			     ( d == minDistance && f > best ) ) )
+				continue;
+			best = f;
+			minDistance = d;
+			closestPt = fc;
+		}
+		return minDistance;
+	}
+
+	bool exceedsByScan(const Coordinate& pt, double bound,
+	                   PointPairDistance& minPtDist) const
+	{
+		const Facet* best = 0;
+		double minDistance = 0.0;
+		Coordinate closestPt, c;
+		for (std::size_t i=0, n=facets.size(); i<n; ++i)
+		{
+			const Facet& f = facets[i];
+			const Coordinate& fc = f.closestPoint(pt, c);
+			double d = fc.distance(pt);
+			if ( d <= bound ) return false;
+			if ( best && ! ( d < minDistance ) ) continue;
+			best = &f;
+			minDistance = d;
+			closestPt = fc;
+		}
+		if ( best ) minPtDist.setMinimum(closestPt, pt);
+		return true;
+	}
+
+	// Declare type as noncopyable
+	FacetDistanceFinder(const FacetDistanceFinder& other);
+	FacetDistanceFinder& operator=(const FacetDistanceFinder& rhs);
+};
+
+/*
+ * Keeps the maximum distance from the points to the other geometry,
+ * only computing it for points which may raise that maximum, or
+ * the bound given by the caller.
+ * If stopWhenExceeded, stops at the first point farther than that.
+ */
+class BoundedMaxDistance
+{
+public:
+
+	BoundedMaxDistance(FacetDistanceFinder& nFinder, double nOuterBound,
+	                   bool nStopWhenExceeded)
+		:
+		finder(nFinder),
+		outerBound(nOuterBound),
+		stopWhenExceeded(nStopWhenExceeded),
+		exceeded(false)
+	{}
+
+	void add(const Coordinate& pt)
+	{
+		minPtDist.initialize();
+		if ( finder.exceeds(pt, bound(), minPtDist) )
+		{
+			maxPtDist.setMaximum(minPtDist);
+			exceeded = true;
+		}
+	}
+
+	bool isDone() const { return stopWhenExceeded && exceeded; }
+
+	bool isExceeded() const { return exceeded; }
+
+	const PointPairDistance& getMaxPointDistance() const
+	{
+		return maxPtDist;
+	}
+
+private:
+
+	FacetDistanceFinder& finder;
+	double outerBound;
+	bool stopWhenExceeded;
+	bool exceeded;
+	PointPairDistance maxPtDist;
+	PointPairDistance minPtDist;
+
+	/*
+	 * A point not farther than this can not change the result.
+	 * Distances are NaN until set.
+	 */
+	double bound() const
+	{
+		double b = -1.0;
+		if ( outerBound > b ) b = outerBound;
+		if ( exceeded && maxPtDist.getDistance() > b )
+			b = maxPtDist.getDistance();
+		return b;
+	}
+};
+
+class BoundedMaxPointDistanceFilter : public CoordinateFilter
+{
+public:
+
+	BoundedMaxPointDistanceFilter(BoundedMaxDistance& nMaxDist)
+		:
+		maxDist(nMaxDist)
+	{}
+
+	void filter_ro(const Coordinate* pt)
+	{
+		if ( ! maxDist.isDone() ) maxDist.add(*pt);
+	}
+
+private:
+
+	BoundedMaxDistance& maxDist;
+
+	// Declare type as noncopyable
+	BoundedMaxPointDistanceFilter(const BoundedMaxPointDistanceFilter& other);
+	BoundedMaxPointDistanceFilter& operator=(const BoundedMaxPointDistanceFilter& rhs);
+};
+
+class BoundedMaxDensifiedDistanceFilter : public CoordinateSequenceFilter
+{
+public:
+
+	BoundedMaxDensifiedDistanceFilter(BoundedMaxDistance& nMaxDist,
+	                                  double fraction)
+		:
+		maxDist(nMaxDist),
+		numSubSegs( std::size_t(util::round(1.0/fraction)) )
+	{}
+
+	void filter_ro(const CoordinateSequence& seq, std::size_t index)
+	{
+		// as MaxDensifiedByFractionDistanceFilter
+		if (index == 0)
+			return;
+
+		const Coordinate& p0 = seq.getAt(index - 1);
+		const Coordinate& p1 = seq.getAt(index);
+
+		double delx = (p1.x - p0.x)/numSubSegs;
+		double dely = (p1.y - p0.y)/numSubSegs;
+
+		for (std::size_t i = 0; i < numSubSegs && ! maxDist.isDone(); ++i)
+		{
+			double x = p0.x + i*delx;
+			double y = p0.y + i*dely;
+			maxDist.add(Coordinate(x, y));
+		}
+	}
+
+	bool isGeometryChanged() const { return false; }
+
+	bool isDone() const { return maxDist.isDone(); }
+
+private:
+
+	BoundedMaxDistance& maxDist;
+	std::size_t numSubSegs;
+
+	// Declare type as noncopyable
+	BoundedMaxDensifiedDistanceFilter(const BoundedMaxDensifiedDistanceFilter& other);
+	BoundedMaxDensifiedDistanceFilter& operator=(const BoundedMaxDensifiedDistanceFilter& rhs);
+};
+
+} // anonymous namespace
+
 void
 DiscreteHausdorffDistance::MaxDensifiedByFractionDistanceFilter::filter_ro(
 	const geom::CoordinateSequence& seq, size_t index)
@@ -82,6 +459,27 @@ DiscreteHausdorffDistance::distance(const geom::Geometry& g0,
 	return dist.distance();
 }
 
+/* static public */
+bool
+DiscreteHausdorffDistance::isWithinDistance(const geom::Geometry& g0,
+	                       const geom::Geometry& g1,
+	                       double maxDistance)
+{
+	DiscreteHausdorffDistance dist(g0, g1);
+	return dist.isWithinDistance(maxDistance);
+}
+
+/* static public */
+bool
+DiscreteHausdorffDistance::isWithinDistance(const geom::Geometry& g0,
+	                       const geom::Geometry& g1,
+	                       double maxDistance, double densifyFrac)
+{
+	DiscreteHausdorffDistance dist(g0, g1);
+	dist.setDensifyFraction(densifyFrac);
+	return dist.isWithinDistance(maxDistance);
+}
+
 /* private */
 void
 DiscreteHausdorffDistance::computeOrientedDistance(
@@ -89,17 +487,51 @@ DiscreteHausdorffDistance::computeOrientedDistance(
 		const geom::Geometry& geom,
 		PointPairDistance& ptDist)
 {
-	MaxPointDistanceFilter distFilter(geom);
+	FacetDistanceFinder finder(geom);
+
+	/*
+	 * Results are merged with strict comparisons, so points
+	 * not farther than ptDist can be skipped (its distance
+	 * is NaN until set)
+	 */
+	BoundedMaxDistance vertexDist(finder, ptDist.getDistance(), false);
+	BoundedMaxPointDistanceFilter distFilter(vertexDist);
+	discreteGeom.apply_ro(&distFilter);
+	ptDist.setMaximum(vertexDist.getMaxPointDistance());
+
+	if (densifyFrac > 0)
+	{
+		BoundedMaxDistance fracDist(finder, ptDist.getDistance(), false);
+		BoundedMaxDensifiedDistanceFilter fracFilter(fracDist,
+							  densifyFrac);
+		discreteGeom.apply_ro(fracFilter);
+		ptDist.setMaximum(fracDist.getMaxPointDistance());
+	}
+}
+
+/* private */
+bool
+DiscreteHausdorffDistance::isOrientedWithinDistance(
+		const geom::Geometry& discreteGeom,
+		const geom::Geometry& geom,
+		double maxDistance)
+{
+	FacetDistanceFinder finder(geom);
+
+	BoundedMaxDistance vertexDist(finder, maxDistance, true);
+	BoundedMaxPointDistanceFilter distFilter(vertexDist);
 	discreteGeom.apply_ro(&distFilter);
-	ptDist.setMaximum(distFilter.getMaxPointDistance());
+	if ( vertexDist.isExceeded() ) return false;
 
 	if (densifyFrac > 0)
 	{
-		MaxDensifiedByFractionDistanceFilter fracFilter(geom,
+		BoundedMaxDistance fracDist(finder, maxDistance, true);
+		BoundedMaxDensifiedDistanceFilter fracFilter(fracDist,
 							  densifyFrac);
 		discreteGeom.apply_ro(fracFilter);
-		ptDist.setMaximum(fracFilter.getMaxPointDistance());
+		if ( fracDist.isExceeded() ) return false;
 	}
+	return true;
 }
 
 } // namespace geos.algorithm.distance
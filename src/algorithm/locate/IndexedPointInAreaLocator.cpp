@@ -25,6 +25,8 @@
 #include <geos/util/IllegalArgumentException.h>
 #include <geos/algorithm/RayCrossingCounter.h>
 #include <geos/index/ItemVisitor.h> 
+#include <geos/geom/Location.h>
+#include <geos/platform.h> // for ISNAN
 
 #include <algorithm>
 #include <typeinfo>
@@ -32,10 +34,50 @@
 namespace geos {
 namespace algorithm { 
 namespace locate { 
+
+namespace {
+
+/// Max number of points sharing an index traversal in batch locate
+const std::size_t MAX_BATCH_SIZE = 64;
+
+class SegmentCollector : public index::ItemVisitor
+{
+private:
+	std::vector<const geom::LineSegment*>& segs;
+
+	// Declare type as noncopyable
+	SegmentCollector(const SegmentCollector& other);
+	SegmentCollector& operator=(const SegmentCollector& rhs);
+
+public:
+	SegmentCollector(std::vector<const geom::LineSegment*>& nSegs)
+		: segs(nSegs)
+	{}
+
+	void visitItem(void * item)
+	{
+		segs.push_back(static_cast<const geom::LineSegment*>(item));
+	}
+};
+
+class YOrder
+{
+	const double* ys;
+public:
+	YOrder(const double* nYs) : ys(nYs) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		return ys[a] < ys[b];
+	}
+};
+
+} // anonymous namespace
+
 //
 // private:
 //
 IndexedPointInAreaLocator::IntervalIndexedGeometry::IntervalIndexedGeometry( const geom::Geometry & g)
+	: totalSegmentHeight(0.0)
 {
 	index = new index::intervalrtree::SortedPackedIntervalRTree();
 	init( g);
@@ -66,6 +108,9 @@ IndexedPointInAreaLocator::IntervalIndexedGeometry::init( const geom::Geometry &
 
 		delete pts;
 	}
+
+	// build now, so that locate() does not modify the index
+	index->build();
 }
 
 void 
@@ -80,9 +125,17 @@ IndexedPointInAreaLocator::IntervalIndexedGeometry::addLine( geom::CoordinateSeq
 		// NOTE: seg ownership still ours
 		allocatedSegments.push_back(seg);
 		index->insert( min, max, seg);
+		totalSegmentHeight += max - min;
 	}
 } 
 
+double
+IndexedPointInAreaLocator::IntervalIndexedGeometry::getAverageSegmentHeight() const
+{
+	if ( allocatedSegments.empty() ) return 0.0;
+	return totalSegmentHeight / allocatedSegments.size();
+}
+
 
 void 
 IndexedPointInAreaLocator::buildIndex( const geom::Geometry & g)
@@ -127,6 +180,63 @@ IndexedPointInAreaLocator::locate( const geom::Coordinate * /*const*/ p)
 	return rcc.getLocation();
 }
 
+void
+IndexedPointInAreaLocator::locate(std::size_t n, const double* xs,
+                                  const double* ys, int* locations)
+{
+	std::vector<std::size_t> order;
+	order.reserve(n);
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		if ( ISNAN(xs[i]) || ISNAN(ys[i]) )
+			locations[i] = geom::Location::EXTERIOR;
+		else
+			order.push_back(i);
+	}
+	std::sort(order.begin(), order.end(), YOrder(ys));
+
+	// Points closer in y than the typical segment height mostly
+	// hit the same segments, so they are worth a shared query.
+	double const maxSpan = index->getAverageSegmentHeight();
+
+	std::vector<const geom::LineSegment*> segs;
+	SegmentCollector collector(segs);
+
+	for ( std::size_t i = 0, ni = order.size(); i < ni; )
+	{
+		double const minY = ys[order[i]];
+		std::size_t j = i + 1;
+		while ( j < ni && j - i < MAX_BATCH_SIZE
+		        && ys[order[j]] - minY <= maxSpan )
+		{
+			++j;
+		}
+		double const maxY = ys[order[j - 1]];
+
+		segs.clear();
+		index->query(minY, maxY, &collector);
+
+		for ( ; i < j; ++i )
+		{
+			std::size_t const k = order[i];
+			geom::Coordinate const p(xs[k], ys[k]);
+			algorithm::RayCrossingCounter rcc(p);
+
+			for ( std::size_t s = 0, ns = segs.size(); s < ns; ++s )
+			{
+				const geom::LineSegment& seg = *segs[s];
+				// same filter as the interval index query
+				if ( ( seg.p0.y < p.y && seg.p1.y < p.y ) ||
+				     ( seg.p0.y > p.y && seg.p1.y > p.y ) )
+					continue;
+				rcc.countSegment(seg.p0, seg.p1);
+				if ( rcc.isOnSegment() ) break;
+			}
+			locations[k] = rcc.getLocation();
+		}
+	}
+}
+
 void 
 IndexedPointInAreaLocator::SegmentVisitor::visitItem( void * item)
 {
@@ -27,7 +27,6 @@
 #include <geos/algorithm/CGAlgorithms.h>
 #include <geos/algorithm/LineIntersector.h>
 #include <geos/algorithm/HCoordinate.h>
-#include <geos/algorithm/NotRepresentableException.h>
 #include <geos/util/IllegalStateException.h>
 #include <geos/profiler.h>
 #include <geos/inline.h>
@@ -42,7 +41,6 @@
 using namespace std;
 //using namespace geos::algorithm;
 using geos::algorithm::HCoordinate;
-using geos::algorithm::NotRepresentableException;
 using geos::algorithm::LineIntersector;
 
 namespace geos {
@@ -255,14 +253,7 @@ LineSegment::intersection(const LineSegment& line, Coordinate& ret) const
 bool
 LineSegment::lineIntersection(const LineSegment& line, Coordinate& ret) const
 {
-	try {
-		HCoordinate::intersection(p0, p1, line.p0, line.p1, ret);
-		return true;
-	}
-	catch (const NotRepresentableException& /*ex*/) {
-		// eat this exception, and return null;
-	}
-	return false;
+	return HCoordinate::tryIntersection(p0, p1, line.p0, line.p1, ret);
 }
 
 
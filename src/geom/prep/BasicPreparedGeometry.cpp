@@ -21,11 +21,35 @@
 #include <geos/geom/Coordinate.h> 
 #include <geos/algorithm/PointLocator.h> 
 #include <geos/geom/util/ComponentCoordinateExtracter.h> 
+#include <geos/geom/GeometryComponentFilter.h> 
+#include <geos/geom/CoordinateSequence.h> 
+#include <geos/geom/LineString.h> 
+#include <geos/geom/Point.h> 
 
 namespace geos {
 namespace geom { // geos.geom
 namespace prep { // geos.geom.prep
 
+namespace {
+
+// Fills the state Geometry and CoordinateSequence compute on first use
+class FreezeFilter: public GeometryComponentFilter {
+public:
+	void filter_ro(const Geometry *geom)
+	{
+		geom->getEnvelopeInternal();
+
+		const CoordinateSequence *seq = NULL;
+		if ( const LineString *ls = dynamic_cast<const LineString *>(geom) )
+			seq = ls->getCoordinatesRO();
+		else if ( const Point *pt = dynamic_cast<const Point *>(geom) )
+			seq = pt->getCoordinatesRO();
+		if ( seq ) seq->getDimension();
+	}
+};
+
+} // anonymous namespace
+
 /*            *
  * protected: *
  *            */
@@ -61,6 +85,13 @@ BasicPreparedGeometry::~BasicPreparedGeometry( )
 {
 }
 
+void
+BasicPreparedGeometry::freeze() const
+{
+	FreezeFilter filter;
+	baseGeom->apply_ro(&filter);
+}
+
 
 bool 
 BasicPreparedGeometry::isAnyTargetComponentInTest( const geom::Geometry * testGeom) const
@@ -52,6 +52,15 @@ PreparedLineString::getIntersectionFinder()
 	return segIntFinder;
 }
 
+void
+PreparedLineString::freeze() const
+{
+	BasicPreparedGeometry::freeze();
+
+	PreparedLineString& prep = *(const_cast<PreparedLineString*>(this));
+	prep.getIntersectionFinder();
+}
+
 bool 
 PreparedLineString::intersects(const geom::Geometry * g) const
 {
@@ -29,8 +29,11 @@
 #include <geos/operation/predicate/RectangleIntersects.h>
 #include <geos/algorithm/locate/PointOnGeometryLocator.h>
 #include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Location.h>
 // std
 #include <cstddef>
+#include <vector>
 
 namespace geos {
 namespace geom { // geos.geom
@@ -78,6 +81,15 @@ getPointLocator() const
 	return ptOnGeomLoc;
 }
 
+void
+PreparedPolygon::
+freeze() const
+{
+	BasicPreparedGeometry::freeze();
+	getIntersectionFinder();
+	getPointLocator();
+}
+
 bool 
 PreparedPolygon::
 contains( const geom::Geometry * g) const
@@ -144,6 +156,52 @@ intersects( const geom::Geometry* g) const
 	return PreparedPolygonIntersects::intersects( this, g);
 }
 
+void
+PreparedPolygon::
+containsXY(std::size_t n, const double* xs, const double* ys,
+           unsigned char* results) const
+{
+	const geom::Envelope* env = getGeometry().getEnvelopeInternal();
+
+	// short-circuit test, which is all a rectangle needs
+	std::vector<std::size_t> candidates;
+	for ( std::size_t i = 0; i < n; ++i )
+	{
+		results[i] = 0;
+		if ( isRectangle )
+		{
+			results[i] = xs[i] > env->getMinX() && xs[i] < env->getMaxX()
+			          && ys[i] > env->getMinY() && ys[i] < env->getMaxY();
+		}
+		else if ( env->contains(xs[i], ys[i]) )
+		{
+			candidates.push_back(i);
+		}
+	}
+	if ( candidates.empty() ) return;
+
+	std::vector<double> cxs(candidates.size());
+	std::vector<double> cys(candidates.size());
+	for ( std::size_t i = 0, ni = candidates.size(); i < ni; ++i )
+	{
+		cxs[i] = xs[candidates[i]];
+		cys[i] = ys[candidates[i]];
+	}
+
+	// getPointLocator() always builds an IndexedPointInAreaLocator
+	algorithm::locate::IndexedPointInAreaLocator* loc =
+		static_cast<algorithm::locate::IndexedPointInAreaLocator*>(
+			getPointLocator());
+
+	std::vector<int> locs(candidates.size());
+	loc->locate(candidates.size(), &cxs[0], &cys[0], &locs[0]);
+
+	for ( std::size_t i = 0, ni = candidates.size(); i < ni; ++i )
+	{
+		results[candidates[i]] = ( locs[i] == geom::Location::INTERIOR );
+	}
+}
+
 } // namespace geos.geom.prep
 } // namespace geos.geom
 } // namespace geos
@@ -0,0 +1,187 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: index/kdtree/KdTree.java rev 1.12 (JTS-1.12)
+ *
+ **********************************************************************/
+
+#include <geos/index/kdtree/KdTree.h>
+#include <geos/index/kdtree/KdNode.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Envelope.h>
+
+#include <vector>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+namespace kdtree { // geos.index.kdtree
+
+/*public*/
+KdTree::KdTree()
+	:
+	root(0),
+	tolerance(0.0)
+{
+}
+
+/*public*/
+KdTree::KdTree(double nTolerance)
+	:
+	root(0),
+	tolerance(nTolerance)
+{
+}
+
+/*public*/
+KdNode*
+KdTree::insert(const Coordinate& p)
+{
+	return insert(p, 0);
+}
+
+/*public*/
+KdNode*
+KdTree::insert(const Coordinate& p, void* data)
+{
+	if ( tolerance > 0.0 && root )
+	{
+		KdNode* matchNode = findBestMatchNode(p);
+		if ( matchNode )
+		{
+			// point already in index - increment counter
+			matchNode->increment();
+			return matchNode;
+		}
+	}
+	return insertExact(p, data);
+}
+
+/*private*/
+KdNode*
+KdTree::findBestMatchNode(const Coordinate& p) const
+{
+	Envelope queryEnv(p);
+	queryEnv.expandBy(tolerance);
+
+	std::vector<KdNode*> candidates;
+	query(queryEnv, candidates);
+
+	KdNode* matchNode = 0;
+	double matchDist = 0.0;
+	for (std::size_t i = 0, n = candidates.size(); i < n; ++i)
+	{
+		KdNode* node = candidates[i];
+		double dist = p.distance(node->getCoordinate());
+		if ( dist > tolerance ) continue;
+		if ( ! matchNode || dist < matchDist )
+		{
+			matchNode = node;
+			matchDist = dist;
+		}
+	}
+	return matchNode;
+}
+
+/*private*/
+KdNode*
+KdTree::insertExact(const Coordinate& p, void* data)
+{
+	KdNode* currentNode = root;
+	KdNode* leafNode = root;
+	bool isOddLevel = true;
+	bool isLessThan = true;
+
+	// Traverse the tree, first cutting the plane vertically at the
+	// root node, then alternating horizontally and vertically.
+	// A point equal to a node on the path is merged with it,
+	// since it would always follow the same path when inserted.
+	while ( currentNode )
+	{
+		if ( p.equals2D(currentNode->getCoordinate()) )
+		{
+			currentNode->increment();
+			return currentNode;
+		}
+
+		if ( isOddLevel ) {
+			isLessThan = p.x < currentNode->getX();
+		} else {
+			isLessThan = p.y < currentNode->getY();
+		}
+		leafNode = currentNode;
+		currentNode = isLessThan ? currentNode->getLeft()
+		                         : currentNode->getRight();
+		isOddLevel = ! isOddLevel;
+	}
+
+	nodes.push_back(KdNode(p, data));
+	KdNode* node = &nodes.back();
+
+	if ( ! leafNode ) {
+		root = node;
+	} else if ( isLessThan ) {
+		leafNode->setLeft(node);
+	} else {
+		leafNode->setRight(node);
+	}
+	return node;
+}
+
+/*public*/
+void
+KdTree::query(const Envelope& queryEnv, std::vector<KdNode*>& result) const
+{
+	if ( ! root ) return;
+
+	// (node, isOddLevel) pairs still to be visited
+	std::vector< std::pair<KdNode*, bool> > stack;
+	stack.push_back(std::make_pair(root, true));
+
+	while ( ! stack.empty() )
+	{
+		KdNode* currentNode = stack.back().first;
+		bool odd = stack.back().second;
+		stack.pop_back();
+
+		double min, max, discriminant;
+		if ( odd ) {
+			min = queryEnv.getMinX();
+			max = queryEnv.getMaxX();
+			discriminant = currentNode->getX();
+		} else {
+			min = queryEnv.getMinY();
+			max = queryEnv.getMaxY();
+			discriminant = currentNode->getY();
+		}
+
+		if ( queryEnv.contains(currentNode->getCoordinate()) ) {
+			result.push_back(currentNode);
+		}
+
+		// Points equal to the discriminant go right
+		bool searchLeft = min < discriminant;
+		bool searchRight = discriminant <= max;
+
+		if ( searchRight && currentNode->getRight() ) {
+			stack.push_back(std::make_pair(currentNode->getRight(), ! odd));
+		}
+		if ( searchLeft && currentNode->getLeft() ) {
+			stack.push_back(std::make_pair(currentNode->getLeft(), ! odd));
+		}
+	}
+}
+
+} // namespace geos.index.kdtree
+} // namespace geos.index
+} // namespace geos
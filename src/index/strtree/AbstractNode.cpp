@@ -43,7 +43,10 @@ const void *
 AbstractNode::getBounds() const
 {
 	if (bounds==NULL) {
-		bounds = computeBounds();
+		// Empty nodes have no bounds: leave them NULL without
+		// writing, so that queries of a built tree only read
+		void* computed = computeBounds();
+		if (computed != NULL) bounds = computed;
 	}
 	return bounds;
 }
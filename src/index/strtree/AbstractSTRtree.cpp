@@ -57,6 +57,12 @@ AbstractSTRtree::build()
 {
 	assert(!built);
 	root=(itemBoundables->empty()?createNode(0):createHigherLevels(itemBoundables,-1));
+
+	// Node bounds are otherwise computed on first use: computing
+	// the root ones (hence the ones of all nodes below it) now lets
+	// concurrent threads query the built tree without writes
+	root->getBounds();
+
 	built=true;
 }
 
@@ -330,10 +336,10 @@ AbstractSTRtree::boundablesAtLevel(int level, AbstractNode* top,
 			i!=e; ++i)
 	{
 		Boundable* boundable=*i;
-		if (typeid(*boundable)==typeid(AbstractNode))
+		// nodes are of a concrete subclass, so typeid won't match
+		if (AbstractNode* an=dynamic_cast<AbstractNode*>(boundable))
 		{
-			boundablesAtLevel(level, (AbstractNode*)boundable,
-				boundables);
+			boundablesAtLevel(level, an, boundables);
 		}
 		else
 		{
@@ -87,6 +87,20 @@ static bool yComparator(Boundable *a, Boundable *b)
                                            STRtree::centreY(bEnv));
 }
 
+static bool xComparator(Boundable *a, Boundable *b)
+{
+	assert(a);
+	assert(b);
+	const Envelope* aEnv = static_cast<const Envelope*>(a->getBounds());
+	const Envelope* bEnv = static_cast<const Envelope*>(b->getBounds());
+	assert(aEnv);
+	assert(bEnv);
+
+	// See yComparator for why compareDoubles is used
+	return AbstractSTRtree::compareDoubles(STRtree::centreX(aEnv),
+	                                       STRtree::centreX(bEnv));
+}
+
 /*public*/
 STRtree::STRtree(size_t nodeCapacity): AbstractSTRtree(nodeCapacity)
 { 
@@ -110,7 +124,13 @@ STRtree::createParentBoundables(BoundableList* childBoundables, int newLevel)
 	assert(!childBoundables->empty());
 	int minLeafCount=(int) ceil((double)childBoundables->size()/(double)getNodeCapacity());
 
-	std::auto_ptr<BoundableList> sortedChildBoundables ( sortBoundables(childBoundables) );
+	// Vertical slices are made of boundables sorted by x,
+	// each slice is then sorted by y (see sortBoundables) by
+	// createParentBoundablesFromVerticalSlice
+	std::auto_ptr<BoundableList> sortedChildBoundables (
+		new BoundableList(*childBoundables) );
+	sort(sortedChildBoundables->begin(), sortedChildBoundables->end(),
+	     xComparator);
 
 	std::auto_ptr< vector<BoundableList*> > verticalSlicesV (
 			verticalSlices(sortedChildBoundables.get(), (int)ceil(sqrt((double)minLeafCount)))
@@ -0,0 +1,496 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/linearref/IndexedLengthIndexedLine.h>
+#include <geos/linearref/ExtractLineByLocation.h>
+#include <geos/linearref/LengthLocationMap.h>
+#include <geos/linearref/LinearIterator.h>
+#include <geos/linearref/LinearLocation.h>
+#include <geos/linearref/LocationIndexOfLine.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/LineSegment.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/platform.h> // for FINITE
+
+#include <vector>
+#include <memory> // for auto_ptr
+#include <limits>
+#include <cmath> // for fabs
+
+using namespace std;
+
+using namespace geos::geom;
+
+namespace geos
+{
+namespace linearref   // geos.linearref
+{
+
+/*
+ * The segments of the line in an STRtree, to find the closest
+ * ones to a point.
+ */
+class IndexedLengthIndexedLine::SegmentIndex {
+
+public:
+
+	SegmentIndex(const Geometry* linearGeom)
+		:
+		lineEnv(*linearGeom->getEnvelopeInternal()),
+		initialRadius(0.0)
+	{
+		// Accumulate lengths as LengthIndexOfPoint does
+		double segmentStartMeasure = 0.0;
+		for (LinearIterator it(linearGeom); it.hasNext(); it.next())
+		{
+			if ( it.isEndOfLine() ) continue;
+			Item item;
+			item.seg.p0 = it.getSegmentStart();
+			item.seg.p1 = it.getSegmentEnd();
+			item.env.init(item.seg.p0, item.seg.p1);
+			item.start = segmentStartMeasure;
+			segmentStartMeasure += item.seg.getLength();
+			items.push_back(item);
+		}
+
+		// items won't move anymore
+		for (size_t i=0, n=items.size(); i<n; ++i)
+		{
+			tree.insert(&items[i].env, &items[i]);
+		}
+
+		// the mean segment length
+		if ( ! items.empty() ) {
+			initialRadius = segmentStartMeasure / items.size();
+		}
+	}
+
+	/*
+	 * See IndexedLengthIndexedLine::indexOfFromStart.
+	 *
+	 * Queries boxes of doubling size around pt until one holds
+	 * a segment with an index past minIndex, then queries the
+	 * box reaching the closest such segment, which holds all
+	 * segments at least as close.
+	 */
+	double indexOfFromStart(const Coordinate& pt, double minIndex)
+	{
+		if ( items.empty() || ! FINITE(pt.x) || ! FINITE(pt.y) )
+			return minIndex;
+
+		Envelope ptEnv(pt);
+		double radius = initialRadius + lineEnv.distance(&ptEnv);
+		if ( ! (radius > 0.0) ) radius = numeric_limits<double>::min();
+
+		for (;;)
+		{
+			Envelope box(pt.x - radius, pt.x + radius,
+			             pt.y - radius, pt.y + radius);
+			double minDistance, ptMeasure;
+			if ( findClosest(box, pt, minIndex, minDistance, ptMeasure) )
+			{
+				// allow for rounding of the box bounds
+				double reach = minDistance + 4 * numeric_limits<double>::epsilon() *
+				               ( minDistance + std::fabs(pt.x) + std::fabs(pt.y) );
+				if ( reach < radius ) return ptMeasure;
+
+				Envelope reachBox(pt.x - reach, pt.x + reach,
+				                  pt.y - reach, pt.y + reach);
+				findClosest(reachBox, pt, minIndex, minDistance, ptMeasure);
+				return ptMeasure;
+			}
+			if ( box.covers(&lineEnv) ) return minIndex;
+			radius *= 2;
+		}
+	}
+
+private:
+
+	struct Item {
+		LineSegment seg;
+		Envelope env;
+		double start;
+	};
+
+	vector<Item> items;
+
+	index::strtree::STRtree tree;
+
+	Envelope lineEnv;
+
+	double initialRadius;
+
+	vector<void*> candidates;
+
+	static double segmentNearestMeasure(const LineSegment& seg,
+	                                    const Coordinate& inputPt,
+	                                    double segmentStartMeasure)
+	{
+		double projFactor = seg.projectionFactor(inputPt);
+		if (projFactor <= 0.0)
+			return segmentStartMeasure;
+		if (projFactor <= 1.0)
+			return segmentStartMeasure + projFactor * seg.getLength();
+		return segmentStartMeasure + seg.getLength();
+	}
+
+	/*
+	 * Finds the closest segment to pt in box with an index past
+	 * minIndex, preferring the first one along the line.
+	 * Returns false if there is none.
+	 */
+	bool findClosest(const Envelope& box, const Coordinate& pt,
+	                 double minIndex, double& minDistance,
+	                 double& ptMeasure)
+	{
+		candidates.clear();
+		tree.query(&box, candidates);
+
+		const Item* closest = 0;
+		for (size_t i=0, n=candidates.size(); i<n; ++i)
+		{
+			const Item* item = static_cast<const Item*>(candidates[i]);
+			double segDistance = item->seg.distance(pt);
+			if ( closest && ( segDistance > minDistance ||
+			     ( segDistance == minDistance && item > closest ) ) )
+				continue;
+			double segMeasureToPt = segmentNearestMeasure(item->seg, pt,
+			                                              item->start);
+			if ( segMeasureToPt <= minIndex ) continue;
+			closest = item;
+			minDistance = segDistance;
+			ptMeasure = segMeasureToPt;
+		}
+		return closest != 0;
+	}
+
+	// Declare type as noncopyable
+	SegmentIndex(const SegmentIndex& other);
+	SegmentIndex& operator=(const SegmentIndex& rhs);
+};
+
+/* public */
+IndexedLengthIndexedLine::IndexedLengthIndexedLine(const Geometry* linearGeom)
+	:
+	linearGeom(linearGeom),
+	lineLength(linearGeom->getLength()),
+	totalLength(0.0)
+{
+	// Walk the line the way LengthLocationMap does, so that
+	// lengths are accumulated in the same order
+	for (LinearIterator it(linearGeom); it.hasNext(); it.next())
+	{
+		Position p;
+		p.start = totalLength;
+		p.componentIndex = it.getComponentIndex();
+		p.vertexIndex = it.getVertexIndex();
+		if ( it.isEndOfLine() ) {
+			p.length = -1.0;
+		}
+		else {
+			Coordinate p0 = it.getSegmentStart();
+			Coordinate p1 = it.getSegmentEnd();
+			p.length = p1.distance(p0);
+			totalLength += p.length;
+		}
+		positions.push_back(p);
+	}
+}
+
+/* public */
+IndexedLengthIndexedLine::~IndexedLengthIndexedLine()
+{
+}
+
+/* private */
+size_t
+IndexedLengthIndexedLine::findPosition(double length, size_t from) const
+{
+	for (size_t i=from, n=positions.size(); i<n; ++i)
+	{
+		const Position& p = positions[i];
+		/*
+		 * As in LengthLocationMap, a length referencing exactly
+		 * a component endpoint resolves to that endpoint rather
+		 * than to the start of the next component.
+		 */
+		if ( p.isEndOfLine() ) {
+			if ( p.start == length ) return i;
+		}
+		else if ( p.start + p.length > length ) {
+			return i;
+		}
+	}
+	return positions.size();
+}
+
+/* private */
+LinearLocation
+IndexedLengthIndexedLine::locationAt(size_t pos, double length) const
+{
+	// length is longer than line - return end location
+	if ( pos == positions.size() )
+		return LinearLocation::getEndLocation(linearGeom);
+
+	const Position& p = positions[pos];
+	if ( p.isEndOfLine() )
+		return LinearLocation(p.componentIndex, p.vertexIndex, 0.0);
+
+	double frac = (length - p.start) / p.length;
+	return LinearLocation(p.componentIndex, p.vertexIndex, frac);
+}
+
+/* private */
+LinearLocation
+IndexedLengthIndexedLine::locationOfForward(double length) const
+{
+	if (length <= 0.0)
+		return LinearLocation();
+
+	// skip the positions whose key is below length,
+	// none of which can match
+	size_t from = 0;
+	size_t count = positions.size();
+	while ( count > 0 )
+	{
+		size_t step = count / 2;
+		if ( positions[from + step].key() < length ) {
+			from += step + 1;
+			count -= step + 1;
+		}
+		else {
+			count = step;
+		}
+	}
+
+	return locationAt(findPosition(length, from), length);
+}
+
+/* public */
+LinearLocation
+IndexedLengthIndexedLine::locationOf(double index) const
+{
+	double forwardLength = index;
+	if (index < 0.0) forwardLength = lineLength + index;
+	return locationOfForward(forwardLength);
+}
+
+/* public */
+LinearLocation
+IndexedLengthIndexedLine::locationOf(double index, bool resolveLower) const
+{
+	LinearLocation loc = locationOf(index);
+	if (resolveLower) return loc;
+	return LengthLocationMap::resolveHigher(linearGeom, loc);
+}
+
+/* public */
+Coordinate
+IndexedLengthIndexedLine::extractPoint(double index) const
+{
+	return locationOf(index).getCoordinate(linearGeom);
+}
+
+/* public */
+Coordinate
+IndexedLengthIndexedLine::extractPoint(double index,
+		double offsetDistance) const
+{
+	LinearLocation loc = locationOf(index);
+	Coordinate ret;
+	loc.getSegment(linearGeom)->pointAlongOffset(loc.getSegmentFraction(),
+			offsetDistance, ret);
+	return ret;
+}
+
+/* public */
+void
+IndexedLengthIndexedLine::extractPoints(const vector<double>& indices,
+		vector<Coordinate>& result) const
+{
+	result.reserve(result.size() + indices.size());
+
+	// Position found for the last length, and that length.
+	// Any greater length is found at or after that position.
+	size_t cursor = 0;
+	double lastLength = 0.0;
+
+	for (size_t i=0, n=indices.size(); i<n; ++i)
+	{
+		double length = indices[i];
+		if (length < 0.0) length = lineLength + length;
+
+		if ( ! (length > 0.0) || length < lastLength ) {
+			// out of sequence, locate it on its own
+			result.push_back(locationOfForward(length).getCoordinate(linearGeom));
+			continue;
+		}
+
+		cursor = findPosition(length, cursor);
+		lastLength = length;
+		result.push_back(locationAt(cursor, length).getCoordinate(linearGeom));
+	}
+}
+
+/* public */
+Geometry *
+IndexedLengthIndexedLine::extractLine(double startIndex, double endIndex) const
+{
+	const double startIndex2 = clampIndex(startIndex);
+	const double endIndex2 = clampIndex(endIndex);
+	// if extracted line is zero-length, resolve start lower as well to
+	// ensure they are equal
+	const bool resolveStartLower = ( startIndex2 == endIndex2 );
+	const LinearLocation startLoc = locationOf(startIndex2, resolveStartLower);
+	const LinearLocation endLoc = locationOf(endIndex2);
+	return ExtractLineByLocation::extract(linearGeom, startLoc, endLoc);
+}
+
+/* public */
+double
+IndexedLengthIndexedLine::indexOf(const LinearLocation& loc) const
+{
+	// positions are ordered by component, then vertex
+	size_t lo = 0;
+	size_t count = positions.size();
+	while ( count > 0 )
+	{
+		size_t step = count / 2;
+		const Position& p = positions[lo + step];
+		if ( p.componentIndex < loc.getComponentIndex() ||
+		     ( p.componentIndex == loc.getComponentIndex() &&
+		       p.vertexIndex < loc.getSegmentIndex() ) )
+		{
+			lo += step + 1;
+			count -= step + 1;
+		}
+		else {
+			count = step;
+		}
+	}
+
+	if ( lo < positions.size() )
+	{
+		const Position& p = positions[lo];
+		if ( ! p.isEndOfLine() &&
+		     p.componentIndex == loc.getComponentIndex() &&
+		     p.vertexIndex == loc.getSegmentIndex() )
+		{
+			return p.start + p.length * loc.getSegmentFraction();
+		}
+	}
+	return totalLength;
+}
+
+/* private */
+double
+IndexedLengthIndexedLine::indexOfFromStart(const Coordinate& pt,
+		double minIndex) const
+{
+	if ( ! segmentIndex.get() )
+		segmentIndex.reset(new SegmentIndex(linearGeom));
+	return segmentIndex->indexOfFromStart(pt, minIndex);
+}
+
+/* public */
+double
+IndexedLengthIndexedLine::project(const Coordinate& pt) const
+{
+	return indexOfFromStart(pt, -1.0);
+}
+
+/* public */
+double
+IndexedLengthIndexedLine::indexOf(const Coordinate& pt) const
+{
+	return indexOfFromStart(pt, -1.0);
+}
+
+/* public */
+double
+IndexedLengthIndexedLine::indexOfAfter(const Coordinate& pt,
+		double minIndex) const
+{
+	if (minIndex < 0.0) return indexOf(pt);
+
+	// sanity check for minIndex at or past end of line
+	if (lineLength < minIndex)
+		return lineLength;
+
+	double closestAfter = indexOfFromStart(pt, minIndex);
+	if (closestAfter <= minIndex)
+	{
+		throw util::IllegalArgumentException("computed index is before specified minimum index");
+	}
+	return closestAfter;
+}
+
+/* public */
+double*
+IndexedLengthIndexedLine::indicesOf(const Geometry* subLine) const
+{
+	LinearLocation* locIndex = LocationIndexOfLine::indicesOf(linearGeom, subLine);
+	double* index = new double[2];
+	index[0] = indexOf(locIndex[0]);
+	index[1] = indexOf(locIndex[1]);
+	delete [] locIndex;
+	return index;
+}
+
+/* public */
+double
+IndexedLengthIndexedLine::getStartIndex() const
+{
+	return 0.0;
+}
+
+/* public */
+double
+IndexedLengthIndexedLine::getEndIndex() const
+{
+	return lineLength;
+}
+
+/* public */
+bool
+IndexedLengthIndexedLine::isValidIndex(double index) const
+{
+	return (index >= getStartIndex()
+		&& index <= getEndIndex());
+}
+
+/* public */
+double
+IndexedLengthIndexedLine::clampIndex(double index) const
+{
+	double posIndex = positiveIndex(index);
+	double startIndex = getStartIndex();
+	if (posIndex < startIndex) return startIndex;
+
+	double endIndex = getEndIndex();
+	if (posIndex > endIndex) return endIndex;
+
+	return posIndex;
+}
+
+/* private */
+double
+IndexedLengthIndexedLine::positiveIndex(double index) const
+{
+	if (index >= 0.0) return index;
+	return lineLength + index;
+}
+
+} // geos.linearref
+} // geos
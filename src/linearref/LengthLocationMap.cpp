@@ -126,6 +126,14 @@ LengthLocationMap::getLocationForward(double length) const
 /* private */
 LinearLocation
 LengthLocationMap::resolveHigher(const LinearLocation& loc) const
+{
+  return resolveHigher(linearGeom, loc);
+}
+
+/* public static */
+LinearLocation
+LengthLocationMap::resolveHigher(const Geometry* linearGeom,
+                                 const LinearLocation& loc)
 {
   if (! loc.isEndpoint(*linearGeom)) return loc;
 
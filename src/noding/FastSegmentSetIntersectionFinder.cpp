@@ -39,25 +39,26 @@ namespace noding { // geos::noding
  */
 FastSegmentSetIntersectionFinder::
 FastSegmentSetIntersectionFinder( noding::SegmentString::ConstVect * baseSegStrings)
-:	segSetMutInt( new MCIndexSegmentSetMutualIntersector()),
-	lineIntersector( new LineIntersector())
+:	segSetMutInt( new MCIndexSegmentSetMutualIntersector())
 {
 	segSetMutInt->setBaseSegments( baseSegStrings);
+	segSetMutInt->buildIndex();
 }
 
 FastSegmentSetIntersectionFinder::
 ~FastSegmentSetIntersectionFinder()
 {
-	delete lineIntersector;
 	delete segSetMutInt;
 }
 
 
 bool 
 FastSegmentSetIntersectionFinder::
-intersects( noding::SegmentString::ConstVect * segStrings)
+intersects( noding::SegmentString::ConstVect * segStrings) const
 {
-	SegmentIntersectionDetector intFinder( lineIntersector);
+	// LineIntersector keeps the state of the last computation
+	LineIntersector li;
+	SegmentIntersectionDetector intFinder( &li);
 
 	return this->intersects( segStrings, &intFinder);
 }
@@ -65,10 +66,9 @@ intersects( noding::SegmentString::ConstVect * segStrings)
 bool 
 FastSegmentSetIntersectionFinder::
 intersects( noding::SegmentString::ConstVect * segStrings, 
-			SegmentIntersectionDetector * intDetector)
+			SegmentIntersectionDetector * intDetector) const
 {
-	segSetMutInt->setSegmentIntersector( intDetector);
-	segSetMutInt->process( segStrings);
+	segSetMutInt->process( segStrings, *intDetector);
 
 	return intDetector->hasIntersection();
 }
@@ -21,6 +21,8 @@
 #include <geos/noding/NodedSegmentString.h>
 #include <geos/index/chain/MonotoneChain.h> 
 #include <geos/index/chain/MonotoneChainBuilder.h> 
+#include <geos/index/ItemVisitor.h> 
+#include <geos/util/IllegalArgumentException.h>
 
 #include <cassert>
 #include <functional>
@@ -47,6 +49,14 @@ MCIndexNoder::computeNodes(SegmentString::NonConstVect* inputSegStrings)
 	nodedSegStrings = inputSegStrings;
 	assert(nodedSegStrings);
 
+	if ( partitionRunner )
+	{
+		partitionOverlaps(inputSegStrings, maxPartitionSize);
+		partitionRunner->runPartitions(*this);
+		mergePartitionOverlaps();
+		return;
+	}
+
 	for_each(nodedSegStrings->begin(), nodedSegStrings->end(),
 			bind1st(mem_fun(&MCIndexNoder::add), this));
 
@@ -54,6 +64,70 @@ MCIndexNoder::computeNodes(SegmentString::NonConstVect* inputSegStrings)
 //cerr<<"MCIndexNoder: # chain overlaps = "<<nOverlaps<<endl;
 }
 
+/*public*/
+void
+MCIndexNoder::setPartitionRunner(PartitionRunner* runner, size_t maxChains)
+{
+	if ( runner && maxChains == 0 )
+		throw util::IllegalArgumentException(
+			"Partition size must be positive");
+
+	partitionRunner = runner;
+	maxPartitionSize = maxChains;
+}
+
+namespace {
+
+/*
+ * Computes the overlaps of a query chain with every chain visited,
+ * skipping chains with a lower or equal id so that each pair of
+ * chains is compared only once and no chain is compared to itself.
+ *
+ * Without a SegmentIntersector the search never stops early.
+ */
+class ChainOverlapVisitor : public index::ItemVisitor
+{
+private:
+	MonotoneChain* queryChain;
+	MonotoneChainOverlapAction& overlapAction;
+	SegmentIntersector* segInt;
+	int nOverlaps;
+
+	// Declare type as noncopyable
+	ChainOverlapVisitor(const ChainOverlapVisitor& other);
+	ChainOverlapVisitor& operator=(const ChainOverlapVisitor& rhs);
+
+public:
+	ChainOverlapVisitor(MonotoneChainOverlapAction& nOverlapAction,
+	                    SegmentIntersector* nSegInt)
+		:
+		queryChain(0),
+		overlapAction(nOverlapAction),
+		segInt(nSegInt),
+		nOverlaps(0)
+	{}
+
+	void setQueryChain(MonotoneChain* mc) { queryChain = mc; }
+
+	int getOverlaps() const { return nOverlaps; }
+
+	void visitItem(void* item)
+	{
+		MonotoneChain* testChain = static_cast<MonotoneChain*>(item);
+		assert(testChain);
+
+		if (testChain->getId() <= queryChain->getId()) return;
+
+		// the index has no way to stop a query early
+		if (segInt && segInt->isDone()) return;
+
+		queryChain->computeOverlaps(testChain, &overlapAction);
+		nOverlaps++;
+	}
+};
+
+} // anonymous namespace
+
 /*private*/
 void
 MCIndexNoder::intersectChains()
@@ -61,40 +135,137 @@ MCIndexNoder::intersectChains()
 	assert(segInt);
 
 	SegmentOverlapAction overlapAction(*segInt);
+	ChainOverlapVisitor visitor(overlapAction, segInt);
 
 	for (vector<MonotoneChain*>::iterator
 			i=monoChains.begin(), iEnd=monoChains.end();
 			i != iEnd;
 			++i)
 	{
-
 		MonotoneChain* queryChain = *i;
 		assert(queryChain);
-		vector<void*> overlapChains;
-		index.query(&(queryChain->getEnvelope()), overlapChains);
-		for (vector<void*>::iterator
-			j=overlapChains.begin(), jEnd=overlapChains.end();
-			j != jEnd;
-			++j)
-		{
-			MonotoneChain* testChain = static_cast<MonotoneChain*>(*j);
-			assert(testChain);
-
-			/**
-			 * following test makes sure we only compare each
-			 * pair of chains once and that we don't compare a
-			 * chain to itself
-			 */
-			if (testChain->getId() > queryChain->getId()) {
-				queryChain->computeOverlaps(testChain,
-						&overlapAction);
-				nOverlaps++;
-			}
 
+		// The visitor computes the overlaps while the tree is
+		// traversed, rather than first collecting every
+		// candidate chain into a temporary vector.
+		visitor.setQueryChain(queryChain);
+		index.query(&(queryChain->getEnvelope()), visitor);
+
+		// short-circuit if possible
+		if (segInt->isDone()) break;
+	}
+
+	nOverlaps += visitor.getOverlaps();
+}
+
+/*
+ * Records the overlapping segments of two chains, to be passed
+ * to the SegmentIntersector later on.
+ */
+class MCIndexNoder::SegmentPairCollector
+	: public MonotoneChainOverlapAction
+{
+private:
+	vector<SegmentPair>& pairs;
+
+	// Declare type as noncopyable
+	SegmentPairCollector(const SegmentPairCollector& other);
+	SegmentPairCollector& operator=(const SegmentPairCollector& rhs);
+
+public:
+	SegmentPairCollector(vector<SegmentPair>& nPairs)
+		:
+		MonotoneChainOverlapAction(),
+		pairs(nPairs)
+	{}
+
+	void overlap(MonotoneChain& mc1, size_t start1,
+			MonotoneChain& mc2, size_t start2)
+	{
+		SegmentPair pair;
+		pair.ss1 = const_cast<SegmentString*>(
+			static_cast<const SegmentString *>(mc1.getContext()));
+		pair.start1 = start1;
+		pair.ss2 = const_cast<SegmentString*>(
+			static_cast<const SegmentString *>(mc2.getContext()));
+		pair.start2 = start2;
+		pairs.push_back(pair);
+	}
+};
+
+/*public*/
+void
+MCIndexNoder::partitionOverlaps(SegmentString::NonConstVect* inputSegStrings,
+		size_t maxChains)
+{
+	if ( maxChains == 0 )
+		throw util::IllegalArgumentException(
+			"Partition size must be positive");
+
+	nodedSegStrings = inputSegStrings;
+	assert(nodedSegStrings);
+
+	for_each(nodedSegStrings->begin(), nodedSegStrings->end(),
+			bind1st(mem_fun(&MCIndexNoder::add), this));
+
+	// Build now: the partitions must only read the tree
+	index.build();
+
+	partitionSize = maxChains;
+	size_t n = (monoChains.size() + maxChains - 1) / maxChains;
+	partitionPairs.assign(n, vector<SegmentPair>());
+	partitionOverlapCounts.assign(n, 0);
+}
+
+/*public*/
+void
+MCIndexNoder::computePartitionOverlaps(size_t i)
+{
+	assert(i < partitionPairs.size());
+
+	vector<SegmentPair>& pairs = partitionPairs[i];
+	pairs.clear();
+
+	SegmentPairCollector collector(pairs);
+	ChainOverlapVisitor visitor(collector, NULL);
+
+	size_t from = i * partitionSize;
+	size_t to = (std::min)(from + partitionSize, monoChains.size());
+	for (size_t j = from; j < to; ++j)
+	{
+		MonotoneChain* queryChain = monoChains[j];
+		assert(queryChain);
+
+		visitor.setQueryChain(queryChain);
+		index.query(&(queryChain->getEnvelope()), visitor);
+	}
+
+	partitionOverlapCounts[i] = visitor.getOverlaps();
+}
+
+/*public*/
+void
+MCIndexNoder::mergePartitionOverlaps()
+{
+	assert(segInt);
+
+	for (size_t i = 0, n = partitionPairs.size(); i < n; ++i)
+	{
+		nOverlaps += partitionOverlapCounts[i];
+
+		vector<SegmentPair>& pairs = partitionPairs[i];
+		for (size_t j = 0, m = pairs.size(); j < m; ++j)
+		{
 			// short-circuit if possible
-			if (segInt->isDone()) return;
+			if (segInt->isDone()) break;
 
+			const SegmentPair& p = pairs[j];
+			segInt->processIntersections(p.ss1, p.start1,
+			                             p.ss2, p.start2);
 		}
+
+		// release the memory as soon as possible
+		vector<SegmentPair>().swap(pairs);
 	}
 }
 
@@ -158,6 +158,52 @@ MCIndexSegmentSetMutualIntersector::process(SegmentString::ConstVect * segString
 }
 
 
+/*public*/
+void 
+MCIndexSegmentSetMutualIntersector::process(
+	SegmentString::ConstVect * segStrings, SegmentIntersector& segInt) const
+{
+    MonoChains testChains;
+    for (SegmentString::ConstVect::size_type i = 0, n = segStrings->size(); i < n; i++)
+    {
+        SegmentString * seg = (SegmentString *)((*segStrings)[i]);
+        MonotoneChainBuilder::getChains(seg->getCoordinates(), seg, testChains);
+    }
+
+    MCIndexSegmentSetMutualIntersector::SegmentOverlapAction overlapAction( segInt);
+
+    std::vector<void*> overlapChains;
+    for (MonoChains::size_type i = 0, ni = testChains.size(); i < ni; ++i)
+    {
+        MonotoneChain * queryChain = testChains[i];
+
+        overlapChains.clear();
+        index->query( &(queryChain->getEnvelope()), overlapChains);
+
+        for (std::size_t j = 0, nj = overlapChains.size(); j < nj; j++)
+        {
+            MonotoneChain * testChain = (MonotoneChain *)(overlapChains[j]);
+
+            queryChain->computeOverlaps( testChain, &overlapAction);
+            if (segInt.isDone()) break;
+        }
+        if (segInt.isDone()) break;
+    }
+
+    for (MonoChains::iterator i = testChains.begin(), e = testChains.end();
+         i != e; i++)
+    {
+      delete *i;
+    }
+}
+
+/*public*/
+void 
+MCIndexSegmentSetMutualIntersector::buildIndex()
+{
+    static_cast<geos::index::strtree::STRtree*>(index)->build();
+}
+
 /* public */
 void 
 MCIndexSegmentSetMutualIntersector::SegmentOverlapAction::overlap(
@@ -23,21 +23,62 @@
 #include <geos/noding/NodingValidator.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/index/kdtree/KdTree.h>
+#include <geos/index/kdtree/KdNode.h>
 
 #include <geos/inline.h>
 
 #include <functional> // std::mem_fun, std::bind1st
-#include <algorithm> // std::for_each 
+#include <algorithm> // std::for_each, std::swap
+#include <set>
 #include <vector>
 
 
 using namespace std;
 using namespace geos::geom;
+using geos::index::kdtree::KdTree;
+using geos::index::kdtree::KdNode;
 
 namespace geos {
 namespace noding { // geos.noding
 namespace snapround { // geos.noding.snapround
 
+namespace {
+
+/*
+ * Inserts the given points into an exact KdTree, setting nodes[i]
+ * to the node holding pts[i].
+ *
+ * Points coming from linework are spatially coherent, which would
+ * make the tree degenerate into a list: inserting them in a
+ * (deterministic) pseudo-random order keeps it balanced.
+ */
+void
+insertShuffled(KdTree& tree, const vector<const Coordinate*>& pts,
+		vector<KdNode*>& nodes)
+{
+	size_t n = pts.size();
+	vector<size_t> order(n);
+	for (size_t i=0; i<n; ++i) order[i] = i;
+
+	// Fisher-Yates shuffle driven by a 32 bit LCG
+	unsigned long seed = 1;
+	for (size_t i=n; i>1; --i)
+	{
+		seed = (seed * 1664525UL + 1013904223UL) & 0xffffffffUL;
+		swap(order[i-1], order[seed % i]);
+	}
+
+	nodes.resize(n);
+	for (size_t i=0; i<n; ++i)
+	{
+		size_t k = order[i];
+		nodes[k] = tree.insert(*pts[k]);
+	}
+}
+
+} // anonymous namespace
+
 /*private*/
 void
 MCIndexSnapRounder::findInteriorIntersections(MCIndexNoder& noder,
@@ -53,30 +94,43 @@ MCIndexSnapRounder::findInteriorIntersections(MCIndexNoder& noder,
 void
 MCIndexSnapRounder::computeIntersectionSnaps(vector<Coordinate>& snapPts)
 {
+	// The same intersection point is usually found more than once
+	// (e.g. where several segments cross). Snapping a hot pixel
+	// only depends on its location, so each distinct point is
+	// snapped once.
+	vector<const Coordinate*> pts;
+	pts.reserve(snapPts.size());
 	for (vector<Coordinate>::iterator
 			it=snapPts.begin(), itEnd=snapPts.end();
 			it!=itEnd;
 			++it)
 	{
-		Coordinate& snapPt = *it;
-		HotPixel hotPixel(snapPt, scaleFactor, li);
+		pts.push_back(&(*it));
+	}
+
+	KdTree snapTree;
+	vector<KdNode*> nodes;
+	insertShuffled(snapTree, pts, nodes);
+
+	set<KdNode*> snapped;
+	for (size_t i=0, n=pts.size(); i<n; ++i)
+	{
+		if ( ! snapped.insert(nodes[i]).second ) continue;
+		HotPixel hotPixel(*pts[i], scaleFactor, li);
 		pointSnapper->snap(hotPixel);
 	}
 }
 
 /*private*/
 void
-MCIndexSnapRounder::computeVertexSnaps(NodedSegmentString* e)
+MCIndexSnapRounder::computeVertexSnaps(NodedSegmentString* e, unsigned int i)
 {
-	CoordinateSequence& pts0 = *(e->getCoordinates());
-	for (unsigned int i=0, n=pts0.size()-1; i<n; ++i)
-	{
-		HotPixel hotPixel(pts0[i], scaleFactor, li);
-		bool isNodeAdded = pointSnapper->snap(hotPixel, e, i);
-		// if a node is created for a vertex, that vertex must be noded too
-		if (isNodeAdded) {
-			e->addIntersection(pts0[i], i);
-		}
+	const Coordinate& pt = e->getCoordinate(i);
+	HotPixel hotPixel(pt, scaleFactor, li);
+	bool isNodeAdded = pointSnapper->snap(hotPixel, e, i);
+	// if a node is created for a vertex, that vertex must be noded too
+	if (isNodeAdded) {
+		e->addIntersection(pt, i);
 	}
 }
 
@@ -84,13 +138,55 @@ MCIndexSnapRounder::computeVertexSnaps(NodedSegmentString* e)
 void
 MCIndexSnapRounder::computeVertexSnaps(SegmentString::NonConstVect& edges)
 {
-	SegmentString::NonConstVect::iterator i=edges.begin(), e=edges.end();
-	for (; i!=e; ++i)
+	// Collect all vertices (but the last one of each edge),
+	// remembering where they come from
+	vector<const Coordinate*> pts;
+	vector<NodedSegmentString*> ptEdges;
+	vector<unsigned int> ptIndexes;
+
+	SegmentString::NonConstVect::iterator it=edges.begin(), e=edges.end();
+	for (; it!=e; ++it)
 	{
 		NodedSegmentString* edge0 =
-			dynamic_cast<NodedSegmentString*>(*i);
+			dynamic_cast<NodedSegmentString*>(*it);
 		assert(edge0);
-		computeVertexSnaps(edge0);
+		CoordinateSequence& pts0 = *(edge0->getCoordinates());
+		for (unsigned int i=0, n=pts0.size()-1; i<n; ++i)
+		{
+			pts.push_back(&pts0[i]);
+			ptEdges.push_back(edge0);
+			ptIndexes.push_back(i);
+		}
+	}
+
+	// Group coincident vertices, shared by adjacent edges
+	KdTree vertexTree;
+	vector<KdNode*> nodes;
+	insertShuffled(vertexTree, pts, nodes);
+
+	set<KdNode*> snapped;
+	for (size_t k=0, n=pts.size(); k<n; ++k)
+	{
+		NodedSegmentString* edge0 = ptEdges[k];
+		unsigned int i = ptIndexes[k];
+
+		if ( ! nodes[k]->isRepeated() )
+		{
+			computeVertexSnaps(edge0, i);
+			continue;
+		}
+
+		// A vertex shared by several edges: snapping its hot pixel
+		// excluding the segment starting at one occurrence would
+		// still node that segment while snapping any other
+		// occurrence, so snap the whole pixel once and node all
+		// occurrences.
+		if ( snapped.insert(nodes[k]).second )
+		{
+			HotPixel hotPixel(*pts[k], scaleFactor, li);
+			pointSnapper->snap(hotPixel);
+		}
+		edge0->addIntersection(*pts[k], i);
 	}
 }
 
@@ -112,6 +208,7 @@ MCIndexSnapRounder::computeNodes(SegmentString::NonConstVect* inputSegmentString
 {
 	nodedSegStrings = inputSegmentStrings;
 	MCIndexNoder noder;
+	noder.setPartitionRunner(partitionRunner, maxPartitionSize);
 	pointSnapper.release(); // let it leak
 	pointSnapper.reset(new MCIndexPointSnapper(noder.getIndex()));
 	snapRound(noder, inputSegmentStrings);
@@ -29,6 +29,7 @@
 #include <geos/operation/buffer/BufferBuilder.h>
 #include <geos/operation/buffer/OffsetCurveBuilder.h>
 #include <geos/operation/buffer/OffsetCurveSetBuilder.h>
+#include <geos/operation/buffer/FilletTemplateCache.h>
 #include <geos/operation/buffer/BufferSubgraph.h>
 #include <geos/operation/buffer/SubgraphDepthLocater.h>
 #include <geos/operation/overlay/OverlayOp.h>
@@ -37,6 +38,11 @@
 #include <geos/operation/overlay/OverlayNodeFactory.h> 
 #include <geos/operation/linemerge/LineMerger.h>
 #include <geos/algorithm/LineIntersector.h>
+#include <geos/algorithm/CGAlgorithms.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
 #include <geos/noding/IntersectionAdder.h>
 #include <geos/noding/SegmentString.h>
 #include <geos/noding/MCIndexNoder.h>
@@ -52,6 +58,7 @@
 #include <geos/profiler.h>
 
 #include <cassert>
+#include <cmath>
 #include <vector>
 #include <iomanip>
 #include <algorithm>
@@ -93,6 +100,140 @@ convertSegStrings(const GeometryFactory* fact, Iterator it, Iterator et)
   return std::auto_ptr<Geometry>(fact->buildGeometry(lines));
 }
 
+// Removes the end points of a single sided curve lying closer than
+// ptDistAllowance to the ends of the buffered line, as long as
+// they come from segments shorter than segLengthAllowance
+void
+trimLineEnds(CoordinateSequence& coords, const Coordinate& startPoint,
+             const Coordinate& endPoint, double ptDistAllowance,
+             double segLengthAllowance)
+{
+  // Clean up the front of the list.
+  // Loop until the line's end is not inside the buffer width from
+  // the startPoint.
+  while ( coords.size() > 1 && 
+          coords.front().distance( startPoint ) < ptDistAllowance )
+  {
+    // Record the end segment length.
+    double segLength = coords.front().distance( coords[1] );
+    // Stop looping if there are no more points, or if the segment
+    // length is larger than the buffer width.
+    if ( coords.size() <= 1 || segLength > segLengthAllowance )
+    {
+      break;
+    }
+    // If the first point is less than buffer width away from the
+    // reference point, then delete the point.
+    coords.deleteAt( 0 );
+  }
+  while ( coords.size() > 1 && 
+          coords.front().distance( endPoint ) < ptDistAllowance )
+  {
+    double segLength = coords.front().distance( coords[1] );
+    if ( coords.size() <= 1 || segLength > segLengthAllowance )
+    {
+      break;
+    }
+    coords.deleteAt( 0 );
+  }
+
+  // Clean up the back of the list.
+  while ( coords.size() > 1 &&
+          coords.back().distance( startPoint ) < ptDistAllowance )
+  {
+    double segLength = coords.back().distance(
+      coords[coords.size()-2] );
+    if ( coords.size() <= 1 || segLength > segLengthAllowance )
+    {
+      break;
+    }
+    coords.deleteAt( coords.size()-1 );
+  }
+  while ( coords.size() > 1 &&
+          coords.back().distance( endPoint ) < ptDistAllowance )
+  {
+    double segLength = coords.back().distance(
+      coords[coords.size()-2] );
+    if ( coords.size() <= 1 || segLength > segLengthAllowance )
+    {
+      break;
+    }
+     coords.deleteAt( coords.size()-1 );
+  }
+}
+
+// Answers "is a point closer than a given distance to a line ?"
+// looking only at the line segments near the point.
+// Points beyond the line endpoints are only measured against
+// the end segments' perpendicular band, as for a flat-capped buffer.
+class SegmentDistanceIndex {
+
+public:
+
+  SegmentDistanceIndex(const CoordinateSequence& nPts)
+    :
+    pts(nPts)
+  {
+    std::size_t n = pts.size();
+    if ( n < 2 ) return;
+    // the tree keeps pointers to the envelopes
+    envs.reserve(n-1);
+    for (std::size_t i=0; i<n-1; ++i)
+      envs.push_back(Envelope(pts[i], pts[i+1]));
+    for (std::size_t i=0; i<n-1; ++i)
+      tree.insert(&envs[i], &envs[i]);
+  }
+
+  bool isWithinDistance(const Coordinate& p, double distance)
+  {
+    if ( envs.empty() ) return false;
+
+    std::size_t lastSeg = envs.size() - 1;
+    Envelope queryEnv(p.x - distance, p.x + distance,
+                      p.y - distance, p.y + distance);
+    std::vector<void*> hits;
+    tree.query(&queryEnv, hits);
+    for (std::size_t i=0, n=hits.size(); i<n; ++i)
+    {
+      std::size_t segIdx = static_cast<Envelope*>(hits[i]) - &envs[0];
+      const Coordinate& p0 = pts[segIdx];
+      const Coordinate& p1 = pts[segIdx+1];
+      if ( segIdx == 0 || segIdx == lastSeg )
+      {
+        double dx = p1.x - p0.x;
+        double dy = p1.y - p0.y;
+        double r = (p.x - p0.x) * dx + (p.y - p0.y) * dy;
+        if ( segIdx == 0 && r < 0 ) continue;
+        if ( segIdx == lastSeg && r > dx * dx + dy * dy ) continue;
+      }
+      double d = CGAlgorithms::distancePointLine(p, p0, p1);
+      if ( d < distance ) return true;
+    }
+    return false;
+  }
+
+private:
+
+  const CoordinateSequence& pts;
+
+  std::vector<Envelope> envs;
+
+  geos::index::strtree::STRtree tree;
+
+  // Declare type as noncopyable
+  SegmentDistanceIndex(const SegmentDistanceIndex& other);
+  SegmentDistanceIndex& operator=(const SegmentDistanceIndex& rhs);
+};
+
+// Drops the segment OffsetSegmentString::closeRing adds from the
+// last point of a single sided curve back to its first point
+void
+removeClosingSegment(CoordinateSequence& pts)
+{
+  std::size_t n = pts.size();
+  if ( n > 2 && pts[0].equals2D(pts[n-1]) ) pts.deleteAt(n-1);
+}
+
 }
 
 namespace geos {
@@ -157,6 +298,7 @@ BufferBuilder::bufferLineSingleSided( const Geometry* g, double distance,
    // style to FLAT for single-sided buffering
    {
       BufferBuilder tmp(modParams);
+      tmp.setFilletTemplateCache(templateCache);
       buf = tmp.buffer( l, distance );
    }
 
@@ -169,7 +311,7 @@ BufferBuilder::bufferLineSingleSided( const Geometry* g, double distance,
 #endif
 
    // Then, get the raw (i.e. unnoded) single sided offset curve.
-   OffsetCurveBuilder curveBuilder( precisionModel, modParams );
+   OffsetCurveBuilder curveBuilder( precisionModel, modParams, templateCache );
    std::vector< CoordinateSequence* > lineList;
 
    std::auto_ptr< CoordinateSequence > coords ( g->getCoordinates() );
@@ -270,58 +412,8 @@ BufferBuilder::bufferLineSingleSided( const Geometry* g, double distance,
          // epsilon is removed.
          const double segLengthAllowance = 1.02 * distance;
 
-         // Clean up the front of the list.
-         // Loop until the line's end is not inside the buffer width from
-         // the startPoint.
-         while ( coords->size() > 1 && 
-                 coords->front().distance( startPoint ) < ptDistAllowance )
-         {
-            // Record the end segment length.
-            double segLength = coords->front().distance( ( *coords )[1] );
-            // Stop looping if there are no more points, or if the segment
-            // length is larger than the buffer width.
-            if ( coords->size() <= 1 || segLength > segLengthAllowance )
-            {
-               break;
-            }
-            // If the first point is less than buffer width away from the
-            // reference point, then delete the point.
-            coords->deleteAt( 0 );
-         }
-         while ( coords->size() > 1 && 
-                 coords->front().distance( endPoint ) < ptDistAllowance )
-         {
-            double segLength = coords->front().distance( ( *coords )[1] );
-            if ( coords->size() <= 1 || segLength > segLengthAllowance )
-            {
-               break;
-            }
-            coords->deleteAt( 0 );
-         }
-
-         // Clean up the back of the list.
-         while ( coords->size() > 1 &&
-                 coords->back().distance( startPoint ) < ptDistAllowance )
-         {
-            double segLength = coords->back().distance(
-               ( *coords )[coords->size()-2] );
-            if ( coords->size() <= 1 || segLength > segLengthAllowance )
-            {
-               break;
-            }
-            coords->deleteAt( coords->size()-1 );
-         }
-         while ( coords->size() > 1 &&
-                 coords->back().distance( endPoint ) < ptDistAllowance )
-         {
-            double segLength = coords->back().distance(
-               ( *coords )[coords->size()-2] );
-            if ( coords->size() <= 1 || segLength > segLengthAllowance )
-            {
-               break;
-            }
-            coords->deleteAt( coords->size()-1 );
-         }
+         trimLineEnds( *coords, startPoint, endPoint,
+                       ptDistAllowance, segLengthAllowance );
 
          // Add the coordinates to the resultant line string.
          if ( coords->size() > 1 )
@@ -359,6 +451,200 @@ BufferBuilder::bufferLineSingleSided( const Geometry* g, double distance,
    }
 }
 
+/*public*/
+Geometry*
+BufferBuilder::offsetCurve( const Geometry* g, double distance,
+                            bool leftSide )
+{
+   const LineString* l = dynamic_cast< const LineString* >( g );
+   if ( !l ) throw util::IllegalArgumentException("BufferBuilder::offsetCurve only accept linestrings");
+
+   // Nothing to do for a distance of zero
+   if ( distance == 0 ) return g->clone();
+
+   const PrecisionModel* precisionModel = workingPrecisionModel;
+   if ( !precisionModel ) precisionModel = l->getPrecisionModel();
+
+   assert( precisionModel );
+
+   geomFact = l->getFactory();
+
+   BufferParameters modParams = bufParams;
+   modParams.setEndCapStyle(BufferParameters::CAP_FLAT); 
+
+   // Get the raw (i.e. unnoded) single sided offset curve.
+   OffsetCurveBuilder curveBuilder( precisionModel, modParams, templateCache );
+   std::vector< CoordinateSequence* > lineList;
+
+   const CoordinateSequence* coords = l->getCoordinatesRO();
+   curveBuilder.getSingleSidedLineCurve( coords, distance,
+                                         lineList, leftSide, !leftSide );
+
+   if ( lineList.empty() ) return geomFact->createLineString();
+
+   // The curve on the other side, closed by flat caps, bounds
+   // the area the requested curve must leave once it gets
+   // closer than distance to the line: node against it too,
+   // so that every noded portion lies wholly in or out.
+   curveBuilder.getSingleSidedLineCurve( coords, distance,
+                                         lineList, !leftSide, leftSide );
+   assert( lineList.size() == 2 );
+
+   CoordinateSequence* sideCurve = lineList[0];
+   CoordinateSequence* otherCurve = lineList[1];
+   removeClosingSegment( *sideCurve );
+   removeClosingSegment( *otherCurve );
+
+   // Left curves run along the line, right curves against it
+   const CoordinateSequenceFactory* csf =
+      geomFact->getCoordinateSequenceFactory();
+   std::vector< Coordinate >* capPts = new std::vector< Coordinate >();
+   capPts->push_back( sideCurve->front() );
+   capPts->push_back( otherCurve->back() );
+   lineList.push_back( csf->create( capPts ) );
+   capPts = new std::vector< Coordinate >();
+   capPts->push_back( sideCurve->back() );
+   capPts->push_back( otherCurve->front() );
+   lineList.push_back( csf->create( capPts ) );
+
+   // The raw curve vertices are all at the offset distance from
+   // the simplified input line, so it is used to find loops
+   std::auto_ptr< CoordinateSequence > refLine (
+      curveBuilder.getSingleSidedSimplifiedLine( coords, distance, leftSide )
+   );
+   SegmentDistanceIndex refIndex( *refLine );
+
+   // Allow for rounding of the curve vertices
+   double distTol = distance * 1.0E-6;
+   if ( ! precisionModel->isFloating() )
+      distTol += 1.0 / precisionModel->getScale();
+
+   // Allow for the sagitta of a fillet segment when testing
+   // a segment midpoint rather than a curve vertex
+   double chordTol = distance * BufferParameters::bufferDistanceError(
+                                   modParams.getQuadrantSegments() );
+
+   // Node the curve against itself and its bounds, with
+   // no need to build the buffer polygon.
+   // The noded portions of the requested curve are marked
+   // by their context.
+   const void* sideCurveTag = sideCurve;
+   SegmentString::NonConstVect curveList;
+   for ( std::size_t i = 0; i < lineList.size(); ++i )
+   {
+      CoordinateSequence* pts = lineList[i];
+      if ( pts->size() < 2 || ( i > 1 && pts->front().equals2D( pts->back() ) ) )
+      {
+         // nothing to node against
+         if ( i == 0 ) sideCurveTag = 0;
+         delete pts;
+         continue;
+      }
+      // SegmentString takes ownership of CoordinateSequence
+      curveList.push_back( new NodedSegmentString( pts,
+                             i == 0 ? sideCurveTag : NULL ) );
+   }
+   lineList.clear();
+
+   Noder* noder = getNoder( precisionModel );
+   noder->computeNodes( &curveList );
+   SegmentString::NonConstVect* nodedEdges = noder->getNodedSubstrings();
+
+   // Keep the noded portions of the requested curve reaching the
+   // offset distance, joining the ones which meet end to end.
+   // Any inner vertex at the offset distance keeps a portion:
+   // nothing nodes the curve where it turns into the line at an
+   // inside corner, like the short hook at an end, so a portion
+   // at the offset distance may end closer to the line.
+   // Loops lie wholly closer than the offset distance.
+   std::vector< CoordinateSequence* > pieces;
+   CoordinateSequence* current = 0;
+   for ( std::size_t i = 0, n = nodedEdges->size(); i < n; ++i )
+   {
+      SegmentString* ss = ( *nodedEdges )[i];
+      const CoordinateSequence* pts = ss->getCoordinates();
+      std::size_t npts = pts->size();
+
+      bool onCurve = false;
+      if ( ! sideCurveTag || ss->getData() != sideCurveTag )
+      {
+         // a portion of the bounds
+      }
+      else if ( npts > 2 )
+      {
+         for ( std::size_t j = 1; ! onCurve && j < npts - 1; ++j )
+            onCurve = ! refIndex.isWithinDistance( ( *pts )[j],
+                                                    distance - distTol );
+      }
+      else if ( npts == 2 )
+      {
+         const Coordinate& p0 = ( *pts )[0];
+         const Coordinate& p1 = ( *pts )[1];
+         Coordinate mid( (p0.x + p1.x) / 2, (p0.y + p1.y) / 2 );
+         onCurve = ! refIndex.isWithinDistance( mid,
+                                        distance - distTol - chordTol );
+      }
+
+      // A dropped loop starts and ends where the curve goes on,
+      // so the next kept portion may still join the current one
+      if ( onCurve )
+      {
+         if ( current && current->back().equals2D( pts->front() ) )
+         {
+            current->add( pts, false, true );
+         }
+         else
+         {
+            if ( current ) pieces.push_back( current );
+            current = pts->clone();
+         }
+      }
+
+      delete ss;
+   }
+   if ( current ) pieces.push_back( current );
+
+   // Same end trimming as bufferLineSingleSided
+   const Coordinate& startPoint = coords->front();
+   const Coordinate& endPoint = coords->back();
+   const double ptDistAllowance = (std::max)(distance - l->getLength()*0.1, distance * 0.98);
+   const double segLengthAllowance = 1.02 * distance;
+
+   std::vector< Geometry* >* resultLines = new std::vector< Geometry* >();
+   for ( std::size_t i = 0, n = pieces.size(); i < n; ++i )
+   {
+      trimLineEnds( *pieces[i], startPoint, endPoint,
+                    ptDistAllowance, segLengthAllowance );
+      if ( pieces[i]->size() > 1 )
+         resultLines->push_back( geomFact->createLineString( pieces[i] ) );
+      else
+         delete pieces[i];
+   }
+
+   delete nodedEdges;
+
+   for (std::size_t i=0, n=curveList.size(); i<n; ++i) delete curveList[i];
+   curveList.clear();
+
+   if ( noder != workingNoder ) delete noder;
+
+   if ( resultLines->size() > 1 )
+   {
+      return geomFact->createMultiLineString( resultLines );
+   }
+   else if ( resultLines->size() == 1 )
+   {
+      Geometry* single = (*resultLines)[0];
+      delete resultLines;
+      return single;
+   }
+   else
+   {
+      delete resultLines;
+      return geomFact->createLineString();
+   }
+}
+
 /*public*/
 Geometry*
 BufferBuilder::buffer(const Geometry *g, double distance)
@@ -377,7 +663,14 @@ BufferBuilder::buffer(const Geometry *g, double distance)
   { // This scope is here to force release of resources owned by 
     // OffsetCurveSetBuilder when we're doing with it
 
-	OffsetCurveBuilder curveBuilder(precisionModel, bufParams);
+	// Fillet templates are shared by all curves of this run,
+	// or across runs if the caller provided a cache
+	FilletTemplateCache localTemplateCache;
+	FilletTemplateCache* curveTemplateCache = templateCache ?
+		templateCache : &localTemplateCache;
+
+	OffsetCurveBuilder curveBuilder(precisionModel, bufParams,
+	                                curveTemplateCache);
 	OffsetCurveSetBuilder curveSetBuilder(*g, distance, curveBuilder);
 
 	std::vector<SegmentString*>& bufferSegStrList=curveSetBuilder.getCurves();
@@ -481,6 +774,7 @@ BufferBuilder::getNoder(const PrecisionModel* pm)
 	}
 
 	MCIndexNoder* noder = new MCIndexNoder(intersectionAdder);
+	noder->setPartitionRunner(noderPartitionRunner, noderMaxPartitionSize);
 
 #if 0
 	/* CoordinateArraySequence.cpp:84:
@@ -641,7 +935,9 @@ BufferBuilder::buildSubgraphs(const std::vector<BufferSubgraph*>& subgraphList,
 #if GEOS_DEBUG
 	std::cerr << __FUNCTION__ << " got " << subgraphList.size() << " subgraphs" << std::endl;
 #endif
-	std::vector<BufferSubgraph*> processedGraphs;
+	// Indexes all the subgraphs once, and locates each one
+	// against the ones processed before it
+	SubgraphDepthLocater locater(&subgraphList);
 	for (size_t i=0, n=subgraphList.size(); i<n; i++)
 	{
 		BufferSubgraph *subgraph=subgraphList[i];
@@ -652,12 +948,12 @@ BufferBuilder::buildSubgraphs(const std::vector<BufferSubgraph*>& subgraphList,
 		std::cerr << " " << i << ") Subgraph[" << subgraph << "]" << std::endl;
 		std::cerr << "  rightmost Coordinate " << *p;
 #endif
-		SubgraphDepthLocater locater(&processedGraphs);
 #if GEOS_DEBUG
-		std::cerr << " after SubgraphDepthLocater processedGraphs contain "
-		          << processedGraphs.size()
+		std::cerr << " processedGraphs contain "
+		          << i
 		          << " elements" << std::endl;
 #endif
+		locater.setNumProcessed(i);
 		int outsideDepth=locater.getDepth(*p);
 #if GEOS_DEBUG
 		std::cerr << " Depth of rightmost coordinate: " << outsideDepth << std::endl;
@@ -668,11 +964,6 @@ BufferBuilder::buildSubgraphs(const std::vector<BufferSubgraph*>& subgraphList,
 		std::cerr << " after computeDepth and findResultEdges subgraph contain:" << std::endl
 		          << "   " << subgraph->getDirectedEdges()->size() << " DirecteEdges " << std::endl
 		          << "   " << subgraph->getNodes()->size() << " Nodes " << std::endl;
-#endif
-		processedGraphs.push_back(subgraph);
-#if GEOS_DEBUG
-		std::cerr << " added " << subgraph << " to processedGraphs, new size is "
-		          << processedGraphs.size() << std::endl;
 #endif
 		polyBuilder.add(subgraph->getDirectedEdges(), subgraph->getNodes());
 	}
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
 
 #include <geos/profiler.h>
 #include <geos/operation/buffer/BufferOp.h>
@@ -27,6 +28,7 @@
 #include <geos/geom/Geometry.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/PrecisionModel.h>
+#include <geos/geom/Envelope.h>
 
 #include <geos/noding/ScaledNoder.h>
 
@@ -77,6 +79,34 @@ BufferOp::precisionScaleFactor(const Geometry *g,
 	return scaleFactor;
 }
 
+/*private*/
+int
+BufferOp::startPrecisionDigits(const Geometry *g, double distance)
+{
+	const Envelope *env=g->getEnvelopeInternal();
+	if ( env->isNull() ) return MAX_PRECISION_DIGITS;
+
+	double expandByDistance=distance > 0.0 ? distance : 0.0;
+	double envSize=(std::max)(env->getHeight(), env->getWidth());
+	double bufEnvSize=envSize + 2 * expandByDistance;
+	double magnitude=(std::max)(
+		(std::max)(std::fabs(env->getMinX()), std::fabs(env->getMaxX())),
+		(std::max)(std::fabs(env->getMinY()), std::fabs(env->getMaxY()))
+	) + expandByDistance;
+	if ( bufEnvSize <= 0.0 || magnitude <= 0.0 ) return MAX_PRECISION_DIGITS;
+
+	// same rounding as precisionScaleFactor
+	int bufEnvLog10=(int) (std::log(bufEnvSize) / std::log(10.0) + 1.0);
+	int magnitudeLog10=(int) (std::log(magnitude) / std::log(10.0) + 1.0);
+
+	// scaled coordinates have magnitudeLog10 + digits - bufEnvLog10
+	// significant digits
+	int digits=MAX_SCALED_DIGITS - magnitudeLog10 + bufEnvLog10;
+	if ( digits > MAX_PRECISION_DIGITS ) return MAX_PRECISION_DIGITS;
+	if ( digits < 0 ) return 0;
+	return digits;
+}
+
 /*public static*/
 Geometry*
 BufferOp::bufferOp(const Geometry *g, double distance,
@@ -94,6 +124,7 @@ Geometry*
 BufferOp::getResultGeometry(double nDistance)
 {
 	distance=nDistance;
+	resultPrecisionDigits=-1;
 	computeGeometry();
 	return resultGeometry;
 }
@@ -127,28 +158,83 @@ BufferOp::computeGeometry()
 void
 BufferOp::bufferReducedPrecision()
 {
-
-	// try and compute with decreasing precision
-	for (int precDigits=MAX_PRECISION_DIGITS; precDigits >= 0; precDigits--)
+	// Try the highest usable precision first: it's what
+	// most failures at the original precision need
+	int startDigits = startPrecisionDigits(argGeom, distance);
+#if GEOS_DEBUG
+	std::cerr<<"BufferOp::computeGeometry: trying with precDigits "<<startDigits<<std::endl;
+#endif
+	if ( tryReducedPrecision(startDigits) ) return;
+
+	// Lower precision is usually more robust, but success is not
+	// monotone in the number of digits: a binary search over the
+	// whole range could skip a working high precision because of
+	// a failing mid-range one. Gallop down instead (start-1,
+	// start-3, start-7, ...) and only bisect between the first
+	// success and the last failure above it.
+	int failedDigits = startDigits;
+	int bestDigits = -1;
+	for (int offset = 1; failedDigits > 0; offset = offset * 2 + 1)
 	{
+		int precDigits = (std::max)(startDigits - offset, 0);
 #if GEOS_DEBUG
 		std::cerr<<"BufferOp::computeGeometry: trying with precDigits "<<precDigits<<std::endl;
 #endif
-		try {
-			bufferReducedPrecision(precDigits);
-		} catch (const util::TopologyException& ex) {
-			saveException=ex;
-			// don't propagate the exception - it will be detected by fact that resultGeometry is null
-		} 
-
-		if (resultGeometry!=NULL) {
-			// debug
-			//if ( saveException ) std::cerr<<saveException->toString()<<std::endl;
-			return;
+		if ( tryReducedPrecision(precDigits) )
+		{
+			bestDigits = precDigits;
+			break;
 		}
+		failedDigits = precDigits;
 	}
+
 	// tried everything - have to bail
-	throw saveException;
+	if ( bestDigits < 0 ) throw saveException;
+
+	// Owned here until the search is over, so that it is freed if
+	// something other than a TopologyException escapes a retry
+	std::auto_ptr<Geometry> bestResult(resultGeometry);
+	resultGeometry = NULL;
+	int lo = bestDigits + 1;
+	int hi = failedDigits - 1;
+	while ( lo <= hi )
+	{
+		int precDigits = lo + (hi - lo) / 2;
+#if GEOS_DEBUG
+		std::cerr<<"BufferOp::computeGeometry: trying with precDigits "<<precDigits<<std::endl;
+#endif
+		if ( tryReducedPrecision(precDigits) )
+		{
+			bestResult.reset(resultGeometry);
+			bestDigits = precDigits;
+			resultGeometry = NULL;
+			lo = precDigits + 1;
+		}
+		else
+		{
+			hi = precDigits - 1;
+		}
+	}
+
+	resultGeometry = bestResult.release();
+	resultPrecisionDigits = bestDigits;
+}
+
+/*private*/
+bool
+BufferOp::tryReducedPrecision(int precisionDigits)
+{
+	try {
+		bufferReducedPrecision(precisionDigits);
+	} catch (const util::TopologyException& ex) {
+		saveException=ex;
+		// don't propagate the exception - it will be detected by fact that resultGeometry is null
+	}
+
+	if ( resultGeometry == NULL ) return false;
+
+	resultPrecisionDigits = precisionDigits;
+	return true;
 }
 
 /*private*/
@@ -156,6 +242,7 @@ void
 BufferOp::bufferOriginalPrecision()
 {
 	BufferBuilder bufBuilder(bufParams);
+	bufBuilder.setFilletTemplateCache(templateCache);
 
 	//std::cerr<<"computing with original precision"<<std::endl;
 	try
@@ -173,6 +260,7 @@ BufferOp::bufferOriginalPrecision()
 	//std::cerr<<"done"<<std::endl;
 }
 
+/*protected*/
 void
 BufferOp::bufferReducedPrecision(int precisionDigits)
 {
@@ -202,6 +290,7 @@ BufferOp::bufferFixedPrecision(const PrecisionModel& fixedPM)
 
 	BufferBuilder bufBuilder(bufParams);
 	bufBuilder.setWorkingPrecisionModel(&fixedPM);
+	bufBuilder.setFilletTemplateCache(templateCache);
 
 	bufBuilder.setNoder(&noder);
 
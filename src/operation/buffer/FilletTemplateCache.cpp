@@ -0,0 +1,70 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/buffer/FilletTemplateCache.h>
+#include <geos/geom/Coordinate.h>
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace buffer { // geos.operation.buffer
+
+/*public*/
+const std::vector<Coordinate>&
+FilletTemplateCache::getUnitCircle(int quadrantSegments)
+{
+	assert(quadrantSegments >= 1);
+
+	TemplateMap::iterator it = templates.find(quadrantSegments);
+	if ( it != templates.end() ) return it->second;
+
+	std::vector<Coordinate>& pts = templates[quadrantSegments];
+	computeUnitCircle(quadrantSegments, pts);
+	return pts;
+}
+
+/*private static*/
+void
+FilletTemplateCache::computeUnitCircle(int quadrantSegments,
+                                       std::vector<Coordinate>& pts)
+{
+	// Same value used by OffsetSegmentGenerator, so that
+	// vertices taken from the template are bit-identical
+	// to the ones it would compute on its own
+	const double PI = 3.14159265358979;
+
+	double filletAngleQuantum = PI / 2.0 / quadrantSegments;
+	double totalAngle = 2.0 * PI;
+	int nSegs = (int) (totalAngle / filletAngleQuantum + 0.5);
+	double currAngleInc = totalAngle / nSegs;
+
+	pts.reserve(nSegs + 1);
+
+	// Accumulating the angle rather than multiplying it
+	// mirrors OffsetSegmentGenerator::addFillet
+	double currAngle = 0.0;
+	while (currAngle < totalAngle) {
+		double angle = -currAngle;
+		pts.push_back(Coordinate(std::cos(angle), std::sin(angle)));
+		currAngle += currAngleInc;
+	}
+}
+
+} // namespace geos.operation.buffer
+} // namespace geos.operation
+} // namespace geos
+
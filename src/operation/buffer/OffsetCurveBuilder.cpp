@@ -157,6 +157,17 @@ OffsetCurveBuilder::getSingleSidedLineCurve(const CoordinateSequence* inputPts,
   segGen->getCoordinates(lineList);
 }
 
+/*public*/
+std::auto_ptr<CoordinateSequence>
+OffsetCurveBuilder::getSingleSidedSimplifiedLine(
+   const CoordinateSequence* inputPts, double distance, bool leftSide)
+{
+  double distTol = simplifyTolerance(distance);
+  // the right side curve walks this line backwards
+  if ( ! leftSide ) distTol = -distTol;
+  return BufferInputLineSimplifier::simplify( *inputPts, distTol );
+}
+
 /*public*/
 void
 OffsetCurveBuilder::getRingCurve(const CoordinateSequence *inputPts,
@@ -307,7 +318,8 @@ std::auto_ptr<OffsetSegmentGenerator>
 OffsetCurveBuilder::getSegGen(double dist)
 {
   std::auto_ptr<OffsetSegmentGenerator> osg(
-    new OffsetSegmentGenerator(precisionModel, bufParams, dist)
+    new OffsetSegmentGenerator(precisionModel, bufParams, dist,
+                               templateCache)
   );
   return osg;
 }
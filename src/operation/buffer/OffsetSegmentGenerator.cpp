@@ -24,6 +24,7 @@
 #include <geos/algorithm/Angle.h>
 #include <geos/operation/buffer/OffsetSegmentGenerator.h>
 #include <geos/operation/buffer/OffsetSegmentString.h>
+#include <geos/operation/buffer/FilletTemplateCache.h>
 #include <geos/operation/buffer/BufferOp.h>
 #include <geos/operation/buffer/BufferParameters.h>
 #include <geos/geomgraph/Position.h>
@@ -31,7 +32,6 @@
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/PrecisionModel.h>
-#include <geos/algorithm/NotRepresentableException.h>
 #include <geos/algorithm/HCoordinate.h>
 #include <geos/util.h>
 
@@ -56,14 +56,17 @@ const double OffsetSegmentGenerator::PI = 3.14159265358979;
 const double OffsetSegmentGenerator::OFFSET_SEGMENT_SEPARATION_FACTOR = 1.0E-3;
 const double OffsetSegmentGenerator::INSIDE_TURN_VERTEX_SNAP_DISTANCE_FACTOR = 1.0E-3;
 const double OffsetSegmentGenerator::SIMPLIFY_FACTOR = 100.0;
+const double OffsetSegmentGenerator::TEMPLATE_ANGLE_TOLERANCE = 1.0E-12;
 
 /*public*/
 OffsetSegmentGenerator::OffsetSegmentGenerator(
     const PrecisionModel *newPrecisionModel,
     const BufferParameters& nBufParams,
-    double dist)
+    double dist,
+    FilletTemplateCache* templateCache)
     :
     maxCurveSegmentError(0.0),
+    unitCircle(NULL),
     closingSegLengthFactor(1),
     segList(),
     distance(dist),
@@ -85,6 +88,12 @@ OffsetSegmentGenerator::OffsetSegmentGenerator(
   // the points are rounded as they are inserted into the curve line
   filletAngleQuantum = PI / 2.0 / bufParams.getQuadrantSegments();
 
+  if ( templateCache )
+  {
+    unitCircle = &(templateCache->getUnitCircle(
+                                  bufParams.getQuadrantSegments()));
+  }
+
   /**
    * Non-round joins cause issues with short closing segments,
    * so don't use them.  In any case, non-round joins
@@ -274,19 +283,55 @@ OffsetSegmentGenerator::addFillet(const Coordinate &p, double startAngle,
   // no segments because angle is less than increment-nothing to do!
   if (nSegs<1) return;
 
-  double initAngle, currAngleInc;
-
   // choose angle increment so that each segment has equal length
-  initAngle = 0.0;
-  currAngleInc = totalAngle / nSegs;
+  double currAngleInc = totalAngle / nSegs;
 
-  double currAngle = initAngle;
+  double cosStart = cos(startAngle);
+  double sinStart = sin(startAngle);
   Coordinate pt;
+
+  // number of vertices of a whole circle
+  int nCircleSegs = 4 * bufParams.getQuadrantSegments();
+
+  // The loops below use the same accumulated angle test as the
+  // JTS code, so that the number of vertices doesn't change
+
+  if ( unitCircle
+       && nSegs < nCircleSegs
+       && fabs(currAngleInc - filletAngleQuantum) <= TEMPLATE_ANGLE_TOLERANCE )
+  {
+    // Arc made of whole quadrant segments: rotate the
+    // template (which runs clockwise from angle 0) by startAngle
+    const std::vector<Coordinate>& tmpl = *unitCircle;
+    int i = 0;
+    double currAngle = 0.0;
+    while (currAngle < totalAngle) {
+      const Coordinate& t = tmpl[ directionFactor < 0 ? i
+                                  : (nCircleSegs - i) % nCircleSegs ];
+      pt.x = p.x + radius * (cosStart * t.x - sinStart * t.y);
+      pt.y = p.y + radius * (sinStart * t.x + cosStart * t.y);
+      segList.addPt(pt);
+      currAngle += currAngleInc;
+      ++i;
+    }
+    return;
+  }
+
+  // Step the radius vector around p, rotating it by
+  // the angle increment at each vertex
+  double cosInc = cos(currAngleInc);
+  double sinInc = directionFactor * sin(currAngleInc);
+  double ux = cosStart;
+  double uy = sinStart;
+  double currAngle = 0.0;
   while (currAngle < totalAngle) {
-    double angle = startAngle + directionFactor * currAngle;
-    pt.x = p.x + radius * cos(angle);
-    pt.y = p.y + radius * sin(angle);
+    pt.x = p.x + radius * ux;
+    pt.y = p.y + radius * uy;
     segList.addPt(pt);
+
+    double nx = ux * cosInc - uy * sinInc;
+    uy = ux * sinInc + uy * cosInc;
+    ux = nx;
     currAngle += currAngleInc;
   }
 }
@@ -299,7 +344,23 @@ OffsetSegmentGenerator::createCircle(const Coordinate &p, double distance)
   // add start point
   Coordinate pt(p.x + distance, p.y);
   segList.addPt(pt);
-  addFillet(p, 0.0, 2.0*PI, -1, distance);
+
+  if ( ! unitCircle )
+  {
+    addFillet(p, 0.0, 2.0*PI, -1, distance);
+    segList.closeRing();
+    return;
+  }
+
+  // A point buffer is just the unit circle template,
+  // scaled and translated in place
+  const std::vector<Coordinate>& tmpl = *unitCircle;
+  for (size_t i=0, n=tmpl.size(); i<n; ++i)
+  {
+    pt.x = p.x + distance * tmpl[i].x;
+    pt.y = p.y + distance * tmpl[i].y;
+    segList.addPt(pt);
+  }
   segList.closeRing();
 }
 
@@ -495,22 +556,18 @@ OffsetSegmentGenerator::addMitreJoin(const geom::Coordinate& p,
    * by the check for whether the offset segment endpoints are
    * almost coincident
          */
-    try
-    {
-        HCoordinate::intersection(offset0.p0, offset0.p1,
+    if (HCoordinate::tryIntersection(offset0.p0, offset0.p1,
             offset1.p0, offset1.p1,
-            intPt);
-
+            intPt))
+    {
         double mitreRatio = distance <= 0.0 ? 1.0
             : intPt.distance(p) / fabs(distance);
 
         if (mitreRatio > bufParams.getMitreLimit())
             isMitreWithinLimit = false;
     }
-    catch (const NotRepresentableException& e)
+    else
     {
-        ::geos::ignore_unused_variable_warning(e);
-
         intPt = Coordinate(0,0);
         isMitreWithinLimit = false;
     }
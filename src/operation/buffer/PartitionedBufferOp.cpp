@@ -0,0 +1,209 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/buffer/PartitionedBufferOp.h>
+#include <geos/operation/buffer/BufferBuilder.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/util/PolygonExtracter.h>
+#include <geos/operation/union/CascadedPolygonUnion.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace buffer { // geos.operation.buffer
+
+namespace {
+
+// A component and the centre of its envelope
+struct PartitionItem {
+	const Geometry* geom;
+	double x;
+	double y;
+};
+
+bool
+comparePartitionItemX(const PartitionItem& a, const PartitionItem& b)
+{
+	return a.x < b.x;
+}
+
+bool
+comparePartitionItemY(const PartitionItem& a, const PartitionItem& b)
+{
+	return a.y < b.y;
+}
+
+// Deletes the geometries of a vector and empties it
+void
+deleteAll(std::vector<Geometry*>& geoms)
+{
+	for (std::size_t i=0, n=geoms.size(); i<n; ++i)
+		delete geoms[i];
+	geoms.clear();
+}
+
+} // anonymous namespace
+
+/*public*/
+PartitionedBufferOp::PartitionedBufferOp(const Geometry* g,
+		std::size_t maxGroupSize, const BufferParameters& params)
+	:
+	argGeom(g),
+	bufParams(params)
+{
+	if ( maxGroupSize == 0 )
+		throw util::IllegalArgumentException(
+			"Group size must be positive");
+
+	// The buffer of a union of one-sided buffers is not
+	// the one-sided buffer of the union
+	if ( bufParams.isSingleSided() )
+		throw util::IllegalArgumentException(
+			"Single-sided buffers can not be partitioned");
+
+	try {
+		buildGroups(maxGroupSize);
+	} catch (...) {
+		deleteAll(groups);
+		throw;
+	}
+}
+
+/*public*/
+PartitionedBufferOp::~PartitionedBufferOp()
+{
+	deleteAll(groups);
+}
+
+/*private*/
+void
+PartitionedBufferOp::buildGroups(std::size_t maxGroupSize)
+{
+	std::vector<PartitionItem> items;
+	bool isCollection = dynamic_cast<const GeometryCollection*>(argGeom) != 0;
+	std::size_t nComps = isCollection ? argGeom->getNumGeometries() : 1;
+	for (std::size_t i=0; i<nComps; ++i)
+	{
+		const Geometry* g = isCollection ? argGeom->getGeometryN(i) : argGeom;
+		if ( g->isEmpty() ) continue;
+		const Envelope* env = g->getEnvelopeInternal();
+		PartitionItem item;
+		item.geom = g;
+		item.x = (env->getMinX() + env->getMaxX()) / 2;
+		item.y = (env->getMinY() + env->getMaxY()) / 2;
+		items.push_back(item);
+	}
+
+	// Sort-Tile-Recursive ordering: vertical slices by x,
+	// each one sorted by y, so that consecutive runs of
+	// maxGroupSize items are spatially clustered
+	std::size_t nItems = items.size();
+	std::size_t nGroups = (nItems + maxGroupSize - 1) / maxGroupSize;
+	std::size_t nSlices = static_cast<std::size_t>(
+		std::ceil(std::sqrt(static_cast<double>(nGroups))));
+	if ( nSlices == 0 ) nSlices = 1;
+	std::size_t sliceSize = maxGroupSize *
+		((nGroups + nSlices - 1) / nSlices);
+
+	std::sort(items.begin(), items.end(), comparePartitionItemX);
+	for (std::size_t i=0; i<nItems; i+=sliceSize)
+	{
+		std::size_t end = (std::min)(i + sliceSize, nItems);
+		std::sort(items.begin() + i, items.begin() + end,
+		          comparePartitionItemY);
+	}
+
+	const GeometryFactory* factory = argGeom->getFactory();
+	groups.reserve(nGroups);
+	for (std::size_t i=0; i<nItems; i+=maxGroupSize)
+	{
+		std::size_t end = (std::min)(i + maxGroupSize, nItems);
+		std::auto_ptr< std::vector<Geometry*> > parts(
+			new std::vector<Geometry*>());
+		parts->reserve(end - i);
+		try {
+			for (std::size_t j=i; j<end; ++j)
+				parts->push_back(items[j].geom->clone());
+		} catch (...) {
+			deleteAll(*parts);
+			throw;
+		}
+		Geometry* group = factory->buildGeometry(parts.release());
+		groups.push_back(group);
+
+		// Envelopes are cached on first use: compute them now,
+		// so that bufferGroup does not write to shared state
+		group->getEnvelopeInternal();
+	}
+}
+
+/*public*/
+Geometry*
+PartitionedBufferOp::bufferGroup(std::size_t i, double distance,
+		FilletTemplateCache* cache) const
+{
+	// Only a positive distance distributes over the union
+	// of the components
+	if ( ! ( distance > 0 ) )
+		throw util::IllegalArgumentException(
+			"Partitioned buffer distance must be positive");
+
+	BufferBuilder bufBuilder(bufParams);
+	bufBuilder.setFilletTemplateCache(cache);
+	return bufBuilder.buffer(groups[i], distance);
+}
+
+/*public*/
+Geometry*
+PartitionedBufferOp::unionGroupBuffers(
+		std::vector<Geometry*>& groupBuffers) const
+{
+	try
+	{
+		std::vector<const Polygon*> polys;
+		for (std::size_t i=0, n=groupBuffers.size(); i<n; ++i)
+			geom::util::PolygonExtracter::getPolygons(*groupBuffers[i], polys);
+
+		Geometry* result;
+		if ( polys.empty() )
+		{
+			result = argGeom->getFactory()->createPolygon();
+		}
+		else
+		{
+			result = geounion::CascadedPolygonUnion::Union(
+				polys.begin(), polys.end());
+		}
+		deleteAll(groupBuffers);
+		return result;
+	}
+	catch (...)
+	{
+		deleteAll(groupBuffers);
+		throw;
+	}
+}
+
+} // namespace geos.operation.buffer
+} // namespace geos.operation
+} // namespace geos
@@ -24,6 +24,7 @@
 #include <geos/geomgraph/Position.h>
 #include <geos/geomgraph/Node.h>
 #include <geos/geomgraph/Edge.h>
+#include <geos/util/TopologyException.h>
 
 #include <vector>
 #include <cassert>
@@ -72,6 +73,13 @@ RightmostEdgeFinder::findEdge(std::vector<DirectedEdge*>* dirEdgeList)
 #endif
 	}
 
+	if ( ! minDe )
+	{
+		// Reduced precision noding can leave degenerate
+		// subgraphs behind: let the caller try another precision
+		throw util::TopologyException("No forward edges found in buffer subgraph");
+	}
+
 #ifndef NDEBUG
 	assert(checked>0);
 	assert(minIndex>=0);
@@ -28,11 +28,15 @@
 
 #include <geos/geom/Envelope.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/LineSegment.h>
 
 #include <geos/geomgraph/DirectedEdge.h>
 #include <geos/geomgraph/Edge.h>
 #include <geos/geomgraph/Position.h>
 
+#include <geos/index/ItemVisitor.h>
+#include <geos/index/intervalrtree/SortedPackedIntervalRTree.h>
+
 #ifndef GEOS_DEBUG
 #define GEOS_DEBUG 0
 #endif
@@ -140,6 +144,180 @@ struct DepthSegmentLessThen {
 
 
 
+/**
+ * A packed interval tree over the y extent of the non-horizontal
+ * segments of the forward DirectedEdges of a subgraph.
+ *
+ * Not in JTS
+ */
+class SubgraphDepthLocater::SegmentIndex {
+
+public:
+
+	SegmentIndex(BufferSubgraph& bsg)
+		:
+		collector(candidates)
+	{
+		/**
+		 * Index forward DirectedEdges only. This is still general,
+		 * because each Edge has a forward DirectedEdge.
+		 */
+		vector<DirectedEdge*>* dirEdges = bsg.getDirectedEdges();
+		for (size_t i=0, ni=dirEdges->size(); i<ni; ++i)
+		{
+			DirectedEdge *de=(*dirEdges)[i];
+			if (!de->isForward()) continue;
+
+			const CoordinateSequence *pts=de->getEdge()->getCoordinates();
+			for (size_t j=1, nj=pts->getSize(); j<nj; ++j)
+			{
+				Segment s;
+				s.low=&(pts->getAt(j-1));
+				s.high=&(pts->getAt(j));
+
+				// skip horizontal segments (there will be a non-horizontal
+				// one carrying the same depth info)
+				if (s.low->y == s.high->y) continue;
+
+				// ensure segment always points upwards
+				s.flipped = s.low->y > s.high->y;
+				if (s.flipped) std::swap(s.low, s.high);
+
+				s.dirEdge=de;
+				segments.push_back(s);
+			}
+		}
+
+		for (size_t i=0, n=segments.size(); i<n; ++i)
+		{
+			Segment& s = segments[i];
+			tree.insert(s.low->y, s.high->y, &s);
+		}
+	}
+
+	/**
+	 * Adds a DepthSegment for each segment intersecting the stabbing
+	 * line, in the order of a linear scan of the DirectedEdges,
+	 * so that getDepth breaks ties between segments the same way.
+	 */
+	void findStabbedSegments(const Coordinate &stabbingRayLeftPt,
+			vector<DepthSegment*>& stabbedSegments)
+	{
+		// an empty tree cannot be queried
+		if (segments.empty()) return;
+
+		candidates.clear();
+		tree.query(stabbingRayLeftPt.y, stabbingRayLeftPt.y, &collector);
+		sort(candidates.begin(), candidates.end());
+
+		LineSegment seg;
+		for (size_t i=0, n=candidates.size(); i<n; ++i)
+		{
+			const Segment& s = *candidates[i];
+
+			// skip segment if it is left of the stabbing line
+			// (segments above or below it are not candidates)
+			double maxx=max(s.low->x, s.high->x);
+			if (maxx < stabbingRayLeftPt.x)
+			{
+#if GEOS_DEBUG
+				cerr<<" segment is left to stabbing line, skipping "<<endl;
+#endif
+				continue;
+			}
+
+			// skip if stabbing ray is right of the segment
+			if (CGAlgorithms::computeOrientation(*s.low, *s.high,
+					stabbingRayLeftPt)==CGAlgorithms::RIGHT)
+			{
+#if GEOS_DEBUG
+				cerr<<" stabbing ray right of segment, skipping"<<endl;
+#endif
+				continue;
+			}
+
+			// stabbing line cuts this segment, so record it;
+			// if segment direction was flipped, use RHS depth instead
+			int depth = s.flipped ?
+				s.dirEdge->getDepth(Position::RIGHT)
+				:
+				s.dirEdge->getDepth(Position::LEFT);
+
+#if GEOS_DEBUG
+			cerr<<" depth: "<<depth<<endl;
+#endif
+
+			seg.p0 = *s.low;
+			seg.p1 = *s.high;
+
+			DepthSegment *ds=new DepthSegment(seg, depth);
+			stabbedSegments.push_back(ds);
+		}
+	}
+
+private:
+
+	/// A non-horizontal segment of a forward DirectedEdge,
+	/// directed upwards
+	struct Segment {
+
+		const Coordinate *low;
+
+		const Coordinate *high;
+
+		DirectedEdge *dirEdge;
+
+		/// True if the segment runs downwards in the DirectedEdge
+		bool flipped;
+	};
+
+	typedef std::vector<const Segment*> ConstVect;
+
+	class Collector: public index::ItemVisitor {
+	public:
+		Collector(ConstVect& nResult) : result(nResult) {}
+		void visitItem(void* item)
+		{
+			result.push_back(static_cast<const Segment*>(item));
+		}
+	private:
+		ConstVect& result;
+		// Declare type as noncopyable
+		Collector(const Collector& other);
+		Collector& operator=(const Collector& rhs);
+	};
+
+	/// In DirectedEdge and segment order
+	std::vector<Segment> segments;
+
+	index::intervalrtree::SortedPackedIntervalRTree tree;
+
+	/// Query result, reused across queries
+	ConstVect candidates;
+
+	Collector collector;
+
+	// Declare type as noncopyable
+	SegmentIndex(const SegmentIndex& other);
+	SegmentIndex& operator=(const SegmentIndex& rhs);
+};
+
+/*public*/
+SubgraphDepthLocater::SubgraphDepthLocater(
+		const std::vector<BufferSubgraph*> *newSubgraphs)
+	:
+	subgraphs(newSubgraphs),
+	numProcessed(newSubgraphs->size())
+{
+}
+
+/*public*/
+SubgraphDepthLocater::~SubgraphDepthLocater()
+{
+	for (size_t i=0, n=segIndexes.size(); i<n; ++i)
+		delete segIndexes[i];
+}
+
 /*public*/
 int
 SubgraphDepthLocater::getDepth(const Coordinate& p)
@@ -176,181 +354,39 @@ SubgraphDepthLocater::findStabbedSegments(const Coordinate &stabbingRayLeftPt,
 			std::vector<DepthSegment*>& stabbedSegments)
 {
 	size_t size = subgraphs->size();
-	for (size_t i=0; i<size; ++i)
-	{
-		BufferSubgraph *bsg=(*subgraphs)[i];
-
-		// optimization - don't bother checking subgraphs
-		// which the ray does not intersect
-		Envelope *env = bsg->getEnvelope();
-		if ( stabbingRayLeftPt.y < env->getMinY()
-			|| stabbingRayLeftPt.y > env->getMaxY()
-                        || stabbingRayLeftPt.x < env->getMinX()
-                        || stabbingRayLeftPt.x > env->getMaxX())
-		{
-				continue;
-		}
+	if (size==0 || numProcessed==0) return;
 
-		findStabbedSegments(stabbingRayLeftPt, bsg->getDirectedEdges(),
-			stabbedSegments);
+	if (segIndexes.empty())
+	{
+		subgraphEnvs.reserve(size);
+		for (size_t i=0; i<size; ++i)
+			subgraphEnvs.push_back(*(*subgraphs)[i]->getEnvelope());
+		for (size_t i=0; i<size; ++i)
+			envTree.insert(&subgraphEnvs[i], &subgraphEnvs[i]);
+		segIndexes.assign(size, 0);
 	}
-}
 
-/*private*/
-void
-SubgraphDepthLocater::findStabbedSegments(
-	const Coordinate &stabbingRayLeftPt,
-	vector<DirectedEdge*>* dirEdges,
-	vector<DepthSegment*>& stabbedSegments)
-{
+	// optimization - don't bother checking subgraphs
+	// which the ray does not intersect
+	Envelope rayEnv(stabbingRayLeftPt);
+	vector<void*> found;
+	envTree.query(&rayEnv, found);
 
-	/**
-	 * Check all forward DirectedEdges only. This is still general,
-	 * because each Edge has a forward DirectedEdge.
-	 */
-	for (size_t i=0, n=dirEdges->size(); i<n; ++i)
+	vector<size_t> candidates;
+	const Envelope* base=&subgraphEnvs[0];
+	for (size_t i=0, n=found.size(); i<n; ++i)
 	{
-		DirectedEdge *de=(*dirEdges)[i];
-		if (!de->isForward()) continue;
-		findStabbedSegments(stabbingRayLeftPt, de, stabbedSegments);
+		size_t pos = static_cast<const Envelope*>(found[i]) - base;
+		if (pos < numProcessed) candidates.push_back(pos);
 	}
-}
-
-/*private*/
-void
-SubgraphDepthLocater::findStabbedSegments(
-	const Coordinate &stabbingRayLeftPt,
-	DirectedEdge *dirEdge,
-	vector<DepthSegment*>& stabbedSegments)
-{
-	const CoordinateSequence *pts=dirEdge->getEdge()->getCoordinates();
-
-// It seems that LineSegment is *very* slow... undef this
-// to see yourself
-// LineSegment has been refactored to be mostly inline, still
-// it makes copies of the given coordinates, while the 'non-LineSemgent'
-// based code below uses pointers instead. I'll kip the SKIP_LS
-// defined until LineSegment switches to Coordinate pointers instead.
-//
-#define SKIP_LS 1
-
-	int n = pts->getSize()-1;
-	for (int i=0; i<n; ++i) {
-#ifndef SKIP_LS
-		seg.p0=pts->getAt(i);
-		seg.p1=pts->getAt(i + 1);
-#if GEOS_DEBUG
-		cerr << " SubgraphDepthLocater::findStabbedSegments: segment " << i
-			<< " (" << seg << ") ";
-#endif
-
-#else
-		const Coordinate *low=&(pts->getAt(i));
-		const Coordinate *high=&(pts->getAt(i+1));
-		const Coordinate *swap=NULL;
-
-#endif
-
-#ifndef SKIP_LS
-		// ensure segment always points upwards
-		//if (seg.p0.y > seg.p1.y)
-		{
-			seg.reverse();
-#if GEOS_DEBUG
-			cerr << " reverse (" << seg << ") ";
-#endif
-		}
-#else
-		if (low->y > high->y)
-		{
-			swap=low;
-			low=high;
-			high=swap;
-		}
-#endif
+	sort(candidates.begin(), candidates.end());
 
-		// skip segment if it is left of the stabbing line
-		// skip if segment is above or below stabbing line
-#ifndef SKIP_LS
-		double maxx=max(seg.p0.x, seg.p1.x);
-#else
-		double maxx=max(low->x, high->x);
-#endif
-		if (maxx < stabbingRayLeftPt.x)
-		{
-#if GEOS_DEBUG
-			cerr<<" segment is left to stabbing line, skipping "<<endl;
-#endif
-			continue;
-		}
-
-		// skip horizontal segments (there will be a non-horizontal
-		// one carrying the same depth info
-#ifndef SKIP_LS
-		if (seg.isHorizontal())
-#else
-		if (low->y == high->y)
-#endif
-		{
-#if GEOS_DEBUG
-			cerr<<" segment is horizontal, skipping "<<endl;
-#endif
-			continue;
-		}
-
-		// skip if segment is above or below stabbing line
-#ifndef SKIP_LS
-		if (stabbingRayLeftPt.y < seg.p0.y ||
-			stabbingRayLeftPt.y > seg.p1.y)
-#else
-		if (stabbingRayLeftPt.y < low->y ||
-			stabbingRayLeftPt.y > high->y)
-#endif
-		{
-#if GEOS_DEBUG 
-			cerr<<" segment above or below stabbing line, skipping "<<endl;
-#endif
-			continue;
-		}
-
-		// skip if stabbing ray is right of the segment
-#ifndef SKIP_LS
-		if (CGAlgorithms::computeOrientation(seg.p0, seg.p1,
-#else
-		if (CGAlgorithms::computeOrientation(*low, *high,
-#endif
-				stabbingRayLeftPt)==CGAlgorithms::RIGHT)
-		{
-#if GEOS_DEBUG
-			cerr<<" stabbing ray right of segment, skipping"<<endl;
-#endif
-			continue;
-		}
-
-#ifndef SKIP_LS
-		// stabbing line cuts this segment, so record it
-		int depth=dirEdge->getDepth(Position::LEFT);
-		// if segment direction was flipped, use RHS depth instead
-		if (! (seg.p0==pts->getAt(i)))
-			depth=dirEdge->getDepth(Position::RIGHT);
-#else
-		int depth = swap ?
-			dirEdge->getDepth(Position::RIGHT)
-			:
-			dirEdge->getDepth(Position::LEFT);
-#endif
-
-#if GEOS_DEBUG
-	cerr<<" depth: "<<depth<<endl;
-#endif
-
-#ifdef SKIP_LS
-		seg.p0 = *low;
-		seg.p1 = *high;
-#endif
-
-		DepthSegment *ds=new DepthSegment(seg, depth);
-		stabbedSegments.push_back(ds);
+	for (size_t i=0, n=candidates.size(); i<n; ++i)
+	{
+		size_t pos = candidates[i];
+		SegmentIndex*& segIndex = segIndexes[pos];
+		if (!segIndex) segIndex = new SegmentIndex(*(*subgraphs)[pos]);
+		segIndex->findStabbedSegments(stabbingRayLeftPt, stabbedSegments);
 	}
 }
 
@@ -29,6 +29,7 @@
 #include <geos/operation/overlay/PointBuilder.h>
 #include <geos/geom/Geometry.h>
 #include <geos/geom/Coordinate.h>
+#include <geos/geom/Envelope.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Polygon.h>
 #include <geos/geom/LineString.h>
@@ -45,6 +46,8 @@
 #include <geos/geomgraph/index/SegmentIntersector.h>
 #include <geos/util/TopologyException.h>
 #include <geos/geomgraph/EdgeNodingValidator.h>
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/index/strtree/STRtree.h>
 
 #include <cassert>
 #include <cmath>
@@ -142,7 +145,9 @@ OverlayOp::OverlayOp(const Geometry *g0, const Geometry *g1)
 	graph(OverlayNodeFactory::instance()),
 	resultPolyList(NULL),
 	resultLineList(NULL),
-	resultPointList(NULL)
+	resultPointList(NULL),
+	resultPolyIndex(NULL),
+	resultLineIndex(NULL)
 
 {
 
@@ -173,6 +178,10 @@ OverlayOp::~OverlayOp()
 	delete resultPolyList;
 	delete resultLineList;
 	delete resultPointList;
+	delete resultPolyIndex;
+	for (size_t i=0; i<resultPolyLocators.size(); i++)
+		delete resultPolyLocators[i];
+	delete resultLineIndex;
 	for (size_t i=0; i<dupEdges.size(); i++)
 		delete dupEdges[i];
 #if USE_ELEVATION_MATRIX
@@ -560,8 +569,8 @@ OverlayOp::cancelDuplicateResultEdges()
 bool
 OverlayOp::isCoveredByLA(const Coordinate& coord)
 {
-	if (isCovered(coord,resultLineList)) return true;
-	if (isCovered(coord,resultPolyList)) return true;
+	if (isCoveredByResultLines(coord)) return true;
+	if (isCoveredByResultPolygons(coord)) return true;
 	return false;
 }
 
@@ -569,7 +578,83 @@ OverlayOp::isCoveredByLA(const Coordinate& coord)
 bool
 OverlayOp::isCoveredByA(const Coordinate& coord)
 {
-	if (isCovered(coord,resultPolyList)) return true;
+	if (isCoveredByResultPolygons(coord)) return true;
+	return false;
+}
+
+/*private*/
+bool
+OverlayOp::isCoveredByResultPolygons(const Coordinate& coord)
+{
+	using algorithm::locate::IndexedPointInAreaLocator;
+
+	assert(resultPolyList);
+	if (resultPolyList->empty()) return false;
+
+	// Items are the positions in resultPolyList
+	Polygon** polys = &(*resultPolyList)[0];
+	if (!resultPolyIndex)
+	{
+		resultPolyIndex = new geos::index::strtree::STRtree();
+		for(size_t i=0, n=resultPolyList->size(); i<n; ++i)
+		{
+			resultPolyIndex->insert(polys[i]->getEnvelopeInternal(),
+			                        &polys[i]);
+		}
+		resultPolyLocators.assign(resultPolyList->size(), 0);
+	}
+
+	Envelope env(coord);
+	vector<void*> found;
+	resultPolyIndex->query(&env, found);
+	for(size_t i=0, n=found.size(); i<n; ++i)
+	{
+		size_t polyIndex = static_cast<Polygon**>(found[i]) - polys;
+		Geometry *poly = polys[polyIndex];
+
+		int loc;
+		if (poly->getNumPoints() < MIN_INDEXED_POLYGON_POINTS)
+		{
+			loc=ptLocator.locate(coord,poly);
+		}
+		else
+		{
+			IndexedPointInAreaLocator*& locator =
+				resultPolyLocators[polyIndex];
+			if (!locator) locator = new IndexedPointInAreaLocator(*poly);
+			loc=locator->locate(&coord);
+		}
+		if (loc!=Location::EXTERIOR) return true;
+	}
+	return false;
+}
+
+/*private*/
+bool
+OverlayOp::isCoveredByResultLines(const Coordinate& coord)
+{
+	assert(resultLineList);
+	if (resultLineList->empty()) return false;
+
+	if (!resultLineIndex)
+	{
+		resultLineIndex = new geos::index::strtree::STRtree();
+		for(size_t i=0, n=resultLineList->size(); i<n; ++i)
+		{
+			LineString *line=(*resultLineList)[i];
+			resultLineIndex->insert(line->getEnvelopeInternal(), line);
+		}
+	}
+
+	Envelope env(coord);
+	vector<void*> found;
+	resultLineIndex->query(&env, found);
+	for(size_t i=0, n=found.size(); i<n; ++i)
+	{
+		Geometry *geom=static_cast<LineString*>(found[i]);
+		int loc=ptLocator.locate(coord,geom);
+		if (loc!=Location::EXTERIOR) return true;
+	}
 	return false;
 }
 
@@ -28,10 +28,15 @@
 #include <geos/geom/LinearRing.h>
 #include <geos/geom/Polygon.h>
 #include <geos/algorithm/CGAlgorithms.h>
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Location.h>
+#include <geos/index/strtree/STRtree.h>
 #include <geos/util/TopologyException.h>
 #include <geos/util/GEOSException.h>
 #include <geos/util.h>
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 
@@ -63,6 +68,105 @@ PolygonBuilder::~PolygonBuilder()
 	}
 }
 
+/**
+ * Finds the shells which may contain a hole.
+ *
+ * Shell envelopes are kept in an STRtree, built on the first query,
+ * and shells with many points are given an IndexedPointInAreaLocator
+ * the first time a point is tested against them.
+ *
+ * Not in JTS
+ */
+class PolygonBuilder::ShellIndex {
+
+public:
+
+	ShellIndex(vector<EdgeRing*>& nShells, const GeometryFactory* gf)
+		:
+		shells(nShells),
+		geometryFactory(gf),
+		indexed(false)
+	{}
+
+	~ShellIndex()
+	{
+		for(size_t i=0, n=locators.size(); i<n; ++i)
+		{
+			delete locators[i];
+			delete shellPolys[i];
+		}
+	}
+
+	EdgeRing* getShell(size_t i) { return shells[i]; }
+
+	/// Appends the ascending positions in the shell list of the
+	/// shells whose envelope intersects env
+	void query(const Envelope& env, vector<size_t>& result)
+	{
+		if (shells.empty()) return;
+		if (!indexed) buildIndex();
+		vector<void*> found;
+		tree.query(&env, found);
+		EdgeRing** base=&shells[0];
+		for(size_t i=0, n=found.size(); i<n; ++i)
+		{
+			result.push_back(static_cast<EdgeRing**>(found[i]) - base);
+		}
+		sort(result.begin(), result.end());
+	}
+
+	/// Same as CGAlgorithms::isPointInRing(pt, shell coordinates)
+	bool isPointInShell(const Coordinate& pt, size_t i)
+	{
+		LinearRing *ring=shells[i]->getLinearRing();
+		if (ring->getNumPoints() < MIN_INDEXED_SHELL_POINTS)
+		{
+			return CGAlgorithms::isPointInRing(pt, ring->getCoordinatesRO());
+		}
+		if (!locators[i])
+		{
+			LinearRing *shellRing=dynamic_cast<LinearRing*>(ring->clone());
+			shellPolys[i]=geometryFactory->createPolygon(shellRing, NULL);
+			locators[i]=new locate::IndexedPointInAreaLocator(*shellPolys[i]);
+		}
+		return locators[i]->locate(&pt) != Location::EXTERIOR;
+	}
+
+private:
+
+	/// Minimum number of points for a shell to be given
+	/// an IndexedPointInAreaLocator
+	static const size_t MIN_INDEXED_SHELL_POINTS = 64;
+
+	vector<EdgeRing*>& shells;
+
+	const GeometryFactory* geometryFactory;
+
+	bool indexed;
+
+	index::strtree::STRtree tree;
+
+	vector<Polygon*> shellPolys;
+
+	vector<locate::IndexedPointInAreaLocator*> locators;
+
+	void buildIndex()
+	{
+		shellPolys.assign(shells.size(), 0);
+		locators.assign(shells.size(), 0);
+		for(size_t i=0, n=shells.size(); i<n; ++i)
+		{
+			LinearRing *ring=shells[i]->getLinearRing();
+			tree.insert(ring->getEnvelopeInternal(), &shells[i]);
+		}
+		indexed=true;
+	}
+
+	// Declare type as noncopyable
+	ShellIndex(const ShellIndex& other);
+	ShellIndex& operator=(const ShellIndex& rhs);
+};
+
 /*public*/
 void
 PolygonBuilder::add(PlanarGraph *graph)
@@ -285,15 +389,24 @@ void
 PolygonBuilder::placeFreeHoles(std::vector<EdgeRing*>& newShellList,
 	std::vector<EdgeRing*>& freeHoleList)
 {
+	// Most calls (e.g. one per buffer subgraph) have no hole to
+	// place: don't index the shells for them
+	std::vector<EdgeRing*>::iterator firstFree=freeHoleList.begin();
+	while (firstFree!=freeHoleList.end() && (*firstFree)->getShell()!=NULL)
+		++firstFree;
+	if (firstFree==freeHoleList.end()) return;
+
+	ShellIndex shellIndex(newShellList, geometryFactory);
+
 	for(std::vector<EdgeRing*>::iterator
-			it=freeHoleList.begin(), itEnd=freeHoleList.end();
+			it=firstFree, itEnd=freeHoleList.end();
 			it != itEnd;
 			++it)
 	{
 		EdgeRing *hole=*it;
 		// only place this hole if it doesn't yet have a shell
 		if (hole->getShell()==NULL) {
-			EdgeRing *shell=findEdgeRingContaining(hole, newShellList);
+			EdgeRing *shell=findEdgeRingContaining(hole, shellIndex);
 			if ( shell == NULL )
 			{
 #if GEOS_DEBUG
@@ -327,17 +440,21 @@ PolygonBuilder::placeFreeHoles(std::vector<EdgeRing*>& newShellList,
 /*private*/
 EdgeRing*
 PolygonBuilder::findEdgeRingContaining(EdgeRing *testEr,
-	vector<EdgeRing*>& newShellList)
+	ShellIndex& shellIndex)
 {
 	LinearRing *testRing=testEr->getLinearRing();
 	const Envelope *testEnv=testRing->getEnvelopeInternal();
 	const Coordinate& testPt=testRing->getCoordinateN(0);
 	EdgeRing *minShell=NULL;
 	const Envelope *minEnv=NULL;
-	for(size_t i=0, n=newShellList.size(); i<n; i++)
+
+	vector<size_t> candidates;
+	shellIndex.query(*testEnv, candidates);
+
+	for(size_t i=0, n=candidates.size(); i<n; i++)
 	{
 		LinearRing *lr=NULL;
-		EdgeRing *tryShell=newShellList[i];
+		EdgeRing *tryShell=shellIndex.getShell(candidates[i]);
 		LinearRing *tryRing=tryShell->getLinearRing();
 		const Envelope *tryEnv=tryRing->getEnvelopeInternal();
 		if (minShell!=NULL) {
@@ -345,9 +462,8 @@ PolygonBuilder::findEdgeRingContaining(EdgeRing *testEr,
 			minEnv=lr->getEnvelopeInternal();
 		}
 		bool isContained=false;
-		const CoordinateSequence *rcl = tryRing->getCoordinatesRO();
 		if (tryEnv->contains(testEnv)
-			&& CGAlgorithms::isPointInRing(testPt,rcl))
+			&& shellIndex.isPointInShell(testPt, candidates[i]))
 				isContained=true;
 		// check if this new containing ring is smaller than
 		// the current minimum ring
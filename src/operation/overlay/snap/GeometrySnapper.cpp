@@ -19,6 +19,7 @@
 
 #include <geos/operation/overlay/snap/GeometrySnapper.h>
 #include <geos/operation/overlay/snap/LineStringSnapper.h>
+#include <geos/operation/overlay/snap/SnapPointIndex.h>
 #include <geos/geom/util/GeometryTransformer.h> // inherit. of SnapTransformer
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/Polygon.h>
@@ -50,7 +51,8 @@ private:
 
 	double snapTol;
 
-	const Coordinate::ConstVect& snapPts;
+	// Shared by the snappers of all components
+	SnapPointIndex snapIndex;
 
 	CoordinateSequence::AutoPtr snapLine(
 			const CoordinateSequence* srcPts)
@@ -60,7 +62,7 @@ private:
 		assert(srcPts);
 		assert(srcPts->toVector());
 		LineStringSnapper snapper(*(srcPts->toVector()), snapTol);
-		auto_ptr<Coordinate::Vect> newPts = snapper.snapTo(snapPts);
+		auto_ptr<Coordinate::Vect> newPts = snapper.snapTo(snapIndex);
 
 		const CoordinateSequenceFactory* cfact = factory->getCoordinateSequenceFactory();
 		return auto_ptr<CoordinateSequence>(cfact->create(newPts.release()));
@@ -72,7 +74,7 @@ public:
 			const Coordinate::ConstVect& nSnapPts)
 		:
 		snapTol(nSnapTol),
-		snapPts(nSnapPts)
+		snapIndex(nSnapPts)
 	{
 	}
 
@@ -18,12 +18,18 @@
  **********************************************************************/
 
 #include <geos/operation/overlay/snap/LineStringSnapper.h>
+#include <geos/operation/overlay/snap/SnapPointIndex.h>
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateList.h>
+#include <geos/geom/Envelope.h>
 #include <geos/util/UniqueCoordinateArrayFilter.h>
 #include <geos/geom/LineSegment.h>
+#include <geos/index/strtree/STRtree.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <set>
 #include <vector>
 #include <memory>
 
@@ -48,11 +54,19 @@ namespace snap { // geos.operation.overlay.snap
 /*public*/
 std::auto_ptr<Coordinate::Vect>
 LineStringSnapper::snapTo(const geom::Coordinate::ConstVect& snapPts)
+{
+	SnapPointIndex snapIndex(snapPts);
+	return snapTo(snapIndex);
+}
+
+/*public*/
+std::auto_ptr<Coordinate::Vect>
+LineStringSnapper::snapTo(SnapPointIndex& snapIndex)
 {
 	geom::CoordinateList coordList(srcPts);
 
-	snapVertices(coordList, snapPts);
-	snapSegments(coordList, snapPts);
+	snapVertices(coordList, snapIndex);
+	snapSegments(coordList, snapIndex);
 
 	return coordList.toCoordinateArray();
 }
@@ -60,14 +74,12 @@ LineStringSnapper::snapTo(const geom::Coordinate::ConstVect& snapPts)
 /*private*/
 void
 LineStringSnapper::snapVertices(geom::CoordinateList& srcCoords,
-			const geom::Coordinate::ConstVect& snapPts)
+			SnapPointIndex& snapIndex)
 {
   if ( srcCoords.empty() ) return;
 
 	using geom::CoordinateList;
 
-	geom::Coordinate::ConstVect::const_iterator not_found = snapPts.end();
-
 	// try snapping vertices
 	// if src is a ring then don't snap final vertex
 	CoordinateList::iterator it = srcCoords.begin();
@@ -82,8 +94,8 @@ LineStringSnapper::snapVertices(geom::CoordinateList& srcCoords,
 cerr << "Checking for a snap for source coordinate " << srcPt << endl;
 #endif
 
-		geom::Coordinate::ConstVect::const_iterator found = findSnapForVertex(srcPt, snapPts);
-		if ( found == not_found )
+		const Coordinate* found = findSnapForVertex(srcPt, snapIndex);
+		if ( ! found )
 		{	// no snaps found (or no need to snap)
 #if GEOS_DEBUG
 cerr << "No snap found" << endl;
@@ -91,8 +103,7 @@ cerr << "No snap found" << endl;
 			continue;
 		}
 
-		assert(*found);
-		const Coordinate& snapPt = *(*found);
+		const Coordinate& snapPt = *found;
 		
 #if GEOS_DEBUG
 cerr << "Found snap point " << snapPt << endl;
@@ -114,20 +125,21 @@ cerr << "Source point became " << srcPt << endl;
 }
 
 /*private*/
-Coordinate::ConstVect::const_iterator
+const Coordinate*
 LineStringSnapper::findSnapForVertex(const Coordinate& pt,
-			const Coordinate::ConstVect& snapPts)
+			SnapPointIndex& snapIndex)
 {
-
-	// TODO: use std::find_if
-	Coordinate::ConstVect::const_iterator end=snapPts.end();
-	for ( Coordinate::ConstVect::const_iterator
-			it=snapPts.begin();
-			it != end;
-			++it)
+	// Only points within the tolerance (or equal to pt) can
+	// stop the scan: visit them in snap points order
+	Envelope searchEnv(pt);
+	searchEnv.expandBy(snapTolerance);
+	std::vector<std::size_t> candidates;
+	snapIndex.query(searchEnv, candidates);
+
+	const Coordinate::ConstVect& snapPts = snapIndex.getSnapPoints();
+	for (std::size_t i = 0, n = candidates.size(); i < n; ++i)
 	{
-		assert(*it);
-		const Coordinate& snapPt = *(*it);
+		const Coordinate& snapPt = *snapPts[candidates[i]];
 
 #if GEOS_DEBUG
 cerr << " misuring distance between snap point " << snapPt << " and source point " << pt << endl;
@@ -139,17 +151,16 @@ cerr << " misuring distance between snap point " << snapPt << " and source point
 #if GEOS_DEBUG
 cerr << " points are equal, returning not-found " << endl;
 #endif
-			return end;
-			//continue;
+			return 0;
 		}
 
 		double dist = snapPt.distance(pt);
 		if ( dist < snapTolerance )
 		{
 #if GEOS_DEBUG
-cerr << " points are within distance (" << dist << ") returning iterator to snap point" << endl;
+cerr << " points are within distance (" << dist << ") returning snap point" << endl;
 #endif
-			return it;
+			return &snapPt;
 		}
 	}
 
@@ -157,41 +168,95 @@ cerr << " points are within distance (" << dist << ") returning iterator to snap
 cerr << " No snap point within distance, returning not-found" << endl;
 #endif
 
-	return end;
+	return 0;
 }
 
 
 /*private*/
 void
 LineStringSnapper::snapSegments(geom::CoordinateList& srcCoords,
-			const geom::Coordinate::ConstVect& snapPts)
+			SnapPointIndex& snapIndex)
 {
 
 #if GEOS_DEBUG
 cerr << " Snapping segment from: " << srcCoords << endl;
 #endif
 
-  // nothing to do if there are no source coords..
-  if ( srcCoords.empty() ) return;
+  // nothing to do if there are less than one segment..
+  if ( srcCoords.size() < 2 ) return;
+
+	// Index the segments of the vertex-snapped line.
+	// Snap points are inserted in the list between the vertices
+	// bounding a segment, which keeps the iterators valid:
+	// segment i becomes the chain of sub-segments from
+	// vertices[i] to vertices[i+1].
+	std::vector<CoordinateList::iterator> vertices;
+	for (CoordinateList::iterator it = srcCoords.begin(), end = srcCoords.end();
+			it != end; ++it)
+	{
+		vertices.push_back(it);
+	}
+
+	std::size_t nChains = vertices.size() - 1;
+	std::vector<Envelope> chainEnvs;
+	chainEnvs.reserve(nChains);
+	Envelope lineEnv;
+	for (std::size_t i = 0; i < nChains; ++i)
+	{
+		chainEnvs.push_back(Envelope(*vertices[i], *vertices[i+1]));
+		lineEnv.expandToInclude(&chainEnvs.back());
+	}
+	index::strtree::STRtree chainIndex;
+	for (std::size_t i = 0; i < nChains; ++i)
+	{
+		chainIndex.insert(&chainEnvs[i], &chainEnvs[i]);
+	}
 
-	for ( Coordinate::ConstVect::const_iterator
-			it=snapPts.begin(), end=snapPts.end();
-			it != end;
-			++it)
+	// Max distance of an inserted snap point from the envelope
+	// of its chain: chain queries are widened by it
+	double drift = 0.0;
+
+	// Only snap points within tolerance of the line envelope
+	// can snap. They are processed in snap points order, as the
+	// result depends on it. The envelope grows when a snap point
+	// lying outside of it is inserted: the snap points it
+	// reaches, and which are not processed yet, are added.
+	Envelope searchEnv(lineEnv);
+	searchEnv.expandBy(snapTolerance);
+	std::vector<std::size_t> found;
+	snapIndex.query(searchEnv, found);
+	std::set<std::size_t> pending(found.begin(), found.end());
+
+	const Coordinate::ConstVect& snapPts = snapIndex.getSnapPoints();
+	std::vector<void*> chainsFound;
+	std::vector<std::size_t> chains;
+	while ( ! pending.empty() )
 	{
-		assert(*it);
-		const Coordinate& snapPt = *(*it);
+		std::size_t snapIdx = *pending.begin();
+		pending.erase(pending.begin());
+
+		const Coordinate& snapPt = *snapPts[snapIdx];
 
 #if GEOS_DEBUG
 cerr << "Checking for a segment to snap to snapPt " << snapPt << endl;
 #endif
 
+		Envelope chainSearchEnv(snapPt);
+		chainSearchEnv.expandBy(snapTolerance + drift);
+		chainsFound.clear();
+		chainIndex.query(&chainSearchEnv, chainsFound);
+		chains.clear();
+		for (std::size_t i = 0, n = chainsFound.size(); i < n; ++i)
+		{
+			chains.push_back(static_cast<Envelope*>(chainsFound[i]) - &chainEnvs[0]);
+		}
+		std::sort(chains.begin(), chains.end());
+
 		// shouldn't we look for *all* segments to be snapped
 		// rather then a single one?
-		CoordinateList::iterator too_far = srcCoords.end(); --too_far;
-		CoordinateList::iterator segpos =
-			findSegmentToSnap(snapPt, srcCoords.begin(), too_far);
-		if ( segpos == too_far)
+		CoordinateList::iterator segpos;
+		std::size_t chain;
+		if ( ! findSegmentToSnap(snapPt, vertices, chains, segpos, chain) )
 		{
 #if GEOS_DEBUG
 cerr << " No segment to snap" << endl;
@@ -204,6 +269,24 @@ cerr << " Segment to be snapped found, inserting point" << endl;
 		// insert must happen one-past first point (before next point)
 		++segpos;
 		srcCoords.insert(segpos, snapPt);
+
+		const Envelope& chainEnv = chainEnvs[chain];
+		drift = std::max(drift, chainEnv.getMinX() - snapPt.x);
+		drift = std::max(drift, snapPt.x - chainEnv.getMaxX());
+		drift = std::max(drift, chainEnv.getMinY() - snapPt.y);
+		drift = std::max(drift, snapPt.y - chainEnv.getMaxY());
+
+		if ( ! lineEnv.contains(snapPt) )
+		{
+			lineEnv.expandToInclude(snapPt);
+			searchEnv = lineEnv;
+			searchEnv.expandBy(snapTolerance);
+			found.clear();
+			snapIndex.query(searchEnv, found);
+			std::vector<std::size_t>::iterator
+				next = std::upper_bound(found.begin(), found.end(), snapIdx);
+			pending.insert(next, found.end());
+		}
 	}
 
 #if GEOS_DEBUG
@@ -214,64 +297,77 @@ cerr << " After segment snapping, srcCoors are: " << srcCoords << endl;
 
 /*private*/
 /* NOTE: this is called findSegmentIndexToSnap in JTS */
-CoordinateList::iterator
+bool
 LineStringSnapper::findSegmentToSnap(
 			const Coordinate& snapPt,
-			CoordinateList::iterator from,
-			CoordinateList::iterator too_far)
+			const std::vector<CoordinateList::iterator>& vertices,
+			const std::vector<std::size_t>& chains,
+			CoordinateList::iterator& match,
+			std::size_t& matchChain)
 {
 	LineSegment seg;
 	double minDist = snapTolerance+1; // make sure the first closer then
 	                                  // snapTolerance is accepted
-	CoordinateList::iterator match=too_far;
+	bool matched = false;
 
-	// TODO: use std::find_if
-	for ( ; from != too_far; ++from)
+	// Chains are visited in line order, so that the first of
+	// equally distant segments wins
+	for (std::size_t i = 0, n = chains.size(); i < n; ++i)
 	{
-		seg.p0 = *from; 
-		CoordinateList::iterator to = from;
-		++to;
-		seg.p1 = *to;
+		std::size_t chain = chains[i];
+		CoordinateList::iterator from = vertices[chain];
+		CoordinateList::iterator too_far = vertices[chain+1];
+
+		for ( ; from != too_far; ++from)
+		{
+			seg.p0 = *from; 
+			CoordinateList::iterator to = from;
+			++to;
+			seg.p1 = *to;
 
 #if GEOS_DEBUG
 cerr << " Checking segment " << seg << " for snapping against point " << snapPt << endl;
 #endif
 
-		/**                                                                              * Check if the snap pt is equal to one of
-		 * the segment endpoints.
-		 *
-		 * If the snap pt is already in the src list,
-		 * don't snap at all (unless allowSnappingToSourceVertices
-		 * is set to true)
-		 */
-		if ( seg.p0.equals2D(snapPt) || seg.p1.equals2D(snapPt) )
-		{
+			/**
+			 * Check if the snap pt is equal to one of
+			 * the segment endpoints.
+			 *
+			 * If the snap pt is already in the src list,
+			 * don't snap at all (unless allowSnappingToSourceVertices
+			 * is set to true)
+			 */
+			if ( seg.p0.equals2D(snapPt) || seg.p1.equals2D(snapPt) )
+			{
 
 #if GEOS_DEBUG
-cerr << " One of segment endpoints equal snap point, returning too_far" << endl;
+cerr << " One of segment endpoints equal snap point, returning no match" << endl;
 #endif
-			if (allowSnappingToSourceVertices) {
-				continue;
-			} else {
-				return too_far;
+				if (allowSnappingToSourceVertices) {
+					continue;
+				} else {
+					return false;
+				}
 			}
-		}
 
-		double dist = seg.distance(snapPt);
+			double dist = seg.distance(snapPt);
 #if GEOS_DEBUG
 cerr << " dist=" << dist << " minDist=" << minDist << " snapTolerance=" << snapTolerance << endl;
 #endif
-		if ( dist < minDist && dist < snapTolerance )
-		{
+			if ( dist < minDist && dist < snapTolerance )
+			{
 #if GEOS_DEBUG
 cerr << " Segment/snapPt distance within tolerance and closer then previous match (" << dist << ") " << endl;
 #endif
-			match = from;
-			minDist = dist;
+				match = from;
+				matchChain = chain;
+				minDist = dist;
+				matched = true;
+			}
 		}
 	}
 
-	return match;
+	return matched;
 }
 
 } // namespace geos.operation.snap
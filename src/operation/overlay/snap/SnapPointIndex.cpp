@@ -0,0 +1,69 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/overlay/snap/SnapPointIndex.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Envelope.h>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace overlay { // geos.operation.overlay
+namespace snap { // geos.operation.overlay.snap
+
+/*public*/
+SnapPointIndex::SnapPointIndex(const Coordinate::ConstVect& nSnapPts)
+	:
+	snapPts(nSnapPts),
+	envs()
+{
+	std::size_t n = snapPts.size();
+	envs.reserve(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		assert(snapPts[i]);
+		envs.push_back(Envelope(*snapPts[i]));
+	}
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		tree.insert(&envs[i], &envs[i]);
+	}
+}
+
+/*public*/
+void
+SnapPointIndex::query(const Envelope& searchEnv,
+                      std::vector<std::size_t>& result)
+{
+	if ( envs.empty() ) return;
+
+	std::vector<void*> found;
+	tree.query(&searchEnv, found);
+
+	std::size_t first = result.size();
+	const Envelope* base = &envs[0];
+	for (std::size_t i = 0, n = found.size(); i < n; ++i)
+	{
+		result.push_back(static_cast<Envelope*>(found[i]) - base);
+	}
+	std::sort(result.begin() + first, result.end());
+}
+
+} // namespace geos.operation.overlay.snap
+} // namespace geos.operation.overlay
+} // namespace geos.operation
+} // namespace geos
@@ -0,0 +1,312 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <memory> // for auto_ptr
+#include <cassert> // for assert
+#include <algorithm> // for sort, equal_range
+#include <vector>
+
+#include <geos/operation/union/CoverageUnion.h>
+#include <geos/operation/polygonize/Polygonizer.h>
+#include <geos/algorithm/CGAlgorithms.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/TopologyException.h>
+
+using geos::algorithm::CGAlgorithms;
+using geos::geom::Coordinate;
+using geos::geom::CoordinateSequence;
+using geos::geom::Geometry;
+using geos::geom::LineString;
+using geos::geom::Polygon;
+
+namespace geos {
+namespace operation { // geos::operation
+namespace geounion {  // geos::operation::geounion
+
+namespace {
+
+/*
+ * A segment of an input ring, with its endpoints in
+ * ascending order.
+ */
+struct CoverageSegment {
+
+	const Coordinate* p0;
+
+	const Coordinate* p1;
+
+	/// Whether the polygon is on the right of p0->p1
+	bool coveredOnRight;
+
+	/// Position of the segment in the sequence of all ring segments
+	std::size_t pos;
+
+	CoverageSegment(const Coordinate& a, const Coordinate& b,
+	                bool nCoveredOnRight, std::size_t nPos)
+		:
+		p0(&a),
+		p1(&b),
+		coveredOnRight(nCoveredOnRight),
+		pos(nPos)
+	{
+		if ( p1->compareTo(*p0) < 0 )
+		{
+			std::swap(p0, p1);
+			coveredOnRight = ! coveredOnRight;
+		}
+	}
+
+	bool sameSegment(const CoverageSegment& other) const
+	{
+		return p0->equals2D(*other.p0) && p1->equals2D(*other.p1);
+	}
+};
+
+struct CoverageSegmentLessThen {
+	bool operator() (const CoverageSegment& first,
+	                 const CoverageSegment& second) const
+	{
+		int cmp = first.p0->compareTo(*second.p0);
+		if ( cmp != 0 ) return cmp < 0;
+		return first.p1->compareTo(*second.p1) < 0;
+	}
+};
+
+struct CoordinatePtrLessThen {
+	bool operator() (const Coordinate* first, const Coordinate* second) const
+	{
+		return first->compareTo(*second) < 0;
+	}
+};
+
+/*
+ * Owns the linework handed to the Polygonizer, which keeps
+ * pointers to it.
+ */
+class LineList {
+public:
+	LineList() {}
+	~LineList()
+	{
+		for (std::size_t i=0, n=lines.size(); i<n; ++i) delete lines[i];
+	}
+	std::vector<LineString*> lines;
+private:
+	// Declare type as noncopyable
+	LineList(const LineList& other);
+	LineList& operator=(const LineList& rhs);
+};
+
+/*
+ * Turns a non-empty chain of coordinates into a LineString
+ * and starts a new chain
+ */
+void
+addChain(std::auto_ptr< std::vector<Coordinate> >& chain,
+         const geom::GeometryFactory& gf, std::vector<LineString*>& lines)
+{
+	if ( chain->empty() ) return;
+
+	CoordinateSequence* cs =
+		gf.getCoordinateSequenceFactory()->create(chain.release());
+	lines.push_back(gf.createLineString(cs));
+	chain.reset(new std::vector<Coordinate>());
+}
+
+/*
+ * Appends the segments of a ring to segs, numbering them
+ * from pos, and returns the position following the last one.
+ * Zero-length segments are skipped but get a position.
+ */
+std::size_t
+extractSegments(const CoordinateSequence& pts, bool isHole,
+                std::vector<CoverageSegment>& segs, std::size_t pos)
+{
+	std::size_t n = pts.getSize();
+	if ( n < 2 ) return pos;
+
+	// shells are made clockwise and holes counter-clockwise,
+	// so that the polygon is always on the right
+	bool coveredOnRight = CGAlgorithms::isCCW(&pts) == isHole;
+
+	for (std::size_t i=1; i<n; ++i, ++pos)
+	{
+		const Coordinate& p0 = pts.getAt(i-1);
+		const Coordinate& p1 = pts.getAt(i);
+		if ( p0.equals2D(p1) ) continue;
+		segs.push_back(CoverageSegment(p0, p1, coveredOnRight, pos));
+	}
+	return pos;
+}
+
+} // anonymous namespace
+
+/*public*/
+CoverageUnion::CoverageUnion(const geom::Geometry& geom)
+	:
+	geomFact(geom.getFactory())
+{
+	extract(geom);
+}
+
+/*private*/
+void
+CoverageUnion::extract(const geom::Geometry& geom)
+{
+	if ( const Polygon* poly = dynamic_cast<const Polygon*>(&geom) )
+	{
+		polygons.push_back(poly);
+		return;
+	}
+
+	if ( dynamic_cast<const geom::GeometryCollection*>(&geom) )
+	{
+		for (std::size_t i=0, n=geom.getNumGeometries(); i<n; ++i)
+			extract(*geom.getGeometryN(i));
+		return;
+	}
+
+	if ( geom.isEmpty() ) return;
+
+	throw util::IllegalArgumentException(
+		"CoverageUnion: input components must be polygons");
+}
+
+/*public*/
+std::auto_ptr<geom::Geometry>
+CoverageUnion::Union()
+{
+	// Collect all ring segments, numbered in ring order
+	std::vector<const CoordinateSequence*> rings;
+	std::vector<CoverageSegment> segs;
+	std::size_t numPositions = 0;
+	for (std::size_t i=0, n=polygons.size(); i<n; ++i)
+	{
+		const Polygon* poly = polygons[i];
+		if ( poly->isEmpty() ) continue;
+
+		rings.push_back(poly->getExteriorRing()->getCoordinatesRO());
+		numPositions = extractSegments(*rings.back(), false,
+		                               segs, numPositions);
+		for (std::size_t j=0, nj=poly->getNumInteriorRing(); j<nj; ++j)
+		{
+			rings.push_back(poly->getInteriorRingN(j)->getCoordinatesRO());
+			numPositions = extractSegments(*rings.back(), true,
+			                               segs, numPositions);
+		}
+	}
+
+	// Drop the segments shared by two polygons, keep the others
+	std::sort(segs.begin(), segs.end(), CoverageSegmentLessThen());
+
+	std::vector<bool> kept(numPositions, false);
+	std::vector<CoverageSegment> boundary;
+	std::vector<const Coordinate*> boundaryPts;
+	for (std::size_t i=0, n=segs.size(); i<n; )
+	{
+		std::size_t j = i + 1;
+		while ( j < n && segs[j].sameSegment(segs[i]) ) ++j;
+
+		if ( j == i + 1 )
+		{
+			kept[segs[i].pos] = true;
+			boundary.push_back(segs[i]);
+			boundaryPts.push_back(segs[i].p0);
+			boundaryPts.push_back(segs[i].p1);
+		}
+		else if ( j > i + 2 ||
+		          segs[i].coveredOnRight == segs[i+1].coveredOnRight )
+		{
+			throw util::TopologyException(
+				"CoverageUnion: input is not a valid coverage",
+				*segs[i].p0);
+		}
+		i = j;
+	}
+	std::sort(boundaryPts.begin(), boundaryPts.end(), CoordinatePtrLessThen());
+	typedef std::vector<const Coordinate*>::const_iterator CoordPtrIter;
+
+	// Chain the kept segments of each ring, breaking chains at the
+	// vertices shared by more than two of them so that the
+	// Polygonizer gets correctly noded linework
+	LineList linework;
+	std::auto_ptr< std::vector<Coordinate> > chain(new std::vector<Coordinate>());
+	std::size_t pos = 0;
+	for (std::size_t r=0, nr=rings.size(); r<nr; ++r)
+	{
+		const CoordinateSequence& pts = *rings[r];
+		for (std::size_t i=1, n=pts.getSize(); i<n; ++i, ++pos)
+		{
+			const Coordinate& p0 = pts.getAt(i-1);
+			const Coordinate& p1 = pts.getAt(i);
+			if ( p0.equals2D(p1) ) continue;
+
+			if ( ! kept[pos] )
+			{
+				addChain(chain, *geomFact, linework.lines);
+				continue;
+			}
+
+			if ( chain->empty() ) chain->push_back(p0);
+			chain->push_back(p1);
+
+			std::pair<CoordPtrIter, CoordPtrIter> p1Range =
+				std::equal_range(boundaryPts.begin(), boundaryPts.end(),
+				                 &p1, CoordinatePtrLessThen());
+			if ( p1Range.second - p1Range.first != 2 )
+				addChain(chain, *geomFact, linework.lines);
+		}
+		addChain(chain, *geomFact, linework.lines);
+	}
+
+	polygonize::Polygonizer polygonizer;
+	for (std::size_t i=0, n=linework.lines.size(); i<n; ++i)
+		polygonizer.add(static_cast<const Geometry*>(linework.lines[i]));
+
+	// Keep the faces which are on the covered side of their boundary
+	std::auto_ptr< std::vector<Polygon*> > faces(polygonizer.getPolygons());
+	std::vector<Geometry*>* result = new std::vector<Geometry*>();
+	for (std::size_t i=0, n=faces->size(); i<n; ++i)
+	{
+		Polygon* face = (*faces)[i];
+		const CoordinateSequence* shell =
+			face->getExteriorRing()->getCoordinatesRO();
+
+		// the face is on the right of a clockwise shell
+		CoverageSegment seg(shell->getAt(0), shell->getAt(1),
+		                    ! CGAlgorithms::isCCW(shell), 0);
+
+		std::vector<CoverageSegment>::const_iterator it =
+			std::lower_bound(boundary.begin(), boundary.end(), seg,
+			                 CoverageSegmentLessThen());
+		assert(it != boundary.end() && it->sameSegment(seg));
+
+		if ( it->coveredOnRight == seg.coveredOnRight )
+			result->push_back(face);
+		else
+			delete face;
+	}
+
+	return std::auto_ptr<Geometry>(geomFact->buildGeometry(result));
+}
+
+} // namespace geos::operation::geounion
+} // namespace geos::operation
+} // namespace geos
@@ -18,7 +18,9 @@
 
 #include <memory> // for auto_ptr
 #include <cassert> // for assert
-#include <algorithm> // for copy
+#include <algorithm> // for sort
+#include <typeinfo> // for typeid
+#include <vector>
 #include <geos/operation/union/PointGeometryUnion.h> 
 #include <geos/geom/Coordinate.h> 
 #include <geos/geom/Puntal.h> 
@@ -28,31 +30,130 @@
 #include <geos/geom/Location.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/util/GeometryCombiner.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/util/GeometryExtracter.h>
 #include <geos/algorithm/PointLocator.h>
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/util/UniqueCoordinateArrayFilter.h>
 
 namespace geos {
 namespace operation { // geos::operation
 namespace geounion {  // geos::operation::geounion
 
+namespace {
+
+/*
+ * Flags the coordinates lying in the exterior of geom.
+ *
+ * The polygonal components are tested all at once with an
+ * IndexedPointInAreaLocator, the points left in their exterior
+ * are tested against the other components found in an STRtree
+ * of their envelopes.
+ */
+void
+locateExterior(const geom::Geometry& geom,
+               const std::vector<const geom::Coordinate*>& coords,
+               std::vector<bool>& isExterior)
+{
+  using namespace geom;
+  using geom::util::GeometryExtracter;
+
+  std::size_t n = coords.size();
+  isExterior.assign(n, true);
+  if ( n == 0 || geom.isEmpty() ) return;
+
+  std::vector<const Polygon*> polys;
+  GeometryExtracter::extract<Polygon>(geom, polys);
+
+  std::vector<const Geometry*> others;
+  GeometryExtracter::extract<LineString>(geom, others);
+  GeometryExtracter::extract<Point>(geom, others);
+
+  // IndexedPointInAreaLocator wants a single Polygon or MultiPolygon
+  std::auto_ptr<Geometry> areaGeom;
+  const Geometry* area = 0;
+  if ( typeid(geom) == typeid(Polygon) ||
+       typeid(geom) == typeid(MultiPolygon) )
+  {
+    area = &geom;
+  }
+  else if ( ! polys.empty() )
+  {
+    std::vector<Geometry*>* comps = new std::vector<Geometry*>();
+    for (std::size_t i=0, ni=polys.size(); i<ni; ++i) {
+      if ( ! polys[i]->isEmpty() ) comps->push_back(polys[i]->clone());
+    }
+    areaGeom.reset( geom.getFactory()->createMultiPolygon(comps) );
+    if ( ! areaGeom->isEmpty() ) area = areaGeom.get();
+  }
+
+  if ( area )
+  {
+    std::vector<double> xs(n), ys(n);
+    for (std::size_t i=0; i<n; ++i) {
+      xs[i] = coords[i]->x;
+      ys[i] = coords[i]->y;
+    }
+    std::vector<int> locs(n);
+    algorithm::locate::IndexedPointInAreaLocator locator(*area);
+    locator.locate(n, &xs[0], &ys[0], &locs[0]);
+    for (std::size_t i=0; i<n; ++i) {
+      if ( locs[i] != Location::EXTERIOR ) isExterior[i] = false;
+    }
+  }
+
+  index::strtree::STRtree tree;
+  std::size_t treeSize = 0;
+  for (std::size_t i=0, ni=others.size(); i<ni; ++i) {
+    if ( others[i]->isEmpty() ) continue;
+    tree.insert(others[i]->getEnvelopeInternal(),
+                const_cast<Geometry*>(others[i]));
+    ++treeSize;
+  }
+  if ( ! treeSize ) return;
+
+  algorithm::PointLocator locater;
+  std::vector<void*> hits;
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if ( ! isExterior[i] ) continue;
+    const Coordinate& c = *coords[i];
+    Envelope env(c);
+    hits.clear();
+    tree.query(&env, hits);
+    for (std::size_t j=0, nj=hits.size(); j<nj; ++j) {
+      const Geometry* other = static_cast<const Geometry*>(hits[j]);
+      if ( locater.locate(c, other) != Location::EXTERIOR ) {
+        isExterior[i] = false;
+        break;
+      }
+    }
+  }
+}
+
+} // anonymous namespace
+
 /* public */
 std::auto_ptr<geom::Geometry>
 PointGeometryUnion::Union() const
 {
   using namespace geom;
-  using algorithm::PointLocator;
   using geom::util::GeometryCombiner;
 
-  PointLocator locater;
-  // use a set to eliminate duplicates, as required for union
-  std::set<Coordinate> exteriorCoords;
-
-  for (std::size_t i=0, n=pointGeom.getNumGeometries(); i<n; ++i) {
-      const Point* point = dynamic_cast<const Point*>(pointGeom.getGeometryN(i));
-      assert(point);
-      const Coordinate* coord = point->getCoordinate();
-      int loc = locater.locate(*coord, &otherGeom);
-      if (loc == Location::EXTERIOR)
-              exteriorCoords.insert(*coord);
+  // eliminate duplicates, as required for union
+  std::vector<const Coordinate*> coords;
+  geos::util::UniqueCoordinateArrayFilter filter(coords);
+  pointGeom.apply_ro(&filter);
+
+  std::vector<bool> isExterior;
+  locateExterior(otherGeom, coords, isExterior);
+
+  std::vector<Coordinate> exteriorCoords;
+  for (std::size_t i=0, n=coords.size(); i<n; ++i) {
+    if ( isExterior[i] ) exteriorCoords.push_back(*coords[i]);
   }
 
   // if no points are in exterior, return the other geom
@@ -63,13 +164,14 @@ PointGeometryUnion::Union() const
   std::auto_ptr<Geometry> ptComp;
 
   if (exteriorCoords.size() == 1) {
-    ptComp.reset( geomFact->createPoint(*(exteriorCoords.begin())) );
+    ptComp.reset( geomFact->createPoint(exteriorCoords[0]) );
   }
   else
   {
-    std::vector<Coordinate> coords(exteriorCoords.size());
-    std::copy(exteriorCoords.begin(), exteriorCoords.end(), coords.begin());
-    ptComp.reset( geomFact->createMultiPoint(coords) );
+    // points are output in coordinate order
+    std::sort(exteriorCoords.begin(), exteriorCoords.end(),
+              CoordinateLessThen());
+    ptComp.reset( geomFact->createMultiPoint(exteriorCoords) );
   }
 
   // add point component to the other geometry
@@ -18,13 +18,16 @@
 
 #include <memory> // for auto_ptr
 #include <cassert> // for assert
-#include <algorithm> // for copy
+#include <algorithm> // for copy, stable_sort, find
+#include <map>
+#include <vector>
 
 #include <geos/operation/union/UnaryUnionOp.h> 
 #include <geos/operation/union/CascadedUnion.h> 
 #include <geos/operation/union/CascadedPolygonUnion.h> 
 #include <geos/operation/union/PointGeometryUnion.h> 
 #include <geos/geom/Coordinate.h> 
+#include <geos/platform.h> // for ISNAN
 #include <geos/geom/Puntal.h> 
 #include <geos/geom/Point.h>
 #include <geos/geom/MultiPoint.h>
@@ -35,12 +38,179 @@
 #include <geos/geom/Location.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/util/GeometryCombiner.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/CoordinateSequence.h>
 #include <geos/algorithm/PointLocator.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/IntersectionAdder.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/FastNodingValidator.h>
+#include <geos/noding/OrientedCoordinateArray.h>
+#include <geos/operation/linemerge/LineMerger.h>
 
 namespace geos {
 namespace operation { // geos::operation
 namespace geounion {  // geos::operation::geounion
 
+namespace {
+
+struct OcaCmp {
+  bool operator()(const noding::OrientedCoordinateArray *oca1,
+                  const noding::OrientedCoordinateArray *oca2) const
+  {
+    return oca1->compareTo(*oca2)<0;
+  }
+};
+
+/*
+ * Owns the segment strings given to and returned by the noder
+ */
+class SegmentStringList {
+public:
+  SegmentStringList() {}
+  ~SegmentStringList()
+  {
+    for (std::size_t i=0, n=strings.size(); i<n; ++i) delete strings[i];
+  }
+  std::vector<noding::SegmentString*> strings;
+private:
+  // Declare type as noncopyable
+  SegmentStringList(const SegmentStringList& other);
+  SegmentStringList& operator=(const SegmentStringList& rhs);
+};
+
+} // anonymous namespace
+
+/*private*/
+std::auto_ptr<geom::Geometry>
+UnaryUnionOp::unionPointsBySorting()
+{
+  using geom::Coordinate;
+
+  std::auto_ptr<geom::Geometry> ret;
+
+  std::vector<const Coordinate*> pts;
+  pts.reserve(points.size());
+  for (std::size_t i=0, n=points.size(); i<n; ++i) {
+    const Coordinate* c = points[i]->getCoordinate();
+    if ( c ) pts.push_back(c);
+  }
+  if ( pts.empty() ) return ret;
+
+  // Group the coincident points, keeping them in input order
+  // as overlay nodes are
+  std::stable_sort(pts.begin(), pts.end(), geom::CoordinateLessThen());
+
+  std::vector<Coordinate> coords;
+  std::vector<double> zvals;
+  for (std::size_t i=0, n=pts.size(); i<n; )
+  {
+    Coordinate c = *pts[i];
+
+    // use the average of the distinct Z values, as in Node::addZ
+    zvals.clear();
+    double ztot = 0;
+    std::size_t j = i;
+    for ( ; j<n && pts[j]->compareTo(c) == 0; ++j )
+    {
+      double z = pts[j]->z;
+      if ( ISNAN(z) ) continue;
+      if ( std::find(zvals.begin(), zvals.end(), z) != zvals.end() ) continue;
+      zvals.push_back(z);
+      ztot += z;
+      c.z = ztot / zvals.size();
+    }
+    coords.push_back(c);
+    i = j;
+  }
+
+  if ( coords.size() == 1 )
+    ret.reset( geomFact->createPoint(coords[0]) );
+  else
+    ret.reset( geomFact->createMultiPoint(coords) );
+  return ret;
+}
+
+/*private*/
+std::auto_ptr<geom::Geometry>
+UnaryUnionOp::unionLinesByNoding()
+{
+  using geom::CoordinateSequence;
+  using noding::OrientedCoordinateArray;
+  using noding::SegmentString;
+
+  std::auto_ptr<geom::Geometry> ret;
+
+  SegmentStringList input;
+  for (std::size_t i=0, n=lines.size(); i<n; ++i)
+  {
+    const CoordinateSequence* pts = lines[i]->getCoordinatesRO();
+    if ( pts->isEmpty() ) continue;
+
+    CoordinateSequence* cleanPts =
+      CoordinateSequence::removeRepeatedPoints(pts);
+    // a collapsed line is a point in the union, leave it to overlay
+    if ( cleanPts->getSize() < 2 ) {
+      delete cleanPts;
+      return ret;
+    }
+    input.strings.push_back(new noding::NodedSegmentString(cleanPts, 0));
+  }
+  if ( input.strings.empty() ) return ret;
+
+  // Node all the linework in a single pass
+  algorithm::LineIntersector li;
+  li.setPrecisionModel(geomFact->getPrecisionModel());
+  noding::IntersectionAdder intAdder(li);
+  noding::MCIndexNoder noder(&intAdder);
+  noder.computeNodes(&input.strings);
+
+  SegmentStringList noded;
+  {
+    std::auto_ptr< std::vector<SegmentString*> > nodedSS(
+      noder.getNodedSubstrings() );
+    noded.strings.swap(*nodedSS);
+  }
+
+  // Floating point noding may leave intersections unnoded
+  noding::FastNodingValidator nv(noded.strings);
+  if ( ! nv.isValid() ) return ret;
+
+  // Keep a single copy of duplicated substrings
+  typedef std::map<OrientedCoordinateArray*, SegmentString*, OcaCmp> OcaMap;
+  OcaMap ocaMap;
+  std::vector<geom::Geometry*>* unionLines = new std::vector<geom::Geometry*>();
+  for (std::size_t i=0, n=noded.strings.size(); i<n; ++i)
+  {
+    SegmentString* ss = noded.strings[i];
+    OrientedCoordinateArray* oca =
+      new OrientedCoordinateArray(*ss->getCoordinates());
+    if ( ! ocaMap.insert(OcaMap::value_type(oca, ss)).second ) {
+      delete oca;
+      continue;
+    }
+    unionLines->push_back(
+      geomFact->createLineString(ss->getCoordinates()->clone()) );
+  }
+  for (OcaMap::iterator i=ocaMap.begin(), e=ocaMap.end(); i!=e; ++i)
+    delete i->first;
+
+  if ( mergeLines )
+  {
+    linemerge::LineMerger merger;
+    merger.add(unionLines);
+    std::auto_ptr< std::vector<geom::LineString*> > merged(
+      merger.getMergedLineStrings() );
+    for (std::size_t i=0, n=unionLines->size(); i<n; ++i)
+      delete (*unionLines)[i];
+    unionLines->assign(merged->begin(), merged->end());
+  }
+
+  ret.reset( geomFact->buildGeometry(unionLines) );
+  return ret;
+}
+
 /*private*/
 std::auto_ptr<geom::Geometry>
 UnaryUnionOp::unionWithNull(std::auto_ptr<geom::Geometry> g0,
@@ -75,25 +245,27 @@ UnaryUnionOp::Union()
 
   GeomAutoPtr unionPoints;
   if (!points.empty()) {
-      GeomAutoPtr ptGeom = geomFact->buildGeometry( points.begin(),
-                                                    points.end()    );
-      unionPoints = unionNoOpt(*ptGeom);
+      unionPoints = unionPointsBySorting();
   }
 
   GeomAutoPtr unionLines;
   if (!lines.empty()) {
       /* JTS compatibility NOTE:
-       * we use cascaded here for robustness [1]
-       * but also add a final unionNoOpt step to deal with
-       * self-intersecting lines [2]
+       * lines are unioned by noding them all at once rather
+       * than by overlaying them. If the noding is not robust
+       * we fall back to cascaded overlay [1], with a final
+       * unionNoOpt step to deal with self-intersecting lines [2]
        *
        * [1](http://trac.osgeo.org/geos/ticket/392
        * [2](http://trac.osgeo.org/geos/ticket/482
        *
        */
-      unionLines.reset( CascadedUnion::Union( lines.begin(),
-                                              lines.end()   ) );
-      unionLines = unionNoOpt(*unionLines);
+      unionLines = unionLinesByNoding();
+      if ( ! unionLines.get() ) {
+        unionLines.reset( CascadedUnion::Union( lines.begin(),
+                                                lines.end()   ) );
+        unionLines = unionNoOpt(*unionLines);
+      }
   }
 
   GeomAutoPtr unionPolygons;
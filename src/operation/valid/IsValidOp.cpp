@@ -40,11 +40,16 @@
 #include <geos/geom/Polygon.h>
 #include <geos/geom/MultiPolygon.h>
 #include <geos/geom/GeometryCollection.h>
+#include <geos/geom/Envelope.h>
+#include <geos/index/strtree/STRtree.h>
 
 #include <cassert>
 #include <cmath>
 #include <typeinfo>
 #include <set>
+#include <vector>
+#include <algorithm>
+#include <memory>
 
 using namespace std;
 using namespace geos::algorithm;
@@ -55,6 +60,32 @@ namespace geos {
 namespace operation { // geos.operation
 namespace valid { // geos.operation.valid
 
+namespace {
+
+// Point in ring locators, owned and deleted with the list
+class PointInRingList {
+public:
+	explicit PointInRingList(size_t n)
+		:
+		locators(n, static_cast<PointInRing *>(NULL))
+	{}
+
+	~PointInRingList()
+	{
+		for(size_t i=0, n=locators.size(); i<n; ++i)
+			delete locators[i];
+	}
+
+	vector<PointInRing *> locators;
+
+private:
+	// Declare type as noncopyable
+	PointInRingList(const PointInRingList& other);
+	PointInRingList& operator=(const PointInRingList& rhs);
+};
+
+} // anonymous namespace
+
 /**
  * Find a point from the list of testCoords
  * that is NOT a node in the edge for the list of searchCoords
@@ -405,9 +436,14 @@ IsValidOp::checkHolesInShell(const Polygon *p, GeometryGraph *graph)
 		return;
 	}
 
+	if (nholes==0) return;
+
+	// The shell index is only built if a hole point
+	// falls in the shell envelope
+	const Envelope *shellEnv=shell->getEnvelopeInternal();
 	//SimplePointInRing pir(shell);
 	//SIRtreePointInRing pir(shell);
-	MCPointInRing pir(shell);
+	std::auto_ptr<MCPointInRing> pir;
 
 	for(int i=0; i<nholes; ++i)
 	{
@@ -427,7 +463,11 @@ IsValidOp::checkHolesInShell(const Polygon *p, GeometryGraph *graph)
 		 */
 		if (holePt==NULL) return;
 
-		bool outside = !pir.isInside(*holePt);
+		bool outside = !shellEnv->covers(holePt);
+		if (!outside) {
+			if (!pir.get()) pir.reset(new MCPointInRing(shell));
+			outside = !pir->isInside(*holePt);
+		}
 		if (outside) {
 			validErr=new TopologyValidationError(
 				TopologyValidationError::eHoleOutsideShell,
@@ -474,29 +514,73 @@ IsValidOp::checkHolesNotNested(const Polygon *p, GeometryGraph *graph)
 void
 IsValidOp::checkShellsNotNested(const MultiPolygon *mp, GeometryGraph *graph)
 {
-	for(unsigned int i=0, ngeoms = mp->getNumGeometries(); i<ngeoms; ++i)
+	unsigned int ngeoms = mp->getNumGeometries();
+
+	vector<const Polygon *> polys(ngeoms);
+	// point locators for the polygon shells, built on first use
+	PointInRingList shellLocators(ngeoms);
+	vector<PointInRing *>& locators = shellLocators.locators;
+
+	// A shell can only be nested in polygons whose envelope
+	// intersects its own
+	index::strtree::STRtree tree;
+	for(unsigned int i=0; i<ngeoms; ++i)
 	{
 		const Polygon *p=dynamic_cast<const Polygon *>(
 				mp->getGeometryN(i));
 		assert(p);
+		polys[i]=p;
+		if (p->isEmpty()) continue;
+		tree.insert(p->getExteriorRing()->getEnvelopeInternal(),
+		            &polys[i]);
+	}
+
+	vector<void *> hits;
+	vector<unsigned int> candidates;
+	for(unsigned int i=0; i<ngeoms && validErr==NULL; ++i)
+	{
+		const Polygon *p=polys[i];
 
 		const LinearRing *shell=dynamic_cast<const LinearRing*>(
 				p->getExteriorRing());
 		assert(shell);
 
-		for(unsigned int j=0; j<ngeoms; ++j)
+		if (shell->isEmpty()) continue;
+
+		hits.clear();
+		tree.query(shell->getEnvelopeInternal(), hits);
+
+		// test candidates in order, to report the same
+		// error as a test of all the polygons would
+		candidates.clear();
+		for(size_t k=0, nhits=hits.size(); k<nhits; ++k)
 		{
+			const Polygon **hit=static_cast<const Polygon **>(hits[k]);
+			candidates.push_back(
+				static_cast<unsigned int>(hit - &polys[0]));
+		}
+		sort(candidates.begin(), candidates.end());
+
+		for(size_t k=0, ncand=candidates.size(); k<ncand; ++k)
+		{
+			unsigned int j=candidates[k];
 			if (i==j) continue;
 
-			const Polygon *p2 = dynamic_cast<const Polygon *>(
-					mp->getGeometryN(j));
-			assert(p2);
+			const Polygon *p2 = polys[j];
 
-			if (shell->isEmpty() || p2->isEmpty()) continue;
+			if (p2->isEmpty()) continue;
+
+			if (locators[j]==NULL)
+			{
+				const LinearRing *polyShell=
+					static_cast<const LinearRing*>(
+						p2->getExteriorRing());
+				locators[j]=new MCPointInRing(polyShell);
+			}
 
-			checkShellNotNested(shell, p2, graph);
+			checkShellNotNested(shell, p2, *locators[j], graph);
 
-			if (validErr!=NULL) return;
+			if (validErr!=NULL) break;
 		}
 	}
 }
@@ -504,7 +588,7 @@ IsValidOp::checkShellsNotNested(const MultiPolygon *mp, GeometryGraph *graph)
 /*private*/
 void
 IsValidOp::checkShellNotNested(const LinearRing *shell, const Polygon *p,
-	GeometryGraph *graph)
+	PointInRing& polyShellLocator, GeometryGraph *graph)
 {
 	const CoordinateSequence *shellPts=shell->getCoordinatesRO();
 
@@ -513,14 +597,13 @@ IsValidOp::checkShellNotNested(const LinearRing *shell, const Polygon *p,
 			p->getExteriorRing()));
 	const LinearRing *polyShell=static_cast<const LinearRing*>(
 			p->getExteriorRing());
-	const CoordinateSequence *polyPts=polyShell->getCoordinatesRO();
 	const Coordinate *shellPt=findPtNotNode(shellPts,polyShell,graph);
 
 	// if no point could be found, we can assume that the shell
 	// is outside the polygon
 	if (shellPt==NULL) return;
 
-	bool insidePolyShell=CGAlgorithms::isPointInRing(*shellPt, polyPts);
+	bool insidePolyShell=polyShellLocator.isInside(*shellPt);
 	if (!insidePolyShell) return;
 
 	// if no holes, this is an error!
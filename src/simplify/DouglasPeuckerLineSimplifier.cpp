@@ -18,10 +18,11 @@
 
 #include <geos/simplify/DouglasPeuckerLineSimplifier.h>
 #include <geos/geom/Coordinate.h>
-#include <geos/geom/LineSegment.h>
 
 #include <vector>
+#include <utility> // for pair
 #include <memory> // for auto_ptr
+#include <cmath>
 
 namespace geos {
 
@@ -81,35 +82,83 @@ DouglasPeuckerLineSimplifier::simplify()
 }
 
 /*private*/
-void
-DouglasPeuckerLineSimplifier::simplifySection(
+std::size_t
+DouglasPeuckerLineSimplifier::findFurthestPoint(
 		std::size_t i,
-		std::size_t j)
+		std::size_t j,
+		double& maxDistance) const
 {
-	if ( (i+1) == j ) return;
-
-	geos::geom::LineSegment seg(pts[i], pts[j]);
-	double maxDistance = -1.0;
-
+	// Same computation as geom::LineSegment::distance(), with the
+	// terms depending on the segment only hoisted out of the loop
+	const geom::Coordinate& A = pts[i];
+	const geom::Coordinate& B = pts[j];
+	const double dx = B.x - A.x;
+	const double dy = B.y - A.y;
+	const double len2 = dx * dx + dy * dy;
+	const double len = std::sqrt(len2);
+	const bool degenerate = ( A == B );
+
+	maxDistance = -1.0;
 	std::size_t maxIndex = i;
 
 	for (std::size_t k=i+1; k<j; k++)
 	{
-		double distance = seg.distance(pts[k]);
+		const geom::Coordinate& p = pts[k];
+		double distance;
+		if ( degenerate ) {
+			distance = p.distance(A);
+		}
+		else {
+			double r = ( (p.x - A.x) * dx + (p.y - A.y) * dy ) / len2;
+			if ( r <= 0.0 ) distance = p.distance(A);
+			else if ( r >= 1.0 ) distance = p.distance(B);
+			else {
+				double s = ( (A.y - p.y) * dx - (A.x - p.x) * dy ) / len2;
+				distance = std::fabs(s) * len;
+			}
+		}
+
 		if (distance > maxDistance) {
 			maxDistance = distance;
 			maxIndex = k;
 		}
 	}
-	if (maxDistance <= distanceTolerance) {
-		for(std::size_t k =i+1; k<j; k++)
-		{
-			usePt->operator[](k) = false;
+	return maxIndex;
+}
+
+/*private*/
+void
+DouglasPeuckerLineSimplifier::simplifySection(
+		std::size_t i,
+		std::size_t j)
+{
+	// Sections left to simplify are kept on an explicit stack
+	// rather than recursed into, so that very long lines can
+	// not exhaust the call stack
+	std::vector< std::pair<std::size_t, std::size_t> > sections;
+	sections.push_back(std::make_pair(i, j));
+
+	while ( ! sections.empty() )
+	{
+		i = sections.back().first;
+		j = sections.back().second;
+		sections.pop_back();
+
+		if ( (i+1) == j ) continue;
+
+		double maxDistance;
+		std::size_t maxIndex = findFurthestPoint(i, j, maxDistance);
+
+		if (maxDistance <= distanceTolerance) {
+			for(std::size_t k =i+1; k<j; k++)
+			{
+				usePt->operator[](k) = false;
+			}
+		}
+		else {
+			sections.push_back(std::make_pair(maxIndex, j));
+			sections.push_back(std::make_pair(i, maxIndex));
 		}
-	}
-	else {
-		simplifySection(i, maxIndex);
-		simplifySection(maxIndex, j);
 	}
 }
 
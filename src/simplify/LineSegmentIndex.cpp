@@ -19,103 +19,249 @@
 #include <geos/simplify/LineSegmentIndex.h>
 #include <geos/simplify/TaggedLineSegment.h>
 #include <geos/simplify/TaggedLineString.h>
-#include <geos/index/quadtree/Quadtree.h> 
-#include <geos/index/ItemVisitor.h> 
 #include <geos/geom/LineSegment.h>
-#include <geos/geom/Envelope.h>
 
 #include <vector>
 #include <memory> // for auto_ptr
+#include <algorithm> // for sort, min, max
+#include <cmath> // for sqrt, ceil
 #include <cassert>
 
-#ifndef GEOS_DEBUG
-#define GEOS_DEBUG 0
-#endif
-
-#ifdef GEOS_DEBUG
-#include <iostream>
-#endif
-
 using namespace std;
 using namespace geos::geom;
-using namespace geos::index::quadtree;
 
 namespace geos {
 namespace simplify { // geos::simplify
 
-/**
- * ItemVisitor subclass to reduce volume of query results.
- */
-class LineSegmentVisitor: public index::ItemVisitor {
+namespace {
 
-// MD - only seems to make about a 10% difference in overall time.
+/// Number of children of a packed tree node
+const size_t NODE_CAPACITY = 16;
 
-private:
+/// Number of segments buffered before being packed into a tree
+const size_t MAX_PENDING = 64;
 
-	const LineSegment* querySeg;
+} // anonymous namespace
 
-	auto_ptr< vector<LineSegment*> > items;
+/*
+ * A static R-tree of segments, packed with the Sort-Tile-Recursive
+ * algorithm into flat arrays: the segments, then the bounds of each
+ * level of nodes. Node i of a level covers children
+ * [i*NODE_CAPACITY, (i+1)*NODE_CAPACITY) of the level below.
+ * Removed segments have a null pointer.
+ */
+class LineSegmentIndex::PackedTree {
 
 public:
 
-	LineSegmentVisitor(const LineSegment* s)
+	/// Packs the given items, which are swapped out of nItems
+	PackedTree(vector<Item>& nItems)
 		:
-		ItemVisitor(),
-		querySeg(s),
-		items(new vector<LineSegment*>())
-	{}
+		numDead(0)
+	{
+		items.swap(nItems);
+		build();
+	}
+
+	size_t size() const { return items.size(); }
+
+	size_t deadCount() const { return numDead; }
 
-	virtual ~LineSegmentVisitor()
+	void query(const Item& q, vector<LineSegment*>& result) const
 	{
-		// nothing to do, LineSegments are not owned by us
+		Collector collector(items, result);
+		visitRoot(q, collector);
 	}
 
-	LineSegmentVisitor(const LineSegmentVisitor& o)
-		:
-		ItemVisitor(),
-		querySeg(o.querySeg),
-		items(new vector<LineSegment*>(*(o.items.get())))
+	/// Removes the item of q's segment, if in this tree
+	bool remove(const Item& q)
 	{
+		Finder finder(items, q.seg);
+		if ( ! visitRoot(q, finder) ) return false;
+		items[finder.found].seg = 0;
+		++numDead;
+		return true;
 	}
 
-	LineSegmentVisitor& operator=(const LineSegmentVisitor& o)
+	/// Appends the items not removed to result
+	void getItems(vector<Item>& result) const
 	{
-		if ( this == &o ) return *this;
-		querySeg = o.querySeg;
-		items.reset(new vector<LineSegment*>(*(o.items.get())));
+		for (size_t i=0, n=items.size(); i<n; ++i)
+		{
+			if ( items[i].seg ) result.push_back(items[i]);
+		}
 	}
 
-	void visitItem(void* item)
+	static bool intersects(const Item& a, const Item& b)
 	{
-		LineSegment* seg = (LineSegment*) item;
-		if ( Envelope::intersects(seg->p0, seg->p1,
-				querySeg->p0, querySeg->p1) )
+		return ! ( a.minx > b.maxx || a.maxx < b.minx ||
+		           a.miny > b.maxy || a.maxy < b.miny );
+	}
+
+private:
+
+	vector<Item> items;
+
+	vector< vector<Item> > levels;
+
+	size_t numDead;
+
+	struct CenterXLessThen {
+		bool operator() (const Item& a, const Item& b) const
 		{
-			items->push_back(seg);
+			return a.minx + a.maxx < b.minx + b.maxx;
 		}
+	};
+
+	struct CenterYLessThen {
+		bool operator() (const Item& a, const Item& b) const
+		{
+			return a.miny + a.maxy < b.miny + b.maxy;
+		}
+	};
+
+	struct Collector {
+		const vector<Item>& items;
+		vector<LineSegment*>& result;
+		Collector(const vector<Item>& nItems, vector<LineSegment*>& nResult)
+			: items(nItems), result(nResult) {}
+		bool operator() (size_t i)
+		{
+			result.push_back(const_cast<LineSegment*>(items[i].seg));
+			return false;
+		}
+	};
+
+	struct Finder {
+		const vector<Item>& items;
+		const LineSegment* seg;
+		size_t found;
+		Finder(const vector<Item>& nItems, const LineSegment* nSeg)
+			: items(nItems), seg(nSeg), found(0) {}
+		bool operator() (size_t i)
+		{
+			if ( items[i].seg != seg ) return false;
+			found = i;
+			return true;
+		}
+	};
+
+	void build()
+	{
+		size_t n = items.size();
+		if ( ! n ) return;
+
+		// Sort by x into vertical slices, then each slice by y
+		size_t numLeaves = (n + NODE_CAPACITY - 1) / NODE_CAPACITY;
+		size_t numSlices = static_cast<size_t>(
+			std::ceil(std::sqrt(static_cast<double>(numLeaves))) );
+		size_t sliceSize = NODE_CAPACITY *
+			( (numLeaves + numSlices - 1) / numSlices );
+
+		std::sort(items.begin(), items.end(), CenterXLessThen());
+		for (size_t start=0; start<n; start+=sliceSize)
+		{
+			size_t end = std::min(start + sliceSize, n);
+			std::sort(items.begin() + start, items.begin() + end,
+			          CenterYLessThen());
+		}
+
+		// Compute node bounds up to a single root
+		do
+		{
+			const vector<Item>& children =
+				levels.empty() ? items : levels.back();
+			vector<Item> level;
+			level.reserve(children.size() / NODE_CAPACITY + 1);
+			for (size_t i=0, nc=children.size(); i<nc; i+=NODE_CAPACITY)
+			{
+				Item bounds = children[i];
+				bounds.seg = 0;
+				size_t end = std::min(i + NODE_CAPACITY, nc);
+				for (size_t j=i+1; j<end; ++j)
+				{
+					const Item& c = children[j];
+					bounds.minx = std::min(bounds.minx, c.minx);
+					bounds.miny = std::min(bounds.miny, c.miny);
+					bounds.maxx = std::max(bounds.maxx, c.maxx);
+					bounds.maxy = std::max(bounds.maxy, c.maxy);
+				}
+				level.push_back(bounds);
+			}
+			levels.push_back(vector<Item>());
+			levels.back().swap(level);
+		}
+		while ( levels.back().size() > 1 );
 	}
 
-	auto_ptr< vector<LineSegment*> > getItems()
+	/*
+	 * Calls visitor with the index of each live item intersecting q,
+	 * until it returns true. Returns true if the visit was stopped.
+	 */
+	template <class Visitor>
+	bool visitRoot(const Item& q, Visitor& visitor) const
 	{
-		return items;
+		if ( levels.empty() ) return false;
+		const vector<Item>& root = levels.back();
+		for (size_t i=0, n=root.size(); i<n; ++i)
+		{
+			if ( intersects(root[i], q) &&
+			     visit(levels.size() - 1, i, q, visitor) )
+				return true;
+		}
+		return false;
 	}
 
+	template <class Visitor>
+	bool visit(size_t level, size_t node, const Item& q,
+	           Visitor& visitor) const
+	{
+		const vector<Item>& children = level ? levels[level-1] : items;
+		size_t start = node * NODE_CAPACITY;
+		size_t end = std::min(start + NODE_CAPACITY, children.size());
+		for (size_t i=start; i<end; ++i)
+		{
+			const Item& c = children[i];
+			if ( ! intersects(c, q) ) continue;
+			if ( level ) {
+				if ( visit(level - 1, i, q, visitor) ) return true;
+			}
+			else if ( c.seg && visitor(i) ) {
+				return true;
+			}
+		}
+		return false;
+	}
 
+	// Declare type as noncopyable
+	PackedTree(const PackedTree& other);
+	PackedTree& operator=(const PackedTree& rhs);
 };
 
+/*private static*/
+LineSegmentIndex::Item
+LineSegmentIndex::makeItem(const LineSegment* seg)
+{
+	Item item;
+	item.minx = std::min(seg->p0.x, seg->p1.x);
+	item.maxx = std::max(seg->p0.x, seg->p1.x);
+	item.miny = std::min(seg->p0.y, seg->p1.y);
+	item.maxy = std::max(seg->p0.y, seg->p1.y);
+	item.seg = seg;
+	return item;
+}
+
 /*public*/
 LineSegmentIndex::LineSegmentIndex()
-	:
-	index(new Quadtree())
 {
 }
 
 /*public*/
 LineSegmentIndex::~LineSegmentIndex()
 {
-	for (size_t i=0, n=newEnvelopes.size(); i<n; ++i)
+	for (size_t i=0, n=trees.size(); i<n; ++i)
 	{
-		delete newEnvelopes[i];
+		delete trees[i];
 	}
 }
 
@@ -135,36 +281,84 @@ LineSegmentIndex::add(const TaggedLineString& line)
 void
 LineSegmentIndex::add(const LineSegment* seg)
 {
-	Envelope* env = new Envelope(seg->p0, seg->p1);
-	newEnvelopes.push_back(env);
+	pending.push_back(makeItem(seg));
+}
 
-	// We need a cast because index wants a non-const,
-	// altought it won't change the argument
-	index->insert(env, (LineSegment*)seg);
+/*private*/
+void
+LineSegmentIndex::flush() const
+{
+	if ( pending.size() <= MAX_PENDING ) return;
+
+	// Merge the trees not larger than the new one into it
+	vector<Item> merged;
+	merged.swap(pending);
+	while ( ! trees.empty() && trees.back()->size() <= merged.size() )
+	{
+		trees.back()->getItems(merged);
+		delete trees.back();
+		trees.pop_back();
+	}
+	trees.push_back(new PackedTree(merged));
 }
 
 /*public*/
 void
 LineSegmentIndex::remove(const LineSegment* seg)
 {
-	Envelope env(seg->p0, seg->p1);
+	flush();
+
+	for (size_t i=0, n=pending.size(); i<n; ++i)
+	{
+		if ( pending[i].seg != seg ) continue;
+		pending[i] = pending.back();
+		pending.pop_back();
+		return;
+	}
+
+	Item key = makeItem(seg);
+	for (size_t i=0, n=trees.size(); i<n; ++i)
+	{
+		PackedTree* tree = trees[i];
+		if ( ! tree->remove(key) ) continue;
+
+		// repack trees made mostly of removed segments
+		if ( 2 * tree->deadCount() > tree->size() )
+		{
+			vector<Item> live;
+			tree->getItems(live);
+			delete tree;
+			trees[i] = new PackedTree(live);
+		}
+		return;
+	}
+}
+
+/*public*/
+void
+LineSegmentIndex::query(const LineSegment* querySeg,
+		vector<LineSegment*>& result) const
+{
+	flush();
 
-	// We need a cast because index wants a non-const
-	// altought it won't change the argument
-	index->remove(&env, (LineSegment*)seg);
+	Item q = makeItem(querySeg);
+	for (size_t i=0, n=pending.size(); i<n; ++i)
+	{
+		if ( PackedTree::intersects(pending[i], q) )
+			result.push_back(const_cast<LineSegment*>(pending[i].seg));
+	}
+	for (size_t i=0, n=trees.size(); i<n; ++i)
+	{
+		trees[i]->query(q, result);
+	}
 }
 
 /*public*/
 auto_ptr< vector<LineSegment*> > 
 LineSegmentIndex::query(const LineSegment* querySeg) const
 {
-	Envelope env(querySeg->p0, querySeg->p1);
-
-	LineSegmentVisitor visitor(querySeg);
-	index->query(&env, visitor);
-
-	auto_ptr< vector<LineSegment*> > itemsFound = visitor.getItems();
-
+	auto_ptr< vector<LineSegment*> > itemsFound(new vector<LineSegment*>());
+	query(querySeg, *itemsFound);
 	return itemsFound;
 }
 
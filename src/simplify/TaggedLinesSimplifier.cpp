@@ -19,7 +19,11 @@
 #include <geos/simplify/TaggedLinesSimplifier.h>
 #include <geos/simplify/LineSegmentIndex.h>
 #include <geos/simplify/TaggedLineStringSimplifier.h>
+#include <geos/simplify/TaggedLineString.h>
 #include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/LineString.h>
+#include <geos/index/strtree/STRtree.h>
 
 #include <cassert>
 #include <algorithm>
@@ -63,6 +67,72 @@ TaggedLinesSimplifier::simplify(TaggedLineString& tls)
 	taggedlineSimplifier->simplify(&tls);
 }
 
+namespace {
+
+// Root of a union-find set, halving the path on the way
+size_t
+findRoot(vector<size_t>& parent, size_t i)
+{
+	while (parent[i] != i)
+	{
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
+
+} // anonymous namespace
+
+/*public static*/
+void
+TaggedLinesSimplifier::computeClusters(const vector<TaggedLineString*>& lines,
+		vector< vector<size_t> >& clusters)
+{
+	size_t n = lines.size();
+	if ( ! n ) return;
+
+	// The tree items are the line positions
+	vector<size_t> positions(n);
+	vector<const Envelope*> envs(n);
+	index::strtree::STRtree tree;
+	for (size_t i=0; i<n; ++i)
+	{
+		positions[i] = i;
+		envs[i] = lines[i]->getParent()->getEnvelopeInternal();
+		tree.insert(envs[i], &positions[i]);
+	}
+
+	// Join each line with the lines whose envelope intersects it,
+	// keeping the lowest position as root
+	vector<size_t> parent(positions);
+	vector<void*> found;
+	for (size_t i=0; i<n; ++i)
+	{
+		found.clear();
+		tree.query(envs[i], found);
+		for (size_t j=0, nf=found.size(); j<nf; ++j)
+		{
+			size_t ri = findRoot(parent, i);
+			size_t rj = findRoot(parent, *static_cast<size_t*>(found[j]));
+			if (ri < rj) parent[rj] = ri;
+			else if (rj < ri) parent[ri] = rj;
+		}
+	}
+
+	// Roots are the first line of their cluster
+	vector<size_t> clusterOf(n);
+	for (size_t i=0; i<n; ++i)
+	{
+		size_t r = findRoot(parent, i);
+		if (r == i)
+		{
+			clusterOf[i] = clusters.size();
+			clusters.push_back(vector<size_t>());
+		}
+		clusters[clusterOf[r]].push_back(i);
+	}
+}
+
 } // namespace geos::simplify
 } // namespace geos
 
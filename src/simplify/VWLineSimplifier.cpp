@@ -0,0 +1,238 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/simplify/VWLineSimplifier.h>
+#include <geos/geom/Coordinate.h>
+
+#include <vector>
+#include <memory> // for auto_ptr
+#include <limits>
+#include <cmath>
+
+namespace geos {
+namespace simplify { // geos::simplify
+
+namespace {
+
+const std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+double
+triangleArea(const geom::Coordinate& a, const geom::Coordinate& b,
+             const geom::Coordinate& c)
+{
+	return std::fabs( (b.x - a.x) * (c.y - a.y) -
+	                  (c.x - a.x) * (b.y - a.y) ) / 2.0;
+}
+
+/*
+ * A binary min-heap of the interior vertices of a line, ordered by
+ * the area of the triangle they form with their current neighbours,
+ * and indexed by vertex so that the areas can be updated when a
+ * neighbour is eliminated.
+ * Ties are broken by vertex index, to keep the result deterministic.
+ */
+class VertexHeap {
+public:
+
+	VertexHeap(const std::vector<double>& nAreas)
+		:
+		areas(nAreas),
+		pos(nAreas.size(), NONE)
+	{}
+
+	void push(std::size_t v)
+	{
+		pos[v] = heap.size();
+		heap.push_back(v);
+		siftUp(pos[v]);
+	}
+
+	bool empty() const { return heap.empty(); }
+
+	std::size_t pop()
+	{
+		std::size_t top = heap[0];
+		std::size_t last = heap.back();
+		heap.pop_back();
+		pos[top] = NONE;
+		if ( ! heap.empty() )
+		{
+			heap[0] = last;
+			pos[last] = 0;
+			siftDown(0);
+		}
+		return top;
+	}
+
+	/// To be called after the area of vertex v changed
+	void update(std::size_t v)
+	{
+		std::size_t i = pos[v];
+		if ( i == NONE ) return;
+		siftUp(i);
+		siftDown(pos[v]);
+	}
+
+private:
+
+	const std::vector<double>& areas;
+	std::vector<std::size_t> heap;
+	std::vector<std::size_t> pos;
+
+	bool less(std::size_t v1, std::size_t v2) const
+	{
+		if ( areas[v1] != areas[v2] ) return areas[v1] < areas[v2];
+		return v1 < v2;
+	}
+
+	void place(std::size_t i, std::size_t v)
+	{
+		heap[i] = v;
+		pos[v] = i;
+	}
+
+	void siftUp(std::size_t i)
+	{
+		std::size_t v = heap[i];
+		while ( i > 0 )
+		{
+			std::size_t parent = (i - 1) / 2;
+			if ( ! less(v, heap[parent]) ) break;
+			place(i, heap[parent]);
+			i = parent;
+		}
+		place(i, v);
+	}
+
+	void siftDown(std::size_t i)
+	{
+		std::size_t v = heap[i];
+		std::size_t n = heap.size();
+		for (;;)
+		{
+			std::size_t child = 2 * i + 1;
+			if ( child >= n ) break;
+			if ( child + 1 < n && less(heap[child + 1], heap[child]) )
+				++child;
+			if ( ! less(heap[child], v) ) break;
+			place(i, heap[child]);
+			i = child;
+		}
+		place(i, v);
+	}
+
+	// Declare type as noncopyable
+	VertexHeap(const VertexHeap& other);
+	VertexHeap& operator=(const VertexHeap& rhs);
+};
+
+} // anonymous namespace
+
+/*public static*/
+VWLineSimplifier::AreasVectAutoPtr
+VWLineSimplifier::getEffectiveAreas(const CoordsVect& pts)
+{
+	std::size_t n = pts.size();
+	AreasVectAutoPtr effective(new AreasVect(n,
+		std::numeric_limits<double>::infinity()));
+	if ( n < 3 ) return effective;
+
+	// doubly linked list of the vertices left
+	std::vector<std::size_t> prev(n), next(n);
+	std::vector<double> areas(n, 0.0);
+	for (std::size_t i=0; i<n; ++i)
+	{
+		prev[i] = i - 1;
+		next[i] = i + 1;
+	}
+
+	VertexHeap heap(areas);
+	for (std::size_t i=1; i<n-1; ++i)
+	{
+		areas[i] = triangleArea(pts[i-1], pts[i], pts[i+1]);
+		heap.push(i);
+	}
+
+	double lastArea = 0.0;
+	while ( ! heap.empty() )
+	{
+		std::size_t v = heap.pop();
+
+		// a vertex can not be less significant than
+		// the ones eliminated before it
+		double area = areas[v];
+		if ( area < lastArea ) area = lastArea;
+		(*effective)[v] = area;
+		lastArea = area;
+
+		std::size_t p = prev[v];
+		std::size_t nx = next[v];
+		next[p] = nx;
+		prev[nx] = p;
+
+		if ( p > 0 )
+		{
+			areas[p] = triangleArea(pts[prev[p]], pts[p], pts[nx]);
+			heap.update(p);
+		}
+		if ( nx < n-1 )
+		{
+			areas[nx] = triangleArea(pts[p], pts[nx], pts[next[nx]]);
+			heap.update(nx);
+		}
+	}
+
+	return effective;
+}
+
+/*public static*/
+VWLineSimplifier::CoordsVectAutoPtr
+VWLineSimplifier::simplify(const CoordsVect& pts, const AreasVect& areas,
+		double distanceTolerance)
+{
+	double areaTolerance = distanceTolerance * distanceTolerance;
+
+	CoordsVectAutoPtr coordList(new CoordsVect());
+	for (std::size_t i=0, n=pts.size(); i<n; ++i)
+	{
+		if ( areas[i] >= areaTolerance ) coordList->push_back(pts[i]);
+	}
+	return coordList;
+}
+
+/*public static*/
+VWLineSimplifier::CoordsVectAutoPtr
+VWLineSimplifier::simplify(const CoordsVect& nPts, double distanceTolerance)
+{
+	VWLineSimplifier simp(nPts, distanceTolerance);
+	return simp.simplify();
+}
+
+/*public*/
+VWLineSimplifier::VWLineSimplifier(const CoordsVect& nPts,
+		double nDistanceTolerance)
+	:
+	pts(nPts),
+	distanceTolerance(nDistanceTolerance)
+{
+}
+
+/*public*/
+VWLineSimplifier::CoordsVectAutoPtr
+VWLineSimplifier::simplify()
+{
+	AreasVectAutoPtr areas = getEffectiveAreas(pts);
+	return simplify(pts, *areas, distanceTolerance);
+}
+
+} // namespace geos::simplify
+} // namespace geos
@@ -0,0 +1,162 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/simplify/VWSimplifier.h>
+#include <geos/simplify/VWLineSimplifier.h>
+#include <geos/geom/Geometry.h> // for AutoPtr typedefs
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/CoordinateSequence.h> // for AutoPtr typedefs
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/util/GeometryTransformer.h> // for VWTransformer inheritance
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util.h>
+
+#include <memory> // for auto_ptr
+#include <cassert>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace simplify { // geos::simplify
+
+namespace {
+
+class VWTransformer: public geom::util::GeometryTransformer {
+
+public:
+
+	VWTransformer(double tolerance);
+
+protected:
+
+	CoordinateSequence::AutoPtr transformCoordinates(
+			const CoordinateSequence* coords,
+			const Geometry* parent);
+
+	Geometry::AutoPtr transformPolygon(
+			const Polygon* geom,
+			const Geometry* parent);
+
+	Geometry::AutoPtr transformMultiPolygon(
+			const MultiPolygon* geom,
+			const Geometry* parent);
+
+private:
+
+	/*
+	 * Creates a valid area geometry from one that possibly has
+	 * bad topology (i.e. self-intersections), by buffering it
+	 * by zero, as in DouglasPeuckerSimplifier.
+	 */
+	Geometry::AutoPtr createValidArea(const Geometry* roughAreaGeom);
+
+	double distanceTolerance;
+
+};
+
+VWTransformer::VWTransformer(double t)
+	:
+	distanceTolerance(t)
+{
+}
+
+Geometry::AutoPtr
+VWTransformer::createValidArea(const Geometry* roughAreaGeom)
+{
+	return Geometry::AutoPtr(roughAreaGeom->buffer(0.0));
+}
+
+CoordinateSequence::AutoPtr
+VWTransformer::transformCoordinates(
+		const CoordinateSequence* coords,
+		const Geometry* parent)
+{
+	::geos::ignore_unused_variable_warning(parent);
+
+	const Coordinate::Vect* inputPts = coords->toVector();
+	assert(inputPts);
+
+	std::auto_ptr<Coordinate::Vect> newPts =
+			VWLineSimplifier::simplify(*inputPts, distanceTolerance);
+
+	return CoordinateSequence::AutoPtr(
+		factory->getCoordinateSequenceFactory()->create(
+			newPts.release()
+		));
+}
+
+Geometry::AutoPtr
+VWTransformer::transformPolygon(
+		const Polygon* geom,
+		const Geometry* parent)
+{
+	Geometry::AutoPtr roughGeom(GeometryTransformer::transformPolygon(geom, parent));
+
+	// don't try and correct if the parent is going to do this
+	if ( dynamic_cast<const MultiPolygon*>(parent) )
+	{
+		return roughGeom;
+	}
+
+	return createValidArea(roughGeom.get());
+}
+
+Geometry::AutoPtr
+VWTransformer::transformMultiPolygon(
+		const MultiPolygon* geom,
+		const Geometry* parent)
+{
+	Geometry::AutoPtr roughGeom(GeometryTransformer::transformMultiPolygon(geom, parent));
+	return createValidArea(roughGeom.get());
+}
+
+} // anonymous namespace
+
+/************************************************************************/
+
+/*public static*/
+Geometry::AutoPtr
+VWSimplifier::simplify(const Geometry* geom, double tolerance)
+{
+	VWSimplifier simp(geom);
+	simp.setDistanceTolerance(tolerance);
+	return simp.getResultGeometry();
+}
+
+/*public*/
+VWSimplifier::VWSimplifier(const Geometry* geom)
+	:
+	inputGeom(geom),
+	distanceTolerance(0.0)
+{
+}
+
+/*public*/
+void
+VWSimplifier::setDistanceTolerance(double tol)
+{
+	if (tol < 0.0)
+		throw util::IllegalArgumentException("Tolerance must be non-negative");
+	distanceTolerance = tol;
+}
+
+/*public*/
+Geometry::AutoPtr
+VWSimplifier::getResultGeometry()
+{
+	VWTransformer t(distanceTolerance);
+	return t.transform(inputGeom);
+}
+
+} // namespace geos::simplify
+} // namespace geos
@@ -0,0 +1,112 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/util/UniqueCoordinateArrayFilter.h>
+#include <geos/geom/Coordinate.h>
+
+#include <cstring> // for memcpy
+#include <vector>
+
+using geos::geom::Coordinate;
+
+namespace geos {
+namespace util { // geos.util
+
+namespace {
+
+const std::size_t minTableSize = 16;
+
+bool
+sameOrdinate(double a, double b)
+{
+	// NaN ordinates match each other, so that they are not
+	// all kept as distinct points
+	return a == b || ( a != a && b != b );
+}
+
+bool
+sameXY(const Coordinate& a, const Coordinate& b)
+{
+	return sameOrdinate(a.x, b.x) && sameOrdinate(a.y, b.y);
+}
+
+unsigned int
+mix(unsigned int h, double d)
+{
+	// -0.0 equals 0.0, so it must hash the same
+	if ( d == 0.0 ) d = 0.0;
+
+	unsigned int words[sizeof(double) / sizeof(unsigned int)];
+	std::memcpy(words, &d, sizeof(words));
+	for (std::size_t i=0; i<sizeof(words)/sizeof(unsigned int); ++i)
+	{
+		h ^= words[i];
+		h *= 16777619u;
+		h ^= h >> 15;
+	}
+	return h;
+}
+
+} // anonymous namespace
+
+/*private static*/
+std::size_t
+UniqueCoordinateArrayFilter::hash(const Coordinate& c)
+{
+	unsigned int h = mix(mix(2166136261u, c.x), c.y);
+	// spread the high bits to the low ones used as table index
+	h ^= h >> 13;
+	h *= 0x5bd1e995u;
+	h ^= h >> 16;
+	return h;
+}
+
+/*private*/
+void
+UniqueCoordinateArrayFilter::grow()
+{
+	std::size_t newSize = table.empty() ? minTableSize : table.size() * 2;
+	std::vector<const Coordinate*> newTable(newSize,
+	                                        static_cast<const Coordinate*>(0));
+	std::size_t mask = newSize - 1;
+	for (std::size_t i=0, n=table.size(); i<n; ++i)
+	{
+		const Coordinate* c = table[i];
+		if ( ! c ) continue;
+		std::size_t j = hash(*c) & mask;
+		while ( newTable[j] ) j = (j + 1) & mask;
+		newTable[j] = c;
+	}
+	table.swap(newTable);
+}
+
+/*public*/
+void
+UniqueCoordinateArrayFilter::filter_ro(const Coordinate *coord)
+{
+	// keep the load factor at most 1/2
+	if ( 2 * (tableCount + 1) > table.size() ) grow();
+
+	std::size_t mask = table.size() - 1;
+	std::size_t i = hash(*coord) & mask;
+	while ( const Coordinate* c = table[i] )
+	{
+		if ( sameXY(*c, *coord) ) return;
+		i = (i + 1) & mask;
+	}
+	table[i] = coord;
+	++tableCount;
+	pts.push_back(coord);
+}
+
+} // namespace geos.util
+} // namespace geos
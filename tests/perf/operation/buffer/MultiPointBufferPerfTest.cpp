@@ -0,0 +1,87 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.refractions.net
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Times the buffer of MultiPoints of disjoint points.
+ *
+ * Each point buffer is a subgraph of its own, so this shows costs
+ * growing with the number of subgraphs (depth location, polygon
+ * building). The time per point should stay about the same as the
+ * number of points grows.
+ *
+ **********************************************************************/
+
+
+#include <geos/geom/PrecisionModel.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/profiler.h>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <memory>
+
+using namespace geos::geom;
+using namespace std;
+
+class MultiPointBufferPerfTest
+{
+public:
+  MultiPointBufferPerfTest()
+    :
+    pm(),
+    fact(&pm, 0)
+  {}
+
+  void test(int nPts)
+  {
+    auto_ptr<Geometry> mp ( createGrid(nPts) );
+
+    geos::util::Profile sw("");
+    sw.start();
+
+    auto_ptr<Geometry> buf ( mp->buffer(1.0) );
+
+    sw.stop();
+    cout << nPts << " points: " << buf->getNumGeometries()
+         << " polygons, " << sw.getTot() << " usecs" << endl;
+  }
+
+private:
+
+  PrecisionModel pm;
+  GeometryFactory fact;
+
+  // Points on a square grid, 4 units apart
+  Geometry* createGrid(int nPts)
+  {
+    int nSide = 1 + (int)sqrt((double) nPts);
+    vector<Coordinate> coords;
+    coords.reserve(nPts);
+    for (int i = 0; i < nPts; i++) {
+      coords.push_back(Coordinate(4.0 * (i % nSide), 4.0 * (i / nSide)));
+    }
+    return fact.createMultiPoint(coords);
+  }
+};
+
+int
+main()
+{
+
+  MultiPointBufferPerfTest tester;
+
+  tester.test(5000);
+  tester.test(10000);
+  tester.test(20000);
+}
+
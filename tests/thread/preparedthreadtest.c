@@ -0,0 +1,202 @@
+/************************************************************************
+ *
+ *
+ * Multithreaded test for frozen prepared geometries of the C-Wrapper
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ * A polygon and a multilinestring are prepared and frozen once, then
+ * several threads evaluate prepared predicates on them concurrently,
+ * each with its own context handle and test geometries, and compare
+ * the results with the ones of the unprepared predicates.
+ *
+ ***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <pthread.h>
+
+#include "geos_c.h"
+
+#define NTHREADS 8
+#define NROUNDS 4
+#define NPREDICATES 4
+#define MAXTESTWKTLEN 128
+
+typedef struct
+{
+	char wkt[MAXTESTWKTLEN];
+	char expected[NPREDICATES];
+} TestCase;
+
+static const GEOSPreparedGeometry *prepArea;
+static const GEOSPreparedGeometry *prepLines;
+static TestCase *tests;
+static int ntests;
+
+typedef struct
+{
+	int id;
+	int failures;
+} ThreadData;
+
+void
+notice(const char *fmt, ...)
+{
+	va_list ap;
+
+	fprintf( stdout, "NOTICE: ");
+
+	va_start (ap, fmt);
+	vfprintf( stdout, fmt, ap);
+	va_end(ap);
+	fprintf( stdout, "\n" );
+}
+
+void
+log_and_exit(const char *fmt, ...)
+{
+	va_list ap;
+
+	fprintf( stdout, "ERROR: ");
+
+	va_start (ap, fmt);
+	vfprintf( stdout, fmt, ap);
+	va_end(ap);
+	fprintf( stdout, "\n" );
+	exit(1);
+}
+
+void *
+threadfunc(void *arg)
+{
+	ThreadData *data = (ThreadData *)arg;
+	GEOSContextHandle_t handle;
+	GEOSGeometry **geoms;
+	char results[NPREDICATES];
+	int round, i, j, k;
+
+	handle = initGEOS_r(notice, notice);
+
+	geoms = malloc(ntests * sizeof(GEOSGeometry *));
+	for (i=0; i<ntests; i++)
+	{
+		geoms[i] = GEOSGeomFromWKT_r(handle, tests[i].wkt);
+		if ( ! geoms[i] ) log_and_exit("Could not parse %s", tests[i].wkt);
+	}
+
+	/* Each thread starts from a different test, so that threads
+	 * hit different parts of the indexes at the same time */
+	for (round=0; round<NROUNDS; round++)
+	{
+		for (j=0; j<ntests; j++)
+		{
+			i = (j + data->id * ntests / NTHREADS) % ntests;
+			results[0] = GEOSPreparedIntersects_r(handle, prepArea, geoms[i]);
+			results[1] = GEOSPreparedContains_r(handle, prepArea, geoms[i]);
+			results[2] = GEOSPreparedCovers_r(handle, prepArea, geoms[i]);
+			results[3] = GEOSPreparedIntersects_r(handle, prepLines, geoms[i]);
+			for (k=0; k<NPREDICATES; k++)
+			{
+				if ( results[k] == tests[i].expected[k] ) continue;
+				fprintf(stdout, "Thread %d: predicate %d of %s "
+				        "gave %d, expected %d\n", data->id, k,
+				        tests[i].wkt, results[k], tests[i].expected[k]);
+				data->failures++;
+			}
+		}
+	}
+
+	for (i=0; i<ntests; i++) GEOSGeom_destroy_r(handle, geoms[i]);
+	free(geoms);
+
+	finishGEOS_r(handle);
+	return NULL;
+}
+
+int
+main(int argc, char **argv)
+{
+	GEOSContextHandle_t handle;
+	GEOSGeometry *lines, *area, *g;
+	pthread_t threads[NTHREADS];
+	ThreadData data[NTHREADS];
+	int failures = 0;
+	int nx, ny, x, y, i;
+
+	(void)argc;
+	(void)argv;
+
+	handle = initGEOS_r(notice, log_and_exit);
+
+	/* A closed ring and a zigzag: the buffer has a hole and
+	 * many vertices */
+	lines = GEOSGeomFromWKT_r(handle, "MULTILINESTRING((0 0, 0 40, 40 40, 40 0, 0 0), (0 20, 10 50, 20 20, 30 50, 40 20, 50 50))");
+	area = GEOSBuffer_r(handle, lines, 3, 16);
+	if ( ! lines || ! area ) log_and_exit("Could not build the base geometries");
+
+	/* Points and short lines on a grid covering the base geometries,
+	 * with the results of the unprepared predicates */
+	nx = 40;
+	ny = 40;
+	ntests = 2 * nx * ny;
+	tests = malloc(ntests * sizeof(TestCase));
+	i = 0;
+	for (x=0; x<nx; x++)
+	{
+		for (y=0; y<ny; y++)
+		{
+			sprintf(tests[i++].wkt, "POINT(%g %g)",
+			        -5 + x * 1.45, -5 + y * 1.45);
+			sprintf(tests[i++].wkt, "LINESTRING(%g %g, %g %g)",
+			        -5 + x * 1.45, -5 + y * 1.45,
+			        -2 + x * 1.45, -4 + y * 1.45);
+		}
+	}
+	for (i=0; i<ntests; i++)
+	{
+		g = GEOSGeomFromWKT_r(handle, tests[i].wkt);
+		tests[i].expected[0] = GEOSIntersects_r(handle, area, g);
+		tests[i].expected[1] = GEOSContains_r(handle, area, g);
+		tests[i].expected[2] = GEOSCovers_r(handle, area, g);
+		tests[i].expected[3] = GEOSIntersects_r(handle, lines, g);
+		GEOSGeom_destroy_r(handle, g);
+	}
+
+	prepArea = GEOSPrepare_r(handle, area);
+	prepLines = GEOSPrepare_r(handle, lines);
+	if ( GEOSPreparedGeom_freeze_r(handle, prepArea) != 0 ||
+	     GEOSPreparedGeom_freeze_r(handle, prepLines) != 0 )
+		log_and_exit("Could not freeze the prepared geometries");
+
+	for (i=0; i<NTHREADS; i++)
+	{
+		data[i].id = i;
+		data[i].failures = 0;
+		if ( pthread_create(&threads[i], NULL, threadfunc, &data[i]) )
+			log_and_exit("Could not create thread %d", i);
+	}
+	for (i=0; i<NTHREADS; i++)
+	{
+		pthread_join(threads[i], NULL);
+		failures += data[i].failures;
+	}
+
+	GEOSPreparedGeom_destroy_r(handle, prepArea);
+	GEOSPreparedGeom_destroy_r(handle, prepLines);
+	GEOSGeom_destroy_r(handle, area);
+	GEOSGeom_destroy_r(handle, lines);
+	free(tests);
+	finishGEOS_r(handle);
+
+	if ( failures )
+	{
+		fprintf(stdout, "%d failures\n", failures);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -80,4 +80,31 @@ namespace tut
         ensure_equals( a, c );
     }
 
+    // 3 - Test orientation where the floating point
+    //     determinant rounds to zero
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        // 2^27
+        double const t = 134217728.0;
+
+        // determinant is (t+1)*(t+1) - t*(t+2) = 1, while both
+        // products round to the same double
+        Coordinate p1(0, 0);
+        Coordinate p2(t + 1, t);
+        Coordinate q(2 * t + 3, 2 * t + 1);
+
+        ensure_equals( CGAlgorithms::orientationIndex(p1, p2, q), 1 );
+        ensure_equals( CGAlgorithms::orientationIndex(q, p2, p1), -1 );
+
+        // exactly collinear
+        Coordinate r(2 * t + 2, 2 * t);
+        ensure_equals( CGAlgorithms::orientationIndex(p1, p2, r), 0 );
+
+        // clear cases, settled by the floating point filter
+        ensure_equals( CGAlgorithms::orientationIndex(p1, p2, Coordinate(0, 1)), 1 );
+        ensure_equals( CGAlgorithms::orientationIndex(p1, p2, Coordinate(1, 0)), -1 );
+    }
+
 } // namespace tut
@@ -9,9 +9,11 @@
 #include <geos/geom/Geometry.h>
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/Coordinate.h>
+#include <geos/geom/Location.h>
 #include <geos/io/WKTReader.h>
 // std
 #include <string>
+#include <vector>
 #include <cassert>
 
 using namespace geos::algorithm;
@@ -85,5 +87,45 @@ namespace tut
         ensure_equals( true, isInRing );
     }
 
+    // Test that the blocked contiguous ring scan matches the
+    // segment by segment one, on vertices, edges and near misses
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        const std::string wkt("POLYGON ((-40 80, -40 -80, 20 0, 20 -100, 40 40, \
+                               80 -80, 100 80, 140 -20, 120 140, 40 180, 60 40, \
+                               0 120, -20 -20, -40 80))");
+        GeomPtr geom(reader_.read(wkt));
+        cs_ = geom->getCoordinates();
+
+        std::vector<const geos::geom::Coordinate*> ptrs;
+        for (std::size_t i = 0; i < cs_->size(); ++i)
+            ptrs.push_back(&cs_->getAt(i));
+
+        int counts[3] = { 0, 0, 0 };
+        for (int x = -50; x <= 150; x += 5)
+        {
+            for (int y = -110; y <= 190; y += 5)
+            {
+                geos::geom::Coordinate pt(x, y);
+                int expected = CGAlgorithms::locatePointInRing(pt, ptrs);
+                int loc = CGAlgorithms::locatePointInRing(pt, *cs_);
+                ensure_equals(loc, expected);
+                ++counts[loc];
+
+                geos::geom::Coordinate near(x + 1e-9, y - 1e-9);
+                expected = CGAlgorithms::locatePointInRing(near, ptrs);
+                loc = CGAlgorithms::locatePointInRing(near, *cs_);
+                ensure_equals(loc, expected);
+            }
+        }
+
+        using geos::geom::Location;
+        ensure(counts[Location::INTERIOR] > 0);
+        ensure(counts[Location::BOUNDARY] > 0);
+        ensure(counts[Location::EXTERIOR] > 0);
+    }
+
 } // namespace tut
 
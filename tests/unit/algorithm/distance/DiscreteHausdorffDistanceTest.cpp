@@ -12,11 +12,13 @@
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Geometry.h> // required for use in auto_ptr
 #include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
 // std
 #include <cmath>
 #include <sstream>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace geos {
 	namespace geom {
@@ -72,6 +74,82 @@ namespace tut
 		ensure( diff <= TOLERANCE );
 	}
 
+	// A ring with jagged radius, snapped to a grid to get ties
+	static std::string ringWKT(double cx, double cy, double r, int n,
+	                           bool grid)
+	{
+		std::ostringstream s;
+		s.precision(17);
+		s << "(";
+		for (int i=0; i<=n; ++i)
+		{
+			double a = 2 * 3.14159265358979 * (i % n) / n;
+			double rr = r * (1 + (((i % n) * 7919) % 11) / 100.0);
+			double x = cx + rr * std::cos(a);
+			double y = cy + rr * std::sin(a);
+			if ( grid ) { x = std::floor(x); y = std::floor(y); }
+			if ( i ) s << ", ";
+			s << x << " " << y;
+		}
+		s << ")";
+		return s.str();
+	}
+
+	std::vector<std::string> sampleWKTs(int n, bool grid)
+	{
+		std::vector<std::string> wkts;
+		double r = grid ? 50 : 10;
+		wkts.push_back("POLYGON (" + ringWKT(0, 0, r, n, grid) + ")");
+		wkts.push_back("POLYGON (" + ringWKT(0.3, 0.1, r, n + 7, grid) +
+		               ", " + ringWKT(0.3, 0.1, r / 3, n / 2 + 3, grid) + ")");
+		wkts.push_back("LINESTRING " + ringWKT(1, 0, r, n, grid));
+		wkts.push_back("MULTIPOINT " + ringWKT(0, 1, r, n / 3 + 2, grid));
+		wkts.push_back("GEOMETRYCOLLECTION (POINT (0 0), LINESTRING " +
+		               ringWKT(0, 0, r * 1.5, n / 2 + 2, grid) +
+		               ", POLYGON (" + ringWKT(2, 2, r, n, grid) + "))");
+		return wkts;
+	}
+
+	// The distance from each discrete point, as originally computed
+	static void referenceOrientedDistance(const Geometry& discreteGeom,
+	                                      const Geometry& geom,
+	                                      double densifyFrac,
+	                                      PointPairDistance& ptDist)
+	{
+		DiscreteHausdorffDistance::MaxPointDistanceFilter distFilter(geom);
+		discreteGeom.apply_ro(&distFilter);
+		ptDist.setMaximum(distFilter.getMaxPointDistance());
+
+		if ( densifyFrac > 0 )
+		{
+			DiscreteHausdorffDistance::MaxDensifiedByFractionDistanceFilter
+				fracFilter(geom, densifyFrac);
+			discreteGeom.apply_ro(fracFilter);
+			ptDist.setMaximum(fracFilter.getMaxPointDistance());
+		}
+	}
+
+	void checkSameAsReference(const Geometry& g1, const Geometry& g2,
+	                          double densifyFrac)
+	{
+		PointPairDistance expected;
+		referenceOrientedDistance(g1, g2, densifyFrac, expected);
+		referenceOrientedDistance(g2, g1, densifyFrac, expected);
+
+		DiscreteHausdorffDistance dist(g1, g2);
+		if ( densifyFrac > 0 ) dist.setDensifyFraction(densifyFrac);
+		ensure_equals( dist.distance(), expected.getDistance() );
+
+		std::vector<Coordinate> pts = dist.getCoordinates();
+		ensure( pts[0].equals2D(expected.getCoordinate(0)) );
+		ensure( pts[1].equals2D(expected.getCoordinate(1)) );
+
+		double d = expected.getDistance();
+		ensure( dist.isWithinDistance(d) );
+		ensure( dist.isWithinDistance(d * 1.01) );
+		ensure( ! dist.isWithinDistance(d > 0 ? d * 0.99 : -1.0) );
+	}
+
 	PrecisionModel pm;
 	GeometryFactory gf;
         geos::io::WKTReader reader;
@@ -128,5 +206,51 @@ runTest("LINESTRING (130 0, 0 0, 0 150)", "LINESTRING (10 10, 10 150, 130 10)",
 runTest("LINESTRING (130 0, 0 0, 0 150)", "LINESTRING (10 10, 10 150, 130 10)", 0.5, 70.0);
 	}
 
+	// 5 - Indexed geometries give the same distance and points
+	//     as computing the distance from every discrete point
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		for (int grid=0; grid<2; ++grid)
+		{
+			std::vector<std::string> wkts = sampleWKTs(200, grid != 0);
+			std::vector<Geometry*> geoms;
+			for (std::size_t i=0; i<wkts.size(); ++i)
+			{
+				geoms.push_back(reader.read(wkts[i]));
+			}
+			GeomPtr small(reader.read("LINESTRING (0 0, 3 4, 5 5)"));
+			geoms.push_back(small.release());
+
+			for (std::size_t i=0; i<geoms.size(); ++i)
+			{
+				for (std::size_t j=i; j<geoms.size(); ++j)
+				{
+					checkSameAsReference(*geoms[i], *geoms[j], 0.0);
+					checkSameAsReference(*geoms[i], *geoms[j], 0.5);
+				}
+			}
+
+			for (std::size_t i=0; i<geoms.size(); ++i) delete geoms[i];
+		}
+	}
+
+	// 6 - isWithinDistance
+	template<>
+	template<>
+	void object::test<6>()
+	{
+		GeomPtr g1 ( reader.read("LINESTRING (130 0, 0 0, 0 150)") );
+		GeomPtr g2 ( reader.read("LINESTRING (10 10, 10 150, 130 10)") );
+
+		ensure( DiscreteHausdorffDistance::isWithinDistance(*g1, *g2, 14.2) );
+		ensure( ! DiscreteHausdorffDistance::isWithinDistance(*g1, *g2, 14.1) );
+		ensure( ! DiscreteHausdorffDistance::isWithinDistance(*g1, *g2, 14.2, 0.5) );
+		ensure( DiscreteHausdorffDistance::isWithinDistance(*g1, *g2, 70.0, 0.5) );
+		ensure( ! DiscreteHausdorffDistance::isWithinDistance(*g1, *g2, -1.0) );
+		ensure( DiscreteHausdorffDistance::isWithinDistance(*g1, *g1, 0.0) );
+	}
+
 } // namespace tut
 
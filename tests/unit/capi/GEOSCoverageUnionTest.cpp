@@ -0,0 +1,116 @@
+//
+// Test Suite for C-API GEOSCoverageUnion
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capicoverageunion_data
+    {
+        GEOSWKTWriter* wktw_;
+        GEOSGeometry* geom1_;
+        GEOSGeometry* geom2_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+
+            std::fprintf(stdout, "\n");
+        }
+
+        test_capicoverageunion_data()
+            : geom1_(0), geom2_(0)
+        {
+            initGEOS(notice, notice);
+            wktw_ = GEOSWKTWriter_create();
+            GEOSWKTWriter_setTrim(wktw_, 1);
+        }
+
+        std::string toWKT(GEOSGeometry* g)
+        {
+          char* wkt = GEOSWKTWriter_write(wktw_, g);
+          std::string ret (wkt);
+          GEOSFree(wkt);
+          return ret;
+        }
+
+        ~test_capicoverageunion_data()
+        {
+            GEOSGeom_destroy(geom1_);
+            GEOSGeom_destroy(geom2_);
+            GEOSWKTWriter_destroy(wktw_);
+            geom1_ = 0;
+            geom2_ = 0;
+            finishGEOS();
+        }
+
+    };
+
+    typedef test_group<test_capicoverageunion_data> group;
+    typedef group::object object;
+
+    group test_capicoverageunion_group("capi::GEOSCoverageUnion");
+
+    //
+    // Test Cases
+    //
+
+    // Union a coverage of three squares
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        geom1_ = GEOSGeomFromWKT("MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)),((1 0,1 1,2 1,2 0,1 0)),((0 1,0 2,1 2,1 1,0 1)))");
+        ensure( 0 != geom1_ );
+
+        geom2_ = GEOSCoverageUnion(geom1_);
+        ensure( 0 != geom2_ );
+
+        GEOSNormalize(geom2_);
+        ensure_equals(toWKT(geom2_), std::string("POLYGON ((0 0, 0 1, 0 2, 1 2, 1 1, 2 1, 2 0, 1 0, 0 0))"));
+    }
+
+    // Overlapping polygons are not a coverage
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        geom1_ = GEOSGeomFromWKT("MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)),((0 0,0 1,1 1,1 0,0 0)))");
+        ensure( 0 != geom1_ );
+
+        geom2_ = GEOSCoverageUnion(geom1_);
+        ensure( 0 == geom2_ );
+    }
+
+    // Non polygonal input
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING(0 0, 1 1)");
+        ensure( 0 != geom1_ );
+
+        geom2_ = GEOSCoverageUnion(geom1_);
+        ensure( 0 == geom2_ );
+    }
+
+} // namespace tut
+
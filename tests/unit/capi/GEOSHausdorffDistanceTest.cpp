@@ -0,0 +1,123 @@
+// 
+// Test Suite for C-API GEOSHausdorffDistance and GEOSHausdorffDistanceWithin
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <sstream>
+#include <string>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeoshausdorffdistance_data
+    {
+        GEOSGeometry* geom1_;
+        GEOSGeometry* geom2_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        test_capigeoshausdorffdistance_data()
+            : geom1_(0), geom2_(0)
+        {
+            initGEOS(notice, notice);
+        }       
+
+        ~test_capigeoshausdorffdistance_data()
+        {
+            GEOSGeom_destroy(geom1_);
+            GEOSGeom_destroy(geom2_);
+            geom1_ = 0;
+            geom2_ = 0;
+            finishGEOS();
+        }
+
+    };
+
+    typedef test_group<test_capigeoshausdorffdistance_data> group;
+    typedef group::object object;
+
+    group test_capigeoshausdorffdistance_group("capi::GEOSHausdorffDistance");
+
+    //
+    // Test Cases
+    //
+
+    // GEOSHausdorffDistanceWithin agrees with GEOSHausdorffDistance
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING (0 0, 2 0)");
+        geom2_ = GEOSGeomFromWKT("LINESTRING (0 1, 1 2, 2 1)");
+        ensure ( 0 != geom1_ );
+        ensure ( 0 != geom2_ );
+
+        double dist;
+        ensure_equals( GEOSHausdorffDistance(geom1_, geom2_, &dist), 1 );
+        ensure_equals( dist, 2.0 );
+
+        ensure_equals( GEOSHausdorffDistanceWithin(geom1_, geom2_, 2.0), 1 );
+        ensure_equals( GEOSHausdorffDistanceWithin(geom1_, geom2_, 3.0), 1 );
+        ensure_equals( GEOSHausdorffDistanceWithin(geom1_, geom2_, 1.9), 0 );
+        ensure_equals( GEOSHausdorffDistanceWithin(geom2_, geom1_, 1.9), 0 );
+        ensure_equals( GEOSHausdorffDistanceWithin(geom1_, geom2_, -1.0), 0 );
+    }
+
+    // Rings with enough segments to be indexed
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        std::ostringstream wkt1, wkt2;
+        wkt1.precision(17);
+        wkt2.precision(17);
+        wkt1 << "POLYGON ((";
+        wkt2 << "LINESTRING (";
+        for (int i = 0; i <= 200; ++i)
+        {
+            double a = 2 * 3.14159265358979 * (i % 200) / 200;
+            double r = 10 + (i % 200 % 7) / 10.0;
+            if ( i ) { wkt1 << ", "; wkt2 << ", "; }
+            wkt1 << r * std::cos(a) << " " << r * std::sin(a);
+            wkt2 << 0.5 + 10 * std::cos(a) << " " << 10 * std::sin(a);
+        }
+        wkt1 << "))";
+        wkt2 << ")";
+
+        geom1_ = GEOSGeomFromWKT(wkt1.str().c_str());
+        geom2_ = GEOSGeomFromWKT(wkt2.str().c_str());
+        ensure ( 0 != geom1_ );
+        ensure ( 0 != geom2_ );
+
+        double dist;
+        ensure_equals( GEOSHausdorffDistance(geom1_, geom2_, &dist), 1 );
+        ensure( dist > 0.5 );
+
+        ensure_equals( GEOSHausdorffDistanceWithin(geom1_, geom2_, dist), 1 );
+        ensure_equals( GEOSHausdorffDistanceWithin(geom2_, geom1_, dist), 1 );
+        ensure_equals( GEOSHausdorffDistanceWithin(geom1_, geom2_, dist * 0.99), 0 );
+        ensure_equals( GEOSHausdorffDistanceWithin(geom2_, geom1_, dist * 0.99), 0 );
+    }
+
+} // namespace tut
+
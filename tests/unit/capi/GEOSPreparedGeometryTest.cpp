@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 namespace tut
 {
@@ -170,6 +171,71 @@ namespace tut
 
     }
 
+    // Test PreparedIntersects and PreparedContains after freezing
+    template<>
+    template<>
+    void object::test<7>()
+    {
+    geom1_ = GEOSGeomFromWKT("POLYGON((0 0, 0 10, 10 10, 10 0, 0 0),(2 2, 2 4, 4 4, 4 2, 2 2))");
+    geom2_ = GEOSGeomFromWKT("LINESTRING(3 3, 20 3)");
+    prepGeom1_ = GEOSPrepare(geom1_);
+
+    ensure(0 != prepGeom1_);
+    ensure_equals(GEOSPreparedGeom_freeze(prepGeom1_), 0);
+
+    ensure_equals(GEOSPreparedIntersects(prepGeom1_, geom2_), 1);
+    ensure_equals(GEOSPreparedContains(prepGeom1_, geom2_), 0);
+
+    }
+
+    // Test PreparedContainsXY_many against PreparedContains
+    template<>
+    template<>
+    void object::test<8>()
+    {
+    const char* wkts[] = {
+        "MULTIPOLYGON(((0 0, 0 10, 10 11, 10 0, 0 0),(2 2, 2 4, 4 4, 4 2, 2 2)),((12 0, 20 5, 12 10, 12 0)))",
+        "POLYGON((0 0, 0 10, 10 10, 10 0, 0 0))",
+        "LINESTRING(0 0, 10 10)",
+        "POLYGON EMPTY"
+    };
+
+    std::vector<double> xs, ys;
+    for (int i = -2; i <= 42; ++i)
+    {
+        for (int j = -2; j <= 46; ++j)
+        {
+            xs.push_back(i * 0.5);
+            ys.push_back(j * 0.25);
+        }
+    }
+    unsigned int n = xs.size();
+
+    for (std::size_t w = 0; w < sizeof(wkts)/sizeof(wkts[0]); ++w)
+    {
+        GEOSGeometry* g = GEOSGeomFromWKT(wkts[w]);
+        const GEOSPreparedGeometry* pg = GEOSPrepare(g);
+        ensure(0 != pg);
+
+        std::vector<char> res(n, 2);
+        ensure_equals(GEOSPreparedContainsXY_many(pg, n, &xs[0], &ys[0], &res[0]), 1);
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            GEOSCoordSequence* cs = GEOSCoordSeq_create(1, 2);
+            GEOSCoordSeq_setX(cs, 0, xs[i]);
+            GEOSCoordSeq_setY(cs, 0, ys[i]);
+            GEOSGeometry* pt = GEOSGeom_createPoint(cs);
+            ensure_equals(res[i], GEOSPreparedContains(pg, pt));
+            GEOSGeom_destroy(pt);
+        }
+
+        GEOSPreparedGeom_destroy(pg);
+        GEOSGeom_destroy(g);
+    }
+
+    }
+
     // TODO: add lots of more tests
     
 } // namespace tut
@@ -0,0 +1,131 @@
+// 
+// Test Suite for C-API GEOSProject and GEOSProjectXY_many
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeosproject_data
+    {
+        GEOSGeometry* geom1_;
+        GEOSGeometry* geom2_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        test_capigeosproject_data()
+            : geom1_(0), geom2_(0)
+        {
+            initGEOS(notice, notice);
+        }       
+
+        ~test_capigeosproject_data()
+        {
+            GEOSGeom_destroy(geom1_);
+            GEOSGeom_destroy(geom2_);
+            geom1_ = 0;
+            geom2_ = 0;
+            finishGEOS();
+        }
+
+    };
+
+    typedef test_group<test_capigeosproject_data> group;
+    typedef group::object object;
+
+    group test_capigeosproject_group("capi::GEOSProject");
+
+    //
+    // Test Cases
+    //
+
+    // GEOSProjectXY_many gives the same results as GEOSProject
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        geom1_ = GEOSGeomFromWKT("MULTILINESTRING ((0 0, 10 0, 10 10), (10 10, 0 10, 0 0))");
+        ensure ( 0 != geom1_ );
+
+        const double x[] = { 5, 12, -3, 5, 10, 4.5, 20 };
+        const double y[] = { 1, 5, 5, 9, 10, 5, 20 };
+        const unsigned int n = 7;
+        double result[n];
+
+        ensure_equals( GEOSProjectXY_many(geom1_, n, x, y, result), 1 );
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            GEOSCoordSequence* cs = GEOSCoordSeq_create(1, 2);
+            GEOSCoordSeq_setX(cs, 0, x[i]);
+            GEOSCoordSeq_setY(cs, 0, y[i]);
+            geom2_ = GEOSGeom_createPoint(cs);
+
+            ensure_equals( result[i], GEOSProject(geom1_, geom2_) );
+
+            GEOSGeom_destroy(geom2_);
+            geom2_ = 0;
+        }
+
+        ensure_equals( result[0], 5.0 );
+        ensure_equals( result[1], 15.0 );
+        ensure_equals( result[2], 35.0 );
+    }
+
+    // Empty batch, and non-lineal geometry
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        geom1_ = GEOSGeomFromWKT("POLYGON ((0 0, 10 0, 10 10, 0 0))");
+        ensure ( 0 != geom1_ );
+
+        ensure_equals( GEOSProjectXY_many(geom1_, 0, 0, 0, 0), 1 );
+
+        const double x[] = { 5 };
+        const double y[] = { 1 };
+        double result[1];
+        ensure_equals( GEOSProjectXY_many(geom1_, 1, x, y, result), 0 );
+    }
+
+    // Null arrays are reported as errors
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING (0 0, 10 0)");
+        ensure ( 0 != geom1_ );
+
+        const double x[] = { 5 };
+        const double y[] = { 1 };
+        double result[1];
+        ensure_equals( GEOSProjectXY_many(geom1_, 1, 0, y, result), 0 );
+        ensure_equals( GEOSProjectXY_many(geom1_, 1, x, 0, result), 0 );
+        ensure_equals( GEOSProjectXY_many(geom1_, 1, x, y, 0), 0 );
+        ensure_equals( GEOSProjectXY_many(geom1_, 1, x, y, result), 1 );
+        ensure_equals( result[0], 5.0 );
+    }
+
+} // namespace tut
+
@@ -73,6 +73,22 @@ namespace tut
 
         ensure ( 0 != GEOSisEmpty(geom2_) );
     }
+
+    // Test GEOSSimplifyVW
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING (0 0, 1 0.1, 2 0, 3 5, 4 0)");
+        GEOSGeometry* expected = GEOSGeomFromWKT("LINESTRING (0 0, 2 0, 3 5, 4 0)");
+
+        geom2_ = GEOSSimplifyVW(geom1_, 1.0);
+
+        ensure ( 0 != geom2_ );
+        ensure ( 1 == GEOSEqualsExact(geom2_, expected, 0) );
+
+        GEOSGeom_destroy(expected);
+    }
     
 } // namespace tut
 
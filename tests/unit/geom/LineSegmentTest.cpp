@@ -113,5 +113,24 @@ namespace tut
 		ensure_equals( v1.distance(p), 1 );
 	}
 
+	// 7 - Test lineIntersection()
+	template<>
+	template<>
+	void object::test<7>()
+	{
+		geos::geom::Coordinate ret;
+		ensure( h1.lineIntersection(v1, ret) );
+		ensure_equals( ret.x, 0 );
+		ensure_equals( ret.y, 2 );
+
+		// parallel lines have no representable intersection
+		geos::geom::LineSegment h2(geos::geom::Coordinate(0, 5),
+		                           geos::geom::Coordinate(10, 5));
+		ret = geos::geom::Coordinate(-1, -1);
+		ensure( ! h1.lineIntersection(h2, ret) );
+		ensure_equals( ret.x, -1 );
+		ensure_equals( ret.y, -1 );
+	}
+
 } // namespace tut
 
@@ -489,5 +489,44 @@ namespace tut
         ensure_equals_geometry( g_, pg_ );
     }
 
+    // Test predicates of frozen prepared geometries
+    template<>
+    template<>
+    void object::test<30>()
+    {
+        const char* wkts[] = {
+            "MULTIPOLYGON(((0 0, 10 0, 10 10, 0 10, 0 0),(2 2, 2 6, 6 4, 2 2)),((60 60, 60 50, 70 40, 60 60)))",
+            "LINESTRING(0 0, 10 10, 20 0)",
+            "POINT(5 5)"
+        };
+        const char* tests[] = {
+            "POINT(1 1)", "POINT(3 4)", "LINESTRING(1 1, 9 9)",
+            "LINESTRING(-5 5, 15 5)", "POLYGON((1 1, 1 2, 2 2, 2 1, 1 1))"
+        };
+
+        for (std::size_t i=0; i<sizeof(wkts)/sizeof(wkts[0]); ++i)
+        {
+            GeometryPtr g(reader_.read(wkts[i]));
+            PreparedGeometryPtr pg(prep::PreparedGeometryFactory::prepare(g));
+            pg->freeze();
+            // freezing twice is harmless
+            pg->freeze();
+
+            for (std::size_t j=0; j<sizeof(tests)/sizeof(tests[0]); ++j)
+            {
+                GeometryPtr t(reader_.read(tests[j]));
+                ensure_equals(pg->intersects(t), g->intersects(t));
+                ensure_equals(pg->contains(t), g->contains(t));
+                ensure_equals(pg->covers(t), g->covers(t));
+                ensure_equals(pg->containsProperly(t),
+                              g->relate(t, "T**FF*FF*"));
+                factory_.destroyGeometry(t);
+            }
+
+            prep::PreparedGeometryFactory::destroy(pg);
+            factory_.destroyGeometry(g);
+        }
+    }
+
 } // namespace tut
 
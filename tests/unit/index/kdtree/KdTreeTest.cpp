@@ -0,0 +1,117 @@
+// 
+// Test Suite for geos::index::kdtree::KdTree class.
+
+#include <tut.hpp>
+// geos
+#include <geos/index/kdtree/KdTree.h>
+#include <geos/index/kdtree/KdNode.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Envelope.h>
+// std
+#include <cstddef>
+#include <vector>
+
+using namespace geos::index::kdtree;
+using geos::geom::Coordinate;
+using geos::geom::Envelope;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_kdtree_data
+	{
+	};
+
+	typedef test_group<test_kdtree_data> group;
+	typedef group::object object;
+
+	group test_kdtree_group("geos::index::kdtree::KdTree");
+
+	//
+	// Test Cases
+	//
+
+	// Exact duplicates are merged, distinct points are not
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		KdTree tree;
+		ensure(tree.isEmpty());
+
+		int data = 0;
+		KdNode* n1 = tree.insert(Coordinate(1, 1), &data);
+		KdNode* n2 = tree.insert(Coordinate(2, 1));
+		KdNode* n3 = tree.insert(Coordinate(1, 1));
+		KdNode* n4 = tree.insert(Coordinate(1, 1.0000001));
+
+		ensure(!tree.isEmpty());
+		ensure_equals(tree.size(), std::size_t(3));
+		ensure(n1 == n3);
+		ensure(n1 != n2);
+		ensure(n1 != n4);
+		ensure_equals(n1->getCount(), 2);
+		ensure(n1->isRepeated());
+		ensure(!n2->isRepeated());
+		ensure_equals(n1->getData(), static_cast<void*>(&data));
+	}
+
+	// Points within tolerance snap to the closest node
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		KdTree tree(1.0);
+
+		KdNode* a = tree.insert(Coordinate(0, 0));
+		KdNode* b = tree.insert(Coordinate(3, 0));
+		KdNode* c = tree.insert(Coordinate(0.5, 0.5));
+		KdNode* d = tree.insert(Coordinate(2.5, 0.1));
+		KdNode* e = tree.insert(Coordinate(1.5, 0));
+
+		ensure_equals(tree.size(), std::size_t(3));
+		ensure(c == a);
+		ensure(d == b);
+		ensure(e != a);
+		ensure(e != b);
+		ensure_equals(a->getCount(), 2);
+		ensure_equals(b->getCount(), 2);
+	}
+
+	// Range queries match a brute force scan, also on coherent
+	// input which makes the tree degenerate
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		KdTree tree;
+		std::vector<Coordinate> pts;
+		for (int i = 0; i < 2000; ++i)
+		{
+			Coordinate p(i * 0.5, (i % 37) * 2.0);
+			pts.push_back(p);
+			tree.insert(p);
+		}
+		ensure_equals(tree.size(), pts.size());
+
+		Envelope env(100, 200, 10, 40);
+		std::vector<KdNode*> result;
+		tree.query(env, result);
+
+		std::size_t expected = 0;
+		for (std::size_t i = 0; i < pts.size(); ++i)
+		{
+			if ( env.contains(pts[i]) ) ++expected;
+		}
+		ensure(expected > 0);
+		ensure_equals(result.size(), expected);
+		for (std::size_t i = 0; i < result.size(); ++i)
+		{
+			ensure(env.contains(result[i]->getCoordinate()));
+		}
+	}
+
+} // namespace tut
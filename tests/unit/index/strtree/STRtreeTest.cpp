@@ -0,0 +1,144 @@
+// 
+// Test Suite for geos::index::strtree::STRtree class.
+
+#include <tut.hpp>
+// geos
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/AbstractNode.h>
+#include <geos/geom/Envelope.h>
+// std
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace geos::index::strtree;
+using geos::geom::Envelope;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	struct test_strtree_data
+	{
+		std::vector<Envelope> envs;
+
+		test_strtree_data()
+		{
+			// deterministic pseudo random points in [0,1000)^2
+			unsigned long seed = 12345;
+			for (int i = 0; i < 10000; ++i)
+			{
+				seed = (seed * 1103515245UL + 12345UL) % 2147483648UL;
+				double x = (seed % 1000000) / 1000.0;
+				seed = (seed * 1103515245UL + 12345UL) % 2147483648UL;
+				double y = (seed % 1000000) / 1000.0;
+				envs.push_back(Envelope(x, x, y, y));
+			}
+		}
+	};
+
+	typedef test_group<test_strtree_data> group;
+	typedef group::object object;
+
+	group test_strtree_group("geos::index::strtree::STRtree");
+
+	// Gives access to the tree levels
+	class LevelTree : public STRtree
+	{
+	public:
+		using AbstractSTRtree::boundablesAtLevel;
+	};
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Query results match a brute force scan
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		STRtree tree;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			tree.insert(&envs[i], &envs[i]);
+
+		for (int q = 0; q < 100; ++q)
+		{
+			double x = q * 9.7;
+			double y = 1000 - q * 9.3;
+			Envelope search(x, x + 25, y - 25, y);
+
+			std::vector<void*> found;
+			tree.query(&search, found);
+
+			std::size_t expected = 0;
+			for (std::size_t i = 0; i < envs.size(); ++i)
+				if (search.intersects(&envs[i])) ++expected;
+
+			ensure_equals(found.size(), expected);
+			for (std::size_t i = 0; i < found.size(); ++i)
+				ensure(search.intersects(static_cast<Envelope*>(found[i])));
+		}
+	}
+
+	// 2 - Leaf nodes are compact: items are sliced by x, then by y
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		LevelTree tree;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			tree.insert(&envs[i], &envs[i]);
+		tree.build();
+
+		std::auto_ptr<BoundableList> leaves(tree.boundablesAtLevel(0));
+		// at least 10000 / 10 leaves, more due to partial slices
+		ensure(leaves->size() >= 1000);
+
+		for (std::size_t i = 0; i < leaves->size(); ++i)
+		{
+			const Envelope* env =
+				static_cast<const Envelope*>((*leaves)[i]->getBounds());
+			// 32 slices over 1000 units of x
+			ensure(env->getWidth() < 100);
+		}
+	}
+
+	// 3 - Upper levels are compact too, and cover their children
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		LevelTree tree;
+		for (std::size_t i = 0; i < envs.size(); ++i)
+			tree.insert(&envs[i], &envs[i]);
+		tree.build();
+
+		std::auto_ptr<BoundableList> nodes(tree.boundablesAtLevel(1));
+		ensure(nodes->size() >= 100);
+
+		std::size_t nItems = 0;
+		for (std::size_t i = 0; i < nodes->size(); ++i)
+		{
+			AbstractNode* node = static_cast<AbstractNode*>((*nodes)[i]);
+			const Envelope* env =
+				static_cast<const Envelope*>(node->getBounds());
+			// 10 slices over 1000 units of each axis
+			ensure(env->getWidth() < 250);
+			ensure(env->getHeight() < 250);
+
+			BoundableList& leaves = *(node->getChildBoundables());
+			for (std::size_t j = 0; j < leaves.size(); ++j)
+			{
+				AbstractNode* leaf = static_cast<AbstractNode*>(leaves[j]);
+				ensure(env->contains(
+					static_cast<const Envelope*>(leaf->getBounds())));
+				nItems += leaf->getChildBoundables()->size();
+			}
+		}
+		ensure_equals(nItems, envs.size());
+	}
+
+} // namespace tut
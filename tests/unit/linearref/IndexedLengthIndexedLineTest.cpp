@@ -0,0 +1,297 @@
+//
+// Test Suite for geos::linearref::IndexedLengthIndexedLine
+
+#include <tut.hpp>
+// geos
+#include <geos/io/WKTReader.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/linearref/IndexedLengthIndexedLine.h>
+#include <geos/linearref/LengthIndexedLine.h>
+#include <geos/linearref/LengthLocationMap.h>
+#include <geos/linearref/LinearLocation.h>
+#include <geos/util/IllegalStateException.h>
+// std
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <memory>
+#include <sstream>
+#include <cmath>
+
+using namespace geos::geom;
+using namespace geos::linearref;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_indexedlengthindexedline_data
+	{
+		typedef std::auto_ptr<Geometry> GeomPtr;
+
+		PrecisionModel pm;
+		GeometryFactory gf;
+		geos::io::WKTReader reader;
+
+		test_indexedlengthindexedline_data()
+			: pm(), gf(&pm), reader(&gf)
+		{}
+
+		// Lengths around and at the vertices of the line,
+		// and out of range
+		std::vector<double> indicesFor(const Geometry* line)
+		{
+			double len = line->getLength();
+			std::vector<double> indices;
+			indices.push_back(0.0);
+			indices.push_back(-0.0);
+			indices.push_back(len);
+			indices.push_back(len + 1);
+			indices.push_back(-len);
+			indices.push_back(-len - 1);
+			for (int i=1; i<40; ++i)
+			{
+				indices.push_back(len * i / 37.0);
+				indices.push_back(-len * i / 41.0);
+			}
+			for (std::size_t c=0; c<line->getNumGeometries(); ++c)
+			{
+				const Geometry* comp = line->getGeometryN(c);
+				for (std::size_t v=0; v<comp->getNumPoints(); ++v)
+				{
+					LinearLocation loc(c, v, 0.0);
+					indices.push_back(LengthLocationMap::getLength(line, loc));
+				}
+			}
+			return indices;
+		}
+
+		// Offsets from zero-length segments throw
+		void checkSameOffsetPoint(const char* wkt,
+		                          const IndexedLengthIndexedLine& indexed,
+		                          const LengthIndexedLine& expected,
+		                          double index)
+		{
+			Coordinate expectedPt;
+			bool expectedThrew = false;
+			try {
+				expectedPt = expected.extractPoint(index, 1.5);
+			} catch (const geos::util::IllegalStateException&) {
+				expectedThrew = true;
+			}
+
+			try {
+				Coordinate pt = indexed.extractPoint(index, 1.5);
+				ensure(wkt, ! expectedThrew);
+				ensure(wkt, pt.equals2D(expectedPt));
+			} catch (const geos::util::IllegalStateException&) {
+				ensure(wkt, expectedThrew);
+			}
+		}
+
+		void checkSameAsLengthIndexedLine(const char* wkt)
+		{
+			GeomPtr line(reader.read(wkt));
+			LengthIndexedLine expected(line.get());
+			IndexedLengthIndexedLine indexed(line.get());
+
+			ensure_equals(indexed.getEndIndex(), expected.getEndIndex());
+
+			std::vector<double> indices = indicesFor(line.get());
+			for (std::size_t i=0; i<indices.size(); ++i)
+			{
+				double index = indices[i];
+				Coordinate pt = indexed.extractPoint(index);
+				ensure(wkt, pt.equals3D(expected.extractPoint(index)));
+				checkSameOffsetPoint(wkt, indexed, expected, index);
+
+				LinearLocation loc = indexed.locationOf(index);
+				ensure(wkt, loc.compareTo(
+					LengthLocationMap::getLocation(line.get(), index)) == 0);
+				loc = indexed.locationOf(index, false);
+				ensure(wkt, loc.compareTo(
+					LengthLocationMap::getLocation(line.get(), index, false)) == 0);
+
+				ensure_equals(wkt, indexed.indexOf(loc),
+					LengthLocationMap::getLength(line.get(), loc));
+			}
+
+			for (std::size_t i=0; i<indices.size(); i+=3)
+			{
+				for (std::size_t j=0; j<indices.size(); j+=5)
+				{
+					GeomPtr sub(indexed.extractLine(indices[i], indices[j]));
+					GeomPtr subExpected(expected.extractLine(indices[i], indices[j]));
+					ensure(wkt, sub->equalsExact(subExpected.get()));
+				}
+			}
+
+			// batch extraction, sorted or not
+			std::vector<Coordinate> pts;
+			indexed.extractPoints(indices, pts);
+			std::sort(indices.begin(), indices.end());
+			indexed.extractPoints(indices, pts);
+			ensure_equals(pts.size(), 2 * indices.size());
+			std::vector<double> unsorted = indicesFor(line.get());
+			for (std::size_t i=0; i<unsorted.size(); ++i)
+			{
+				ensure(wkt, pts[i].equals3D(expected.extractPoint(unsorted[i])));
+				ensure(wkt, pts[unsorted.size() + i].equals3D(
+					expected.extractPoint(indices[i])));
+			}
+		}
+
+		void checkSameProjection(const char* wkt)
+		{
+			GeomPtr line(reader.read(wkt));
+			LengthIndexedLine expected(line.get());
+			IndexedLengthIndexedLine indexed(line.get());
+
+			const Envelope* env = line->getEnvelopeInternal();
+			double w = env->getWidth() + 1;
+			double h = env->getHeight() + 1;
+			for (int i=0; i<500; ++i)
+			{
+				// on a grid, to get ties, some far from the line
+				Coordinate pt(env->getMinX() - w + (i % 25) * w / 8,
+				              env->getMinY() - h + (i / 25) * h / 6);
+				ensure_equals(wkt, indexed.project(pt), expected.project(pt));
+				ensure_equals(wkt, indexed.indexOf(pt), expected.indexOf(pt));
+			}
+
+			// points on the line
+			for (std::size_t c=0; c<line->getNumGeometries(); ++c)
+			{
+				const Geometry* comp = line->getGeometryN(c);
+				std::auto_ptr<CoordinateSequence> cs(comp->getCoordinates());
+				for (std::size_t v=0; v<cs->size(); ++v)
+				{
+					ensure_equals(wkt, indexed.project(cs->getAt(v)),
+						expected.project(cs->getAt(v)));
+				}
+			}
+		}
+	};
+
+	typedef test_group<test_indexedlengthindexedline_data> group;
+	typedef group::object object;
+
+	group test_indexedlengthindexedline_group("geos::linearref::IndexedLengthIndexedLine");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Simple lines
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		checkSameAsLengthIndexedLine("LINESTRING (0 0, 10 0, 10 10, 20 10)");
+		checkSameAsLengthIndexedLine("LINESTRING (0 0 0, 0.1 3 5, 7.3 1.1 2, 12 17 8)");
+		checkSameAsLengthIndexedLine("LINESTRING (0 0, 0 0, 5 5, 5 5, 10 0)");
+	}
+
+	// 2 - Component endpoints, and zero-length components
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		checkSameAsLengthIndexedLine("MULTILINESTRING ((0 0, 3 4), (10 10, 13 14, 20 20))");
+		checkSameAsLengthIndexedLine("MULTILINESTRING ((0 0, 10 0), (10 0, 10 0), (10 0, 20 0), (20 0, 20 0))");
+		checkSameAsLengthIndexedLine("MULTILINESTRING ((5 5, 5 5), (0 0, 10 0))");
+	}
+
+	// 3 - Long line with many vertices
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		std::string wkt("LINESTRING (");
+		for (int i=0; i<300; ++i)
+		{
+			if ( i ) wkt += ", ";
+			std::ostringstream s;
+			s.precision(17);
+			s << i * 0.37 << " " << ((i * 7919) % 101) / 9.0;
+			wkt += s.str();
+		}
+		wkt += ")";
+		checkSameAsLengthIndexedLine(wkt.c_str());
+	}
+
+	// 4 - indicesOf
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		GeomPtr line(reader.read("MULTILINESTRING ((0 0, 10 0), (10 0, 10 10, 20 10))"));
+		GeomPtr sub(reader.read("LINESTRING (5 0, 10 0, 10 10, 15 10)"));
+		IndexedLengthIndexedLine indexed(line.get());
+		LengthIndexedLine expected(line.get());
+
+		double* got = indexed.indicesOf(sub.get());
+		double* exp = expected.indicesOf(sub.get());
+		ensure_equals(got[0], exp[0]);
+		ensure_equals(got[1], exp[1]);
+		ensure_equals(got[0], 5.0);
+		ensure_equals(got[1], 25.0);
+		delete [] got;
+		delete [] exp;
+	}
+
+	// 5 - project and indexOf
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		checkSameProjection("LINESTRING (0 0, 10 0, 10 10, 20 10)");
+		checkSameProjection("LINESTRING (0 0, 10 10, 10 0, 0 10, 0 0)");
+		checkSameProjection("MULTILINESTRING ((0 0, 10 0), (10 0, 10 0), (10 0, 20 0), (20 0, 20 0))");
+		checkSameProjection("MULTILINESTRING ((0 0, 3 4), (10 10, 13 14, 20 20))");
+		checkSameProjection("LINESTRING (5 5, 5 5)");
+
+		std::string wkt("LINESTRING (");
+		for (int i=0; i<1000; ++i)
+		{
+			if ( i ) wkt += ", ";
+			std::ostringstream s;
+			s.precision(17);
+			s << 10 * std::sin(i / 30.0) + i / 100.0 << " "
+			  << 10 * std::cos(i / 47.0) + ((i * 7919) % 13) / 20.0;
+			wkt += s.str();
+		}
+		wkt += ")";
+		checkSameProjection(wkt.c_str());
+	}
+
+	// 6 - indexOfAfter on a self-intersecting line
+	template<>
+	template<>
+	void object::test<6>()
+	{
+		GeomPtr line(reader.read("LINESTRING (0 0, 10 10, 10 0, 0 10)"));
+		LengthIndexedLine expected(line.get());
+		IndexedLengthIndexedLine indexed(line.get());
+
+		Coordinate pt(5, 5);
+		double index1 = indexed.indexOf(pt);
+		double index2 = indexed.indexOfAfter(pt, index1);
+		ensure(index2 > index1);
+		ensure_equals(index1, expected.indexOf(pt));
+		ensure_equals(index2, expected.indexOfAfter(pt, index1));
+		ensure(indexed.extractPoint(index2).equals2D(pt));
+
+		ensure_equals(indexed.indexOfAfter(pt, -1.0), index1);
+		ensure_equals(indexed.indexOfAfter(pt, 1000.0), indexed.getEndIndex());
+	}
+
+} // namespace tut
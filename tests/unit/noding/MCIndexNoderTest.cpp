@@ -0,0 +1,256 @@
+//
+// Test Suite for geos::noding::MCIndexNoder class.
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/IntersectionAdder.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/ScaledNoder.h>
+#include <geos/noding/snapround/MCIndexSnapRounder.h>
+#include <geos/operation/buffer/BufferBuilder.h>
+#include <geos/operation/buffer/BufferParameters.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/io/WKTReader.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Runs the partitions of a noder in reverse order
+    class ReversePartitionRunner
+        : public geos::noding::MCIndexNoder::PartitionRunner
+    {
+    public:
+        ReversePartitionRunner() : runs(0), partitions(0) {}
+
+        int runs;
+        std::size_t partitions;
+
+        void runPartitions(geos::noding::MCIndexNoder& noder)
+        {
+            ++runs;
+            partitions += noder.getNumPartitions();
+            for (std::size_t i=noder.getNumPartitions(); i>0; --i)
+                noder.computePartitionOverlaps(i-1);
+        }
+    };
+
+    // Common data used by tests
+    struct test_mcindexnoder_data
+    {
+        geos::geom::GeometryFactory gf;
+        geos::io::WKTReader wktreader;
+
+        typedef geos::geom::Geometry::AutoPtr GeomPtr;
+        typedef std::vector<geos::noding::SegmentString*> SegStrings;
+
+        test_mcindexnoder_data()
+            : gf(), wktreader(&gf)
+        {}
+
+        // Random walks crossing each other, with repeatable
+        // pseudo-random steps
+        void makeWalks(SegStrings& segStrings, int nWalks, int nSteps)
+        {
+            unsigned int seed = 12345;
+            for (int w=0; w<nWalks; ++w)
+            {
+                std::auto_ptr<geos::geom::CoordinateSequence> cs(
+                    new geos::geom::CoordinateArraySequence());
+                double x = w % 10 * 10;
+                double y = w / 10 * 10;
+                for (int s=0; s<nSteps; ++s)
+                {
+                    cs->add(geos::geom::Coordinate(x, y));
+                    seed = seed * 1103515245 + 12345;
+                    x += double((seed >> 16) % 2001) / 100.0 - 10.0;
+                    seed = seed * 1103515245 + 12345;
+                    y += double((seed >> 16) % 2001) / 100.0 - 10.0;
+                }
+                segStrings.push_back(
+                    new geos::noding::NodedSegmentString(cs.release(), 0));
+            }
+        }
+
+        // Nodes random walks, and returns their noded substrings
+        // as text
+        std::string node(geos::noding::MCIndexNoder& noder,
+                         std::size_t partitionSize = 0,
+                         bool reverse = false)
+        {
+            geos::algorithm::LineIntersector li;
+            geos::noding::IntersectionAdder adder(li);
+            noder.setSegmentIntersector(&adder);
+
+            SegStrings segStrings;
+            makeWalks(segStrings, 40, 50);
+
+            if ( partitionSize )
+            {
+                noder.partitionOverlaps(&segStrings, partitionSize);
+                std::size_t n = noder.getNumPartitions();
+                for (std::size_t i=0; i<n; ++i)
+                    noder.computePartitionOverlaps(reverse ? n-1-i : i);
+                noder.mergePartitionOverlaps();
+            }
+            else
+            {
+                noder.computeNodes(&segStrings);
+            }
+
+            std::auto_ptr<SegStrings> noded(noder.getNodedSubstrings());
+            std::ostringstream os;
+            for (std::size_t i=0; i<noded->size(); ++i)
+            {
+                os << (*noded)[i]->getCoordinates()->toString() << "\n";
+                delete (*noded)[i];
+            }
+            for (std::size_t i=0; i<segStrings.size(); ++i)
+                delete segStrings[i];
+            return os.str();
+        }
+
+    private:
+        // noncopyable
+        test_mcindexnoder_data(test_mcindexnoder_data const& other);
+        test_mcindexnoder_data& operator=(test_mcindexnoder_data const& rhs);
+    };
+
+    typedef test_group<test_mcindexnoder_data> group;
+    typedef group::object object;
+
+    group test_mcindexnoder_group("geos::noding::MCIndexNoder");
+
+    //
+    // Test Cases
+    //
+
+    // Partitioned overlap search nodes like the serial one,
+    // whatever the partition size and run order
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        using geos::noding::MCIndexNoder;
+
+        MCIndexNoder serial;
+        std::string expected = node(serial);
+        ensure(!expected.empty());
+
+        std::size_t sizes[] = { 1, 7, 100, 100000 };
+        for (std::size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); ++i)
+        {
+            MCIndexNoder forward;
+            ensure_equals(node(forward, sizes[i], false), expected);
+
+            MCIndexNoder backward;
+            ensure_equals(node(backward, sizes[i], true), expected);
+        }
+    }
+
+    // computeNodes runs the partitions through a runner
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        using geos::noding::MCIndexNoder;
+
+        MCIndexNoder serial;
+        std::string expected = node(serial);
+
+        ReversePartitionRunner runner;
+        MCIndexNoder noder;
+        noder.setPartitionRunner(&runner, 16);
+        ensure_equals(node(noder), expected);
+        ensure_equals(runner.runs, 1);
+        ensure(runner.partitions > 1);
+        ensure_equals(noder.getNumPartitions(), runner.partitions);
+    }
+
+    // Partitions must not be empty
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        using geos::noding::MCIndexNoder;
+
+        ReversePartitionRunner runner;
+        MCIndexNoder noder;
+        try {
+            noder.setPartitionRunner(&runner, 0);
+            fail("IllegalArgumentException not thrown");
+        } catch (const geos::util::IllegalArgumentException&) {
+        }
+
+        // No runner, no size needed
+        noder.setPartitionRunner(NULL, 0);
+    }
+
+    // BufferBuilder and a snap rounding ScaledNoder node through
+    // the runner, with the same results
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        using geos::operation::buffer::BufferBuilder;
+        using geos::operation::buffer::BufferParameters;
+        using geos::noding::ScaledNoder;
+        using geos::noding::snapround::MCIndexSnapRounder;
+        using geos::geom::PrecisionModel;
+
+        std::string wkt("MULTILINESTRING((0 0, 10 10, 20 0, 30 10, 40 0), (0 5, 40 5), (5 -5, 5 15, 15 -5, 15 15), (35 -5, 25 15))");
+        GeomPtr g(wktreader.read(wkt));
+        BufferParameters bp;
+
+        BufferBuilder b1(bp);
+        GeomPtr expected(b1.buffer(g.get(), 1.0));
+
+        ReversePartitionRunner runner;
+        BufferBuilder b2(bp);
+        b2.setNoderPartitionRunner(&runner, 2);
+        GeomPtr obtained(b2.buffer(g.get(), 1.0));
+        ensure(obtained->equalsExact(expected.get()));
+        ensure(runner.runs > 0);
+
+        // As BufferOp does at reduced precision
+        PrecisionModel fixedPM(1000.0);
+        PrecisionModel pm(1.0);
+
+        MCIndexSnapRounder rounder1(pm);
+        ScaledNoder noder1(rounder1, fixedPM.getScale());
+        BufferBuilder b3(bp);
+        b3.setWorkingPrecisionModel(&fixedPM);
+        b3.setNoder(&noder1);
+        GeomPtr expectedFixed(b3.buffer(g.get(), 1.0));
+
+        int runs = runner.runs;
+        MCIndexSnapRounder rounder2(pm);
+        rounder2.setPartitionRunner(&runner, 2);
+        ScaledNoder noder2(rounder2, fixedPM.getScale());
+        BufferBuilder b4(bp);
+        b4.setWorkingPrecisionModel(&fixedPM);
+        b4.setNoder(&noder2);
+        GeomPtr obtainedFixed(b4.buffer(g.get(), 1.0));
+        ensure(obtainedFixed->equalsExact(expectedFixed.get()));
+        ensure(runner.runs > runs);
+    }
+
+} // namespace tut
+
@@ -0,0 +1,125 @@
+//
+// Test Suite for geos::operation::buffer::BufferBuilder class.
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/operation/buffer/BufferBuilder.h>
+#include <geos/operation/buffer/BufferParameters.h>
+#include <geos/algorithm/distance/DiscreteHausdorffDistance.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <memory>
+#include <string>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used by tests
+    struct test_bufferbuilder_data
+    {
+        geos::geom::GeometryFactory gf;
+        geos::io::WKTReader wktreader;
+
+        typedef geos::geom::Geometry::AutoPtr GeomPtr;
+        typedef geos::operation::buffer::BufferBuilder BufferBuilder;
+        typedef geos::operation::buffer::BufferParameters BufferParameters;
+
+        test_bufferbuilder_data()
+            : gf(), wktreader(&gf)
+        {}
+
+        // Checks offsetCurve against bufferLineSingleSided on both sides
+        void checkOffsetCurve(const std::string& wkt, double dist,
+                              int quadSegs)
+        {
+            using geos::algorithm::distance::DiscreteHausdorffDistance;
+
+            GeomPtr line(wktreader.read(wkt));
+            BufferParameters bp;
+            bp.setEndCapStyle(BufferParameters::CAP_FLAT);
+            bp.setQuadrantSegments(quadSegs);
+
+            for (int side=0; side<2; ++side)
+            {
+                BufferBuilder b1(bp);
+                GeomPtr expected(b1.bufferLineSingleSided(line.get(), dist, side == 0));
+                BufferBuilder b2(bp);
+                GeomPtr obtained(b2.offsetCurve(line.get(), dist, side == 0));
+
+                ensure_equals(obtained->isEmpty(), expected->isEmpty());
+                if ( expected->isEmpty() ) continue;
+
+                double hd = DiscreteHausdorffDistance::distance(*expected, *obtained);
+                ensure(hd < dist / 100);
+            }
+        }
+
+    private:
+        // noncopyable
+        test_bufferbuilder_data(test_bufferbuilder_data const& other);
+        test_bufferbuilder_data& operator=(test_bufferbuilder_data const& rhs);
+    };
+
+    typedef test_group<test_bufferbuilder_data> group;
+    typedef group::object object;
+
+    group test_bufferbuilder_group("geos::operation::buffer::BufferBuilder");
+
+    //
+    // Test Cases
+    //
+
+    // Offset curve of a straight and a bent line
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        checkOffsetCurve("LINESTRING(0 0, 10 0)", 2, 8);
+        checkOffsetCurve("LINESTRING(0 0, 10 0, 10 10)", 2, 8);
+
+        GeomPtr line(wktreader.read("LINESTRING(0 0, 10 0)"));
+        BufferBuilder builder((BufferParameters()));
+        GeomPtr left(builder.offsetCurve(line.get(), 2, true));
+        ensure(left->equalsExact(
+            GeomPtr(wktreader.read("LINESTRING(0 2, 10 2)")).get()));
+        GeomPtr right(builder.offsetCurve(line.get(), 2, false));
+        ensure(right->equalsExact(
+            GeomPtr(wktreader.read("LINESTRING(10 -2, 0 -2)")).get()));
+    }
+
+    // Loops at sharp inside turns are removed
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        checkOffsetCurve("LINESTRING(5 5, 1 1, 1.5 3)", 1.6, 4);
+        checkOffsetCurve("LINESTRING(0 0, 20 0, 20 3, 2 3, 2 -10)", 2, 8);
+    }
+
+    // The curve is kept where the line ends with a short hook
+    // turning into the requested side
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        checkOffsetCurve("LINESTRING(0 0, 100 0, 99 1)", 7, 8);
+        checkOffsetCurve("LINESTRING(0 0, 100 0, 99 2)", 7, 8);
+        checkOffsetCurve("LINESTRING(0 0, 100 0, 99 1)", 7, 4);
+
+        GeomPtr line(wktreader.read("LINESTRING(0 0, 100 0, 99 1)"));
+        BufferParameters bp;
+        bp.setEndCapStyle(BufferParameters::CAP_FLAT);
+        BufferBuilder builder(bp);
+        GeomPtr left(builder.offsetCurve(line.get(), 7, true));
+        ensure(!left->isEmpty());
+        ensure(left->getLength() > 100);
+    }
+
+} // namespace tut
+
@@ -13,6 +13,8 @@
 #include <geos/algorithm/PointLocator.h>
 #include <geos/io/WKTReader.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/util/GEOSException.h>
+#include <geos/util/TopologyException.h>
 // std
 #include <memory>
 #include <string>
@@ -45,6 +47,36 @@ namespace tut
         test_bufferop_data& operator=(test_bufferop_data const& rhs);
     };
 
+    // Fails at the given numbers of precision digits, aborts with
+    // a non topological error at others, and records the ones tried
+    class FailingPrecisionBufferOp : public geos::operation::buffer::BufferOp
+    {
+    public:
+        FailingPrecisionBufferOp(const geos::geom::Geometry* g,
+                                 const std::string& failing,
+                                 const std::string& aborting = "")
+            : BufferOp(g), failingDigits(failing), abortingDigits(aborting)
+        {}
+
+        std::string triedDigits;
+
+    protected:
+        void bufferReducedPrecision(int precisionDigits)
+        {
+            char digit = static_cast<char>('0' + precisionDigits);
+            triedDigits += digit;
+            if ( failingDigits.find(digit) != std::string::npos )
+                throw geos::util::TopologyException("simulated failure");
+            if ( abortingDigits.find(digit) != std::string::npos )
+                throw geos::util::GEOSException("simulated abort");
+            BufferOp::bufferReducedPrecision(precisionDigits);
+        }
+
+    private:
+        std::string failingDigits;
+        std::string abortingDigits;
+    };
+
     typedef test_group<test_bufferop_data> group;
     typedef group::object object;
 
@@ -305,5 +337,109 @@ namespace tut
         ensure(gBuffer2->equals(gBuffer1.get()));        
     }
 
-} // namespace tut
+    // Reduced precision fallback, starting below MAX_PRECISION_DIGITS
+    // for coordinates far from the origin
+    // See http://trac.osgeo.org/geos/ticket/356
+    template<>
+    template<>
+    void object::test<11>()
+    {
+        using geos::operation::buffer::BufferOp;
+
+        GeomPtr g0(wktreader.read("LINESTRING(0 0, 10 0)"));
+        BufferOp op0(g0.get());
+        GeomPtr gBuffer0(op0.getResultGeometry(1.0));
+        ensure_equals(op0.getResultPrecisionDigits(), -1);
+
+        std::string wkt1("MULTILINESTRING((1676339.95971128 4847443.67952346, 1676340.19 4847443.54, 1676338.44 4847440.65, 1676335.37 4847442.52, 1676337.12 4847445.4, 1676339.95971128 4847443.67952346))");
+        GeomPtr g1(wktreader.read(wkt1));
+        BufferOp op1(g1.get());
+        GeomPtr gBuffer1(op1.getResultGeometry(1.0));
+        ensure(gBuffer1->isValid());
+        ensure_equals(gBuffer1->getGeometryTypeId(), geos::geom::GEOS_POLYGON);
+        ensure_equals(op1.getResultPrecisionDigits(), 9);
+    }
+
+    // Reduced precision fallback where success is not monotone
+    // in the number of digits: a failing mid-range precision
+    // must not hide a higher one which succeeds
+    template<>
+    template<>
+    void object::test<12>()
+    {
+        std::string wkt("MULTILINESTRING((1676339.95971128 4847443.67952346, 1676340.19 4847443.54, 1676338.44 4847440.65, 1676335.37 4847442.52, 1676337.12 4847445.4, 1676339.95971128 4847443.67952346))");
+        GeomPtr g(wktreader.read(wkt));
+
+        // Starts from 9 digits, gallops down to 6 and
+        // bisects the bracket between 6 and 8
+        FailingPrecisionBufferOp op1(g.get(), "45789");
+        GeomPtr gBuffer1(op1.getResultGeometry(1.0));
+        ensure(gBuffer1->isValid());
+        ensure_equals(gBuffer1->getGeometryTypeId(), geos::geom::GEOS_POLYGON);
+        ensure_equals(op1.getResultPrecisionDigits(), 6);
+        ensure_equals(op1.triedDigits, std::string("9867"));
+
+        // Bisection finds the highest working precision
+        // of the bracket
+        FailingPrecisionBufferOp op2(g.get(), "98");
+        GeomPtr gBuffer2(op2.getResultGeometry(1.0));
+        ensure(gBuffer2->isValid());
+        ensure_equals(op2.getResultPrecisionDigits(), 7);
+        ensure_equals(op2.triedDigits, std::string("9867"));
+
+        // Every precision fails
+        FailingPrecisionBufferOp op3(g.get(), "0123456789");
+        try {
+            GeomPtr gBuffer3(op3.getResultGeometry(1.0));
+            fail("TopologyException not thrown");
+        } catch (const geos::util::TopologyException&) {
+        }
+        ensure_equals(op3.triedDigits, std::string("98620"));
+    }
+
+    // Reduced precision fallback where a non topological error
+    // escapes the bisection: it propagates, and the best result
+    // found so far is freed
+    template<>
+    template<>
+    void object::test<13>()
+    {
+        std::string wkt("MULTILINESTRING((1676339.95971128 4847443.67952346, 1676340.19 4847443.54, 1676338.44 4847440.65, 1676335.37 4847442.52, 1676337.12 4847445.4, 1676339.95971128 4847443.67952346))");
+        GeomPtr g(wktreader.read(wkt));
+
+        // 6 succeeds while galloping, then bisecting
+        // between 6 and 8 tries 7
+        FailingPrecisionBufferOp op(g.get(), "89", "7");
+        try {
+            GeomPtr gBuffer(op.getResultGeometry(1.0));
+            fail("GEOSException not thrown");
+        } catch (const geos::util::TopologyException&) {
+            fail("TopologyException thrown");
+        } catch (const geos::util::GEOSException&) {
+        }
+        ensure_equals(op.triedDigits, std::string("9867"));
+    }
 
+    // Buffer of many disjoint points: one subgraph, and
+    // one polygon, per point
+    template<>
+    template<>
+    void object::test<14>()
+    {
+        using geos::operation::buffer::BufferOp;
+
+        std::vector<geos::geom::Coordinate> coords;
+        for (int i = 0; i < 2000; ++i)
+        {
+            coords.push_back(geos::geom::Coordinate(4.0 * (i % 45), 4.0 * (i / 45)));
+        }
+        GeomPtr g(gf.createMultiPoint(coords));
+
+        BufferOp op(g.get());
+        GeomPtr gBuffer(op.getResultGeometry(1.0));
+        ensure_equals(gBuffer->getGeometryTypeId(), geos::geom::GEOS_MULTIPOLYGON);
+        ensure_equals(gBuffer->getNumGeometries(), 2000u);
+        ensure(gBuffer->isValid());
+    }
+
+} // namespace tut
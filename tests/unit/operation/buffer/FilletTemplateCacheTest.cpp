@@ -0,0 +1,191 @@
+//
+// Test Suite for geos::operation::buffer::FilletTemplateCache class.
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/operation/buffer/FilletTemplateCache.h>
+#include <geos/operation/buffer/BufferOp.h>
+#include <geos/operation/buffer/BufferParameters.h>
+#include <geos/platform.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used by tests
+    struct test_fillettemplatecache_data
+    {
+        geos::geom::GeometryFactory gf;
+        geos::io::WKTReader wktreader;
+
+        typedef geos::geom::Geometry::AutoPtr GeomPtr;
+        typedef geos::operation::buffer::FilletTemplateCache FilletTemplateCache;
+
+        test_fillettemplatecache_data()
+            : gf(), wktreader(&gf)
+        {}
+
+        GeomPtr buffer(const geos::geom::Geometry* g, double dist,
+                       FilletTemplateCache* cache,
+                       int quadrantSegments = 16)
+        {
+            using geos::operation::buffer::BufferOp;
+            BufferOp op(g);
+            op.setQuadrantSegments(quadrantSegments);
+            op.setFilletTemplateCache(cache);
+            return GeomPtr(op.getResultGeometry(dist));
+        }
+
+        // Checks a buffer against the one computed with sin/cos
+        // for every fillet vertex
+        void checkBuffer(const char* wkt, double dist,
+                         const char* expectedWKT)
+        {
+            GeomPtr g(wktreader.read(wkt));
+            GeomPtr expected(wktreader.read(expectedWKT));
+            FilletTemplateCache cache;
+
+            GeomPtr shared(buffer(g.get(), dist, &cache, 3));
+            GeomPtr perRun(buffer(g.get(), dist, NULL, 3));
+
+            ensure_equals(shared->getNumPoints(), expected->getNumPoints());
+            ensure(shared->equalsExact(expected.get(), 1e-12));
+            ensure_equals(perRun->getNumPoints(), expected->getNumPoints());
+            ensure(perRun->equalsExact(expected.get(), 1e-12));
+        }
+
+    private:
+        // noncopyable
+        test_fillettemplatecache_data(test_fillettemplatecache_data const& other);
+        test_fillettemplatecache_data& operator=(test_fillettemplatecache_data const& rhs);
+    };
+
+    typedef test_group<test_fillettemplatecache_data> group;
+    typedef group::object object;
+
+    group test_fillettemplatecache_group("geos::operation::buffer::FilletTemplateCache");
+
+    //
+    // Test Cases
+    //
+
+    // Unit circle template, computed once per quadrant segments
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        FilletTemplateCache cache;
+        const std::vector<geos::geom::Coordinate>& c8 = cache.getUnitCircle(8);
+
+        ensure_equals(c8.size(), std::size_t(32));
+        ensure_equals(c8[0].x, 1.0);
+        ensure_equals(c8[0].y, 0.0);
+        // clockwise: a quarter turn later we're at (0,-1)
+        ensure(std::fabs(c8[8].x) < 1e-12);
+        ensure(std::fabs(c8[8].y + 1.0) < 1e-12);
+        for (std::size_t i=0; i<c8.size(); ++i)
+        {
+            double r = std::sqrt(c8[i].x * c8[i].x + c8[i].y * c8[i].y);
+            ensure(std::fabs(r - 1.0) < 1e-12);
+        }
+
+        ensure_equals(&cache.getUnitCircle(8), &c8);
+        ensure_equals(cache.getUnitCircle(3).size(), std::size_t(12));
+        ensure_equals(cache.size(), std::size_t(2));
+
+        cache.clear();
+        ensure_equals(cache.size(), std::size_t(0));
+    }
+
+    // Buffers built from a shared cache match the ones built
+    // from a per-run cache
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        FilletTemplateCache cache;
+
+        GeomPtr pt(wktreader.read("POINT(10 20)"));
+        GeomPtr ln(wktreader.read("LINESTRING(0 0, 10 10, 20 0, 20 30)"));
+
+        GeomPtr pt1(buffer(pt.get(), 5, &cache));
+        GeomPtr pt2(buffer(pt.get(), 5, NULL));
+        ensure_equals(pt1->getNumPoints(), pt2->getNumPoints());
+        ensure(pt1->equalsExact(pt2.get(), 1e-9));
+
+        GeomPtr ln1(buffer(ln.get(), 3, &cache));
+        GeomPtr ln2(buffer(ln.get(), 3, NULL));
+        ensure_equals(ln1->getNumPoints(), ln2->getNumPoints());
+        ensure(ln1->equalsExact(ln2.get(), 1e-9));
+
+        ensure_equals(cache.size(), std::size_t(1));
+    }
+
+    // Round caps, joins and point buffers match the vertices
+    // computed with sin/cos before templates were introduced
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        checkBuffer("POINT (10 20)", 5,
+            "POLYGON ((15 20, 14.3301270189221945 17.5000000000000036, "
+            "12.5000000000000036 15.669872981077809, "
+            "10.0000000000000071 15, 7.5000000000000089 15.6698729810778019, "
+            "5.6698729810778135 17.4999999999999893, 5 19.9999999999999822, "
+            "5.6698729810777966 22.4999999999999822, "
+            "7.4999999999999822 24.3301270189221839, 9.9999999999999769 25, "
+            "12.4999999999999769 24.3301270189222052, "
+            "14.3301270189221786 22.5000000000000249, 15 20))");
+
+        checkBuffer("LINESTRING (0 0, 10 10, 20 0, 20 30)", 3,
+            "POLYGON ((7.8786796564403581 12.1213203435596419, "
+            "9.2235428646924369 12.897777478867205, "
+            "10.7764571353075631 12.897777478867205, "
+            "12.1213203435596419 12.1213203435596419, "
+            "17 7.2426406871192839, 17 30, 17.401923788646684 31.5000000000000036, "
+            "18.5 32.598076211353316, 20 33, 21.5 32.598076211353316, "
+            "22.598076211353316 31.5000000000000036, 23 30, 23 0, "
+            "22.6730195725651029 -1.3619714992186402, "
+            "21.7633557568774201 -2.4270509831248424, "
+            "20.4693033951206935 -2.9630650217854133, "
+            "19.0729490168751568 -2.8531695488854609, "
+            "17.8786796564403581 -2.1213203435596424, "
+            "10 5.7573593128807161, 2.1213203435596424 -2.1213203435596424, "
+            "0.7764571353075598 -2.8977774788672055, "
+            "-0.7764571353075632 -2.8977774788672046, "
+            "-2.1213203435596424 -2.1213203435596428, "
+            "-2.8977774788672042 -0.7764571353075644, "
+            "-2.8977774788672059 0.7764571353075586, "
+            "-2.1213203435596424 2.1213203435596424, "
+            "7.8786796564403581 12.1213203435596419))");
+
+        checkBuffer("POLYGON ((0 0, 10 0, 10 10, 5 3, 0 10, 0 0))", 2,
+            "POLYGON ((-2 0, -2 10, -1.7510561617491041 10.9663344754278906, "
+            "-1.0661976815995045 11.6921059375085949, "
+            "-0.1159158582583167 11.9966380527787795, "
+            "0.8632225037518425 11.8041194275924202, "
+            "1.62746694241347 11.1624763874381934, 5 6.440930106817051, "
+            "8.37253305758653 11.1624763874381934, "
+            "9.1367774962481576 11.8041194275924202, "
+            "10.1159158582583171 11.9966380527787795, "
+            "11.0661976815995047 11.6921059375085949, "
+            "11.7510561617491032 10.9663344754278906, 12 10, 12 0, "
+            "11.7320508075688767 -1, 11 -1.7320508075688774, 10 -2, 0 -2, "
+            "-0.9999999999999958 -1.7320508075688796, "
+            "-1.732050807568873 -1.0000000000000075, -2 0))");
+    }
+
+} // namespace tut
+
@@ -0,0 +1,169 @@
+// 
+// Test Suite for geos::operation::buffer::PartitionedBufferOp class.
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/operation/buffer/PartitionedBufferOp.h>
+#include <geos/operation/buffer/BufferOp.h>
+#include <geos/operation/buffer/BufferParameters.h>
+#include <geos/operation/buffer/FilletTemplateCache.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used by tests
+    struct test_partitionedbufferop_data
+    {
+        geos::geom::GeometryFactory gf;
+        geos::io::WKTReader wktreader;
+
+        typedef geos::geom::Geometry::AutoPtr GeomPtr;
+        typedef geos::operation::buffer::PartitionedBufferOp PartitionedBufferOp;
+
+        test_partitionedbufferop_data()
+            : gf(), wktreader(&gf)
+        {}
+
+        // Buffers the groups in reverse order, and merges them
+        GeomPtr bufferAll(const PartitionedBufferOp& op, double distance)
+        {
+            geos::operation::buffer::FilletTemplateCache cache;
+            std::vector<geos::geom::Geometry*> buffers;
+            for (std::size_t i=op.getNumGroups(); i>0; --i)
+            {
+                buffers.push_back(op.bufferGroup(i-1, distance, &cache));
+            }
+            GeomPtr result(op.unionGroupBuffers(buffers));
+            ensure(buffers.empty());
+            return result;
+        }
+
+    private:
+        // noncopyable
+        test_partitionedbufferop_data(test_partitionedbufferop_data const& other);
+        test_partitionedbufferop_data& operator=(test_partitionedbufferop_data const& rhs);
+    };
+
+    typedef test_group<test_partitionedbufferop_data> group;
+    typedef group::object object;
+
+    group test_partitionedbufferop_group("geos::operation::buffer::PartitionedBufferOp");
+
+    //
+    // Test Cases
+    //
+
+    // Union of the group buffers matches the single job buffer
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        using geos::operation::buffer::BufferOp;
+
+        std::string wkt0("MULTIPOINT(");
+        for (int i=0; i<12; ++i)
+        {
+            for (int j=0; j<12; ++j)
+            {
+                std::ostringstream os;
+                os << (i||j ? "," : "") << "(" << i*3 + (j%2) << " " << j*3 << ")";
+                wkt0 += os.str();
+            }
+        }
+        wkt0 += ")";
+        GeomPtr g0(wktreader.read(wkt0));
+        ensure_equals(g0->getNumGeometries(), std::size_t(144));
+
+        double const distance = 2.0;
+
+        BufferOp op1(g0.get());
+        GeomPtr gBuffer1(op1.getResultGeometry(distance));
+
+        PartitionedBufferOp op2(g0.get(), 10);
+        ensure_equals(op2.getNumGroups(), std::size_t(15));
+        std::size_t nComps = 0;
+        for (std::size_t i=0; i<op2.getNumGroups(); ++i)
+        {
+            std::size_t n = op2.getGroup(i)->getNumGeometries();
+            ensure(n <= 10);
+            nComps += n;
+        }
+        ensure_equals(nComps, std::size_t(144));
+
+        GeomPtr gBuffer2(bufferAll(op2, distance));
+
+        ensure(gBuffer2->isValid());
+        ensure_equals(gBuffer2->getGeometryTypeId(), gBuffer1->getGeometryTypeId());
+        ensure_equals(gBuffer2->getNumGeometries(), gBuffer1->getNumGeometries());
+        ensure(std::fabs(gBuffer2->getArea() - gBuffer1->getArea()) < 1e-6);
+        ensure(gBuffer1->equals(gBuffer2.get()));
+    }
+
+    // Single geometries and empty collections
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        GeomPtr g0(wktreader.read("LINESTRING (0 0, 10 0, 10 10)"));
+        PartitionedBufferOp op0(g0.get(), 10);
+        ensure_equals(op0.getNumGroups(), std::size_t(1));
+        GeomPtr gBuffer0(bufferAll(op0, 1.0));
+        ensure(gBuffer0->equals(GeomPtr(g0->buffer(1.0)).get()));
+
+        GeomPtr g1(wktreader.read("MULTIPOLYGON EMPTY"));
+        PartitionedBufferOp op1(g1.get(), 10);
+        ensure_equals(op1.getNumGroups(), std::size_t(0));
+        GeomPtr gBuffer1(bufferAll(op1, 1.0));
+        ensure(gBuffer1->isEmpty());
+    }
+
+    // Invalid arguments
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        using geos::operation::buffer::BufferParameters;
+        using geos::util::IllegalArgumentException;
+
+        GeomPtr g0(wktreader.read("MULTIPOINT ((0 0), (10 0))"));
+
+        try {
+            PartitionedBufferOp op(g0.get(), 0);
+            fail("IllegalArgumentException expected");
+        } catch (const IllegalArgumentException&) {
+        }
+
+        BufferParameters params;
+        params.setSingleSided(true);
+        try {
+            PartitionedBufferOp op(g0.get(), 1, params);
+            fail("IllegalArgumentException expected");
+        } catch (const IllegalArgumentException&) {
+        }
+
+        // The buffer of a union is not the union of the
+        // buffers for negative distances
+        PartitionedBufferOp op(g0.get(), 1);
+        try {
+            GeomPtr b(op.bufferGroup(0, -1.0));
+            fail("IllegalArgumentException expected");
+        } catch (const IllegalArgumentException&) {
+        }
+    }
+
+} // namespace tut
+
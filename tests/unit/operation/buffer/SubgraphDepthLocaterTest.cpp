@@ -0,0 +1,203 @@
+//
+// Test Suite for geos::operation::buffer::SubgraphDepthLocater class.
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/operation/buffer/SubgraphDepthLocater.h>
+#include <geos/operation/buffer/BufferSubgraph.h>
+#include <geos/operation/overlay/OverlayNodeFactory.h>
+#include <geos/geomgraph/PlanarGraph.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geomgraph/Label.h>
+#include <geos/geomgraph/Node.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Location.h>
+// std
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used by tests
+    struct test_subgraphdepthlocater_data
+    {
+        typedef geos::operation::buffer::BufferSubgraph BufferSubgraph;
+        typedef geos::operation::buffer::SubgraphDepthLocater SubgraphDepthLocater;
+
+        geos::geomgraph::PlanarGraph graph;
+        std::vector<geos::geomgraph::Edge*> edges;
+        std::vector<BufferSubgraph*> subgraphs;
+
+        test_subgraphdepthlocater_data()
+            : graph(geos::operation::overlay::OverlayNodeFactory::instance())
+        {}
+
+        ~test_subgraphdepthlocater_data()
+        {
+            for (std::size_t i=0; i<subgraphs.size(); ++i)
+                delete subgraphs[i];
+        }
+
+        // Adds a clockwise square, labelled as a buffer curve
+        // with its interior on the right
+        void addSquare(double x, double y, double size)
+        {
+            using geos::geom::Coordinate;
+            using geos::geom::Location;
+
+            std::auto_ptr<geos::geom::CoordinateSequence> cs(
+                new geos::geom::CoordinateArraySequence());
+            cs->add(Coordinate(x, y));
+            cs->add(Coordinate(x, y + size));
+            cs->add(Coordinate(x + size, y + size));
+            cs->add(Coordinate(x + size, y));
+            cs->add(Coordinate(x, y));
+
+            geos::geomgraph::Label label(0, Location::BOUNDARY,
+                    Location::EXTERIOR, Location::INTERIOR);
+            geos::geomgraph::Edge* e =
+                new geos::geomgraph::Edge(cs.release(), label);
+            // crossing from right to left leaves the interior
+            e->setDepthDelta(-1);
+            edges.push_back(e);
+        }
+
+        // Builds the subgraphs in descending order of their
+        // rightmost coordinate, as BufferBuilder does
+        void createSubgraphs()
+        {
+            graph.addEdges(edges);
+            std::vector<geos::geomgraph::Node*> nodes;
+            graph.getNodes(nodes);
+            for (std::size_t i=0; i<nodes.size(); ++i)
+            {
+                if (nodes[i]->isVisited()) continue;
+                BufferSubgraph* subgraph = new BufferSubgraph();
+                subgraph->create(nodes[i]);
+                subgraphs.push_back(subgraph);
+            }
+            std::sort(subgraphs.begin(), subgraphs.end(),
+                      geos::operation::buffer::BufferSubgraphGT);
+        }
+
+        // Computes the depths of the subgraphs as BufferBuilder
+        // does, and returns the outside depth of each
+        std::vector<int> computeDepths()
+        {
+            std::vector<int> depths;
+            SubgraphDepthLocater locater(&subgraphs);
+            for (std::size_t i=0; i<subgraphs.size(); ++i)
+            {
+                locater.setNumProcessed(i);
+                int depth = locater.getDepth(
+                        *subgraphs[i]->getRightmostCoordinate());
+                subgraphs[i]->computeDepth(depth);
+                depths.push_back(depth);
+            }
+            return depths;
+        }
+
+    private:
+        // noncopyable
+        test_subgraphdepthlocater_data(test_subgraphdepthlocater_data const& other);
+        test_subgraphdepthlocater_data& operator=(test_subgraphdepthlocater_data const& rhs);
+    };
+
+    typedef test_group<test_subgraphdepthlocater_data> group;
+    typedef group::object object;
+
+    group test_subgraphdepthlocater_group("geos::operation::buffer::SubgraphDepthLocater");
+
+    //
+    // Test Cases
+    //
+
+    // Nested squares, and a disjoint one on the right
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        addSquare(0, 0, 30);
+        addSquare(5, 5, 20);
+        addSquare(10, 10, 10);
+        addSquare(40, 0, 10);
+        createSubgraphs();
+        ensure_equals(subgraphs.size(), 4u);
+
+        std::vector<int> depths = computeDepths();
+        ensure_equals(depths[0], 0); // disjoint
+        ensure_equals(depths[1], 0); // outer
+        ensure_equals(depths[2], 1); // middle
+        ensure_equals(depths[3], 2); // inner
+    }
+
+    // Subgraphs past the processed ones are ignored
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        addSquare(0, 0, 30);
+        addSquare(10, 10, 10);
+        createSubgraphs();
+        computeDepths();
+
+        geos::geom::Coordinate p(15, 15);
+        SubgraphDepthLocater locater(&subgraphs);
+        ensure_equals(locater.getDepth(p), 2);
+        locater.setNumProcessed(1);
+        ensure_equals(locater.getDepth(p), 1);
+        locater.setNumProcessed(0);
+        ensure_equals(locater.getDepth(p), 0);
+
+        // Outside all envelopes
+        geos::geom::Coordinate q(50, 15);
+        locater.setNumProcessed(2);
+        ensure_equals(locater.getDepth(q), 0);
+    }
+
+    // Grid of many nested pairs
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        for (int i=0; i<30; ++i)
+        {
+            for (int j=0; j<30; ++j)
+            {
+                addSquare(i * 10, j * 10, 8);
+                addSquare(i * 10 + 2, j * 10 + 2, 4);
+            }
+        }
+        createSubgraphs();
+        ensure_equals(subgraphs.size(), 1800u);
+
+        std::vector<int> depths = computeDepths();
+        for (std::size_t i=0; i<subgraphs.size(); ++i)
+        {
+            const geos::geom::Coordinate* p =
+                subgraphs[i]->getRightmostCoordinate();
+            // inner squares end at 6 past a multiple of 10
+            bool inner = int(p->x) % 10 == 6;
+            ensure_equals(depths[i], inner ? 1 : 0);
+        }
+    }
+
+    // No subgraphs
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        SubgraphDepthLocater locater(&subgraphs);
+        ensure_equals(locater.getDepth(geos::geom::Coordinate(0, 0)), 0);
+    }
+
+} // namespace tut
+
@@ -5,6 +5,7 @@
 #include <tut.hpp>
 // geos
 #include <geos/operation/overlay/snap/LineStringSnapper.h>
+#include <geos/operation/overlay/snap/SnapPointIndex.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateList.h>
 #include <geos/geom/CoordinateArraySequence.h>
@@ -331,4 +332,59 @@ namespace tut
   }
 */
 
+  // Test snapping several lines with a shared index:
+  // the first snap point within tolerance wins, as without index
+  template<>
+  template<>
+  void object::test<9>()
+  {
+    using geos::geom::Coordinate;
+    using geos::operation::overlay::snap::LineStringSnapper;
+    using geos::operation::overlay::snap::SnapPointIndex;
+
+    typedef std::auto_ptr<Coordinate::Vect> CoordsVectAptr;
+
+    // Snap: (0.4 0), (-0.3 0), (5 0.2), (5 0.6)
+    Coordinate snp_a(0.4, 0);
+    Coordinate snp_b(-0.3, 0);
+    Coordinate snp_c(5, 0.2);
+    Coordinate snp_d(5, 0.6);
+    Coordinate::ConstVect snpCoords;
+    snpCoords.push_back( &snp_a );
+    snpCoords.push_back( &snp_b );
+    snpCoords.push_back( &snp_c );
+    snpCoords.push_back( &snp_d );
+    SnapPointIndex snapIndex(snpCoords);
+
+    // Source: (0 0, 10 0)
+    Coordinate::Vect srcCoords1;
+    srcCoords1.push_back(Coordinate(0, 0));
+    srcCoords1.push_back(Coordinate(10, 0));
+
+    // Expect: (0.4 0, 5 0.6, 5 0.2, 10 0)
+    // (0.4 0) comes first, though (-0.3 0) is closer.
+    // (5 0.6) is out of tolerance from the source segment,
+    // but not from the two segments (5 0.2) split it into:
+    // the first one is snapped
+    LineStringSnapper snapper1(srcCoords1, 0.5);
+    CoordsVectAptr ret(snapper1.snapTo(snapIndex));
+    ensure_equals(ret->size(), 4u);
+    ensure_equals(ret->operator[](0), snp_a);
+    ensure_equals(ret->operator[](1), snp_d);
+    ensure_equals(ret->operator[](2), snp_c);
+    ensure_equals(ret->operator[](3), Coordinate(10, 0));
+
+    // Source: (-0.2 5, -0.2 0.1)
+    Coordinate::Vect srcCoords2;
+    srcCoords2.push_back(Coordinate(-0.2, 5));
+    srcCoords2.push_back(Coordinate(-0.2, 0.1));
+
+    // Expect: (-0.2 5, -0.3 0)
+    LineStringSnapper snapper2(srcCoords2, 0.5);
+    ret = snapper2.snapTo(snapIndex);
+    ensure_equals(ret->size(), 2u);
+    ensure_equals(ret->operator[](0), Coordinate(-0.2, 5));
+    ensure_equals(ret->operator[](1), snp_b);
+  }
+
 } // namespace tut
@@ -0,0 +1,176 @@
+//
+// Test Suite for geos::operation::geounion::CoverageUnion class.
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/operation/union/CoverageUnion.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+#include <geos/io/WKTWriter.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/TopologyException.h>
+// std
+#include <memory>
+#include <string>
+#include <iostream>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used by tests
+    struct test_coverageunion_data
+    {
+        geos::geom::GeometryFactory gf;
+        geos::io::WKTReader wktreader;
+        geos::io::WKTWriter wktwriter;
+
+        typedef geos::geom::Geometry::AutoPtr GeomPtr;
+        typedef geos::geom::Geometry Geom;
+        typedef geos::operation::geounion::CoverageUnion CoverageUnion;
+
+        test_coverageunion_data()
+          : gf(),
+            wktreader(&gf)
+        {
+          wktwriter.setTrim(true);
+        }
+
+        GeomPtr readWKT(const std::string& inputWKT)
+        {
+            return GeomPtr(wktreader.read(inputWKT));
+        }
+
+        bool isEqual(const Geom& a, const Geom& b)
+        {
+          GeomPtr a2 ( a.clone() );
+          GeomPtr b2 ( b.clone() );
+          a2->normalize();
+          b2->normalize();
+          bool eq = a2->equalsExact(b2.get());
+          if  ( ! eq ) {
+            std::cout << "OBTAINED: " << wktwriter.write(b2.get())
+                      << std::endl;
+          }
+          return eq;
+        }
+
+        void checkUnion(const std::string& inputWKT,
+                        const std::string& expectedWKT)
+        {
+          GeomPtr input = readWKT(inputWKT);
+          GeomPtr expected = readWKT(expectedWKT);
+          GeomPtr result = CoverageUnion::Union(*input);
+          ensure( isEqual(*expected, *result) );
+          ensure( result->isValid() );
+        }
+    };
+
+    typedef test_group<test_coverageunion_data> group;
+    typedef group::object object;
+
+    group test_coverageunion_group("geos::operation::geounion::CoverageUnion");
+
+    //
+    // Test Cases
+    //
+
+    // Two adjacent squares, one with a reversed shell
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        checkUnion(
+          "MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)),((1 0,2 0,2 1,1 1,1 0)))",
+          "POLYGON((0 0,0 1,1 1,2 1,2 0,1 0,0 0))");
+    }
+
+    // A hole left by the coverage
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        checkUnion(
+          "GEOMETRYCOLLECTION("
+          "POLYGON((0 0,0 3,1 3,1 2,1 1,1 0,0 0)),"
+          "POLYGON((1 0,1 1,2 1,2 0,1 0)),"
+          "POLYGON((1 2,1 3,2 3,2 2,1 2)),"
+          "POLYGON((2 0,2 1,2 2,2 3,3 3,3 0,2 0)))",
+          "POLYGON((0 0,0 3,1 3,2 3,3 3,3 0,2 0,1 0,0 0),"
+          "(1 1,2 1,2 2,1 2,1 1))");
+    }
+
+    // A polygon filling a hole, and an island within it
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        checkUnion(
+          "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),(2 2,8 2,8 8,2 8,2 2)),"
+          "((2 2,8 2,8 8,2 8,2 2),(4 4,6 4,6 6,4 6,4 4)),"
+          "((4 4,6 4,6 6,4 6,4 4)))",
+          "POLYGON((0 0,0 10,10 10,10 0,0 0))");
+
+        checkUnion(
+          "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),(2 2,8 2,8 8,2 8,2 2)),"
+          "((4 4,6 4,6 6,4 6,4 4)))",
+          "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),(2 2,8 2,8 8,2 8,2 2)),"
+          "((4 4,6 4,6 6,4 6,4 4)))");
+    }
+
+    // Polygons touching at a vertex are not merged
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        checkUnion(
+          "MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)),((1 1,1 2,2 2,2 1,1 1)),"
+          "((1 0,1 1,2 1,2 0,1 0)))",
+          "POLYGON((0 0,0 1,1 1,1 2,2 2,2 1,2 0,1 0,0 0))");
+
+        checkUnion(
+          "MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)),((1 1,1 2,2 2,2 1,1 1)))",
+          "MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)),((1 1,1 2,2 2,2 1,1 1)))");
+    }
+
+    // Empty input
+    template<>
+    template<>
+    void object::test<5>()
+    {
+        GeomPtr input = readWKT("MULTIPOLYGON EMPTY");
+        GeomPtr result = CoverageUnion::Union(*input);
+        ensure_equals(wktwriter.write(result.get()),
+                      std::string("GEOMETRYCOLLECTION EMPTY"));
+    }
+
+    // Invalid inputs
+    template<>
+    template<>
+    void object::test<6>()
+    {
+        // duplicated polygon
+        GeomPtr input = readWKT(
+          "MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)),((0 0,0 1,1 1,1 0,0 0)))");
+        try {
+            CoverageUnion::Union(*input);
+            fail("TopologyException expected");
+        } catch (const geos::util::TopologyException&) {
+        }
+
+        // non polygonal component
+        input = readWKT(
+          "GEOMETRYCOLLECTION(POLYGON((0 0,0 1,1 1,1 0,0 0)),POINT(5 5))");
+        try {
+            CoverageUnion::Union(*input);
+            fail("IllegalArgumentException expected");
+        } catch (const geos::util::IllegalArgumentException&) {
+        }
+    }
+
+} // namespace tut
+
@@ -11,6 +11,7 @@
 #include <geos/geom/Point.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKTWriter.h>
+#include <geos/platform.h> // for ISNAN
 // std
 #include <memory>
 #include <string>
@@ -178,5 +179,73 @@ namespace tut
         doTest(geoms, "MULTILINESTRING ((0 0, 5 0), (5 0, 10 0, 5 -5, 5 0), (5 0, 5 5))");
     }
 
-} // namespace tut
+    // Overlapping and duplicated lines
+    template<>
+    template<>
+    void object::test<7>()
+    {
+        static char const* const geoms[] = 
+        {
+            "LINESTRING (0 0, 10 0)",
+            "LINESTRING (5 0, 15 0)",
+            "LINESTRING (10 0, 0 0)",
+            "MULTILINESTRING ((5 -5, 5 5), (0 0, 10 0))",
+            NULL
+        };
+        doTest(geoms, "MULTILINESTRING ((0 0, 5 0), (5 0, 10 0), (10 0, 15 0), (5 -5, 5 0), (5 0, 5 5))");
+    }
+
+    // Merged lines
+    template<>
+    template<>
+    void object::test<8>()
+    {
+        GeomPtr input = readWKT("MULTILINESTRING ((0 0, 10 0), (5 0, 15 0), (15 0, 20 5), (5 -5, 5 5))");
+
+        UnaryUnionOp op(*input);
+        op.setMergeLines(true);
+        GeomPtr result = op.Union();
+
+        ensure( isEqual(*readWKT("MULTILINESTRING ((0 0, 5 0), (5 0, 10 0, 15 0, 20 5), (5 -5, 5 0), (5 0, 5 5))"), *result) );
+    }
+
+    // Points against lines and polygons
+    template<>
+    template<>
+    void object::test<9>()
+    {
+        static char const* const geoms[] = 
+        {
+            "MULTIPOINT (0 0, 5 5, 3 3, 20 20, 5 5, 12 12, 11 0)",
+            "LINESTRING (10 0, 12 0)",
+            "POINT (20 20)",
+            "POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))",
+            "POLYGON ((30 30, 40 30, 40 40, 30 30))",
+            NULL
+        };
+        doTest(geoms, "GEOMETRYCOLLECTION (POINT (12 12), POINT (20 20), LINESTRING (10 0, 12 0), POLYGON ((0 0, 0 10, 10 10, 10 0, 0 0)), POLYGON ((30 30, 40 40, 40 30, 30 30)))");
+    }
+
+    // Coincident points get the average of their distinct Z values
+    template<>
+    template<>
+    void object::test<10>()
+    {
+        static char const* const geoms[] = 
+        {
+            "MULTIPOINT (1 1 4, 2 2, 1 1 4, 1 1 1, 1 1)",
+            NULL
+        };
+        std::vector<Geom*> input;
+        readWKT(geoms, input);
+        GeomPtr result = UnaryUnionOp::Union(input);
+        delAll(input);
+
+        ensure_equals( result->getNumGeometries(), 2u );
+        const geos::geom::Coordinate* c = result->getGeometryN(0)->getCoordinate();
+        ensure_equals( c->x, 1 );
+        ensure_equals( c->z, 2.5 );
+        ensure( ISNAN(result->getGeometryN(1)->getCoordinate()->z) );
+    }
 
+} // namespace tut
@@ -14,9 +14,11 @@
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/PrecisionModel.h>
 #include <geos/operation/valid/TopologyValidationError.h>
+#include <geos/io/WKTReader.h>
 #include <geos/platform.h> // for ISNAN
 // std
 #include <cmath>
+#include <sstream>
 #include <string>
 #include <memory>
 
@@ -77,4 +79,53 @@ namespace tut
     }
 
 
+    // 2 - Nested shells in a MultiPolygon with many components
+    template<>
+    template<>
+    void object::test<2>()
+    {
+	geos::io::WKTReader reader(&factory_);
+
+	std::ostringstream wkt;
+	wkt << "MULTIPOLYGON(";
+	// a polygon with a hole and an island in it
+	wkt << "((0 0, 100 0, 100 100, 0 100, 0 0),(10 10, 90 10, 90 90, 10 90, 10 10)),";
+	wkt << "((20 20, 80 20, 80 80, 20 80, 20 20))";
+	for (int i=0; i<20; ++i)
+	{
+		int x = 200 + i * 10;
+		wkt << ",((" << x << " 0, " << x+5 << " 0, " << x+5 << " 5, "
+		    << x << " 5, " << x << " 0))";
+	}
+	std::string valid = wkt.str() + ")";
+	// a shell within the polygon, outside of its hole
+	std::string nested = wkt.str() + ",((1 1, 5 1, 5 5, 1 5, 1 1)))";
+
+	GeomPtr g1(reader.read(valid));
+	IsValidOp op1(g1.get());
+	ensure(op1.isValid());
+
+	GeomPtr g2(reader.read(nested));
+	IsValidOp op2(g2.get());
+	ensure_not(op2.isValid());
+	ensure_equals(op2.getValidationError()->getErrorType(),
+	              TopologyValidationError::eNestedShells);
+    }
+
+    // 3 - Hole outside of its shell
+    template<>
+    template<>
+    void object::test<3>()
+    {
+	geos::io::WKTReader reader(&factory_);
+
+	GeomPtr g(reader.read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0),(20 20, 30 20, 30 30, 20 30, 20 20))"));
+	IsValidOp op(g.get());
+	ensure_not(op.isValid());
+	ensure_equals(op.getValidationError()->getErrorType(),
+	              TopologyValidationError::eHoleOutsideShell);
+	ensure_equals(op.getValidationError()->getCoordinate(),
+	              Coordinate(20, 20));
+    }
+
 } // namespace tut
@@ -335,5 +335,20 @@ namespace tut
         //std::string const simplifiedWkt2 = wktwriter.write(simplified2.get());
 	}
 
-} // namespace tut
+	// 12 - ClosedLine: the first section has a zero length chord
+	template<>
+	template<>
+	void object::test<12>()
+	{
+		std::string wkt_in("LINESTRING (0 0, 5 0.5, 10 0, 10 10, 0 10, 0 0)");
+		std::string wkt_ex("LINESTRING (0 0, 10 0, 10 10, 0 10, 0 0)");
+
+		GeomPtr g(wktreader.read(wkt_in));
+		GeomPtr expected(wktreader.read(wkt_ex));
+
+		GeomPtr simplified = DouglasPeuckerSimplifier::simplify(g.get(), 1.0);
+
+		ensure( simplified->equalsExact(expected.get()) );
+	}
 
+} // namespace tut
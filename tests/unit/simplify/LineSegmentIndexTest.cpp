@@ -0,0 +1,228 @@
+//
+// Test Suite for geos::simplify::LineSegmentIndex
+
+#include <tut.hpp>
+// geos
+#include <geos/simplify/LineSegmentIndex.h>
+#include <geos/geom/LineSegment.h>
+#include <geos/geom/Coordinate.h>
+// std
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace tut
+{
+	using geos::simplify::LineSegmentIndex;
+	using geos::geom::LineSegment;
+	using geos::geom::Coordinate;
+
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_linesegmentindex_data
+	{
+		typedef std::vector<LineSegment*> SegVect;
+
+		/// Segments to index, owned here
+		std::vector<LineSegment> segs;
+
+		/// Segments in the index
+		std::vector<bool> indexed;
+
+		unsigned int seed;
+
+		test_linesegmentindex_data() : seed(4321) {}
+
+		double random(double max)
+		{
+			seed = seed * 1103515245 + 12345;
+			return max * double((seed >> 16) % 10001) / 10000.0;
+		}
+
+		// Short segments spread over a 1000x1000 square,
+		// including some horizontal and vertical ones
+		void makeSegments(std::size_t n)
+		{
+			segs.reserve(n);
+			for (std::size_t i=0; i<n; ++i)
+			{
+				double x = random(1000);
+				double y = random(1000);
+				double dx = i % 7 == 0 ? 0 : random(40) - 20;
+				double dy = i % 11 == 0 ? 0 : random(40) - 20;
+				segs.push_back(LineSegment(x, y, x + dx, y + dy));
+			}
+			indexed.assign(n, false);
+		}
+
+		void add(LineSegmentIndex& index, std::size_t from, std::size_t to)
+		{
+			for (std::size_t i=from; i<to; ++i)
+			{
+				index.add(&segs[i]);
+				indexed[i] = true;
+			}
+		}
+
+		void remove(LineSegmentIndex& index, std::size_t i)
+		{
+			index.remove(&segs[i]);
+			indexed[i] = false;
+		}
+
+		static bool intersects(const LineSegment& a, const LineSegment& b)
+		{
+			using std::min;
+			using std::max;
+			return ! ( min(a.p0.x, a.p1.x) > max(b.p0.x, b.p1.x)
+			        || max(a.p0.x, a.p1.x) < min(b.p0.x, b.p1.x)
+			        || min(a.p0.y, a.p1.y) > max(b.p0.y, b.p1.y)
+			        || max(a.p0.y, a.p1.y) < min(b.p0.y, b.p1.y) );
+		}
+
+		// Checks query results against a brute force envelope
+		// filter of the indexed segments
+		void checkQueries(const LineSegmentIndex& index)
+		{
+			for (int q=0; q<100; ++q)
+			{
+				double x = random(1000);
+				double y = random(1000);
+				double size = q % 10 == 0 ? 300 : random(60);
+				LineSegment querySeg(x, y, x + size, y + size / 2);
+
+				SegVect expected;
+				for (std::size_t i=0; i<segs.size(); ++i)
+				{
+					if ( indexed[i] && intersects(segs[i], querySeg) )
+						expected.push_back(&segs[i]);
+				}
+
+				std::auto_ptr<SegVect> obtained(index.query(&querySeg));
+				std::sort(obtained->begin(), obtained->end());
+				ensure(std::adjacent_find(obtained->begin(),
+				       obtained->end()) == obtained->end());
+				ensure_equals(obtained->size(), expected.size());
+				ensure(*obtained == expected);
+			}
+		}
+	};
+
+	typedef test_group<test_linesegmentindex_data> group;
+	typedef group::object object;
+
+	group test_linesegmentindex_group("geos::simplify::LineSegmentIndex");
+
+	//
+	// Test Cases
+	//
+
+	// Queries on an empty index
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		makeSegments(10);
+		LineSegmentIndex index;
+		checkQueries(index);
+
+		// Removing a segment which is not there does nothing
+		remove(index, 3);
+		checkQueries(index);
+	}
+
+	// Queries against a brute force filter, for sizes around
+	// the pending buffer size and over many packed trees
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		makeSegments(3000);
+		std::size_t sizes[] = { 1, 63, 64, 65, 66, 130, 500, 3000 };
+
+		LineSegmentIndex index;
+		std::size_t added = 0;
+		for (std::size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); ++i)
+		{
+			add(index, added, sizes[i]);
+			added = sizes[i];
+			checkQueries(index);
+		}
+	}
+
+	// Removal of pending segments and of packed ones,
+	// across the pending buffer size
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		makeSegments(400);
+		LineSegmentIndex index;
+
+		// Only pending segments
+		add(index, 0, 64);
+		remove(index, 0);
+		remove(index, 63);
+		remove(index, 30);
+		checkQueries(index);
+
+		// Packed into a tree by the next removal
+		add(index, 64, 70);
+		remove(index, 65);
+		checkQueries(index);
+
+		// Newly pending ones and packed ones
+		add(index, 70, 100);
+		for (std::size_t i=1; i<100; i+=3) remove(index, i);
+		checkQueries(index);
+
+		// A segment added back after its removal
+		index.add(&segs[1]);
+		indexed[1] = true;
+		checkQueries(index);
+
+		// Removing twice
+		remove(index, 1);
+		remove(index, 1);
+		checkQueries(index);
+
+		// More trees
+		add(index, 100, 400);
+		for (std::size_t i=100; i<400; i+=2) remove(index, i);
+		checkQueries(index);
+	}
+
+	// Trees are repacked once most of their segments are removed,
+	// and the remaining ones are still found
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		makeSegments(2000);
+		LineSegmentIndex index;
+		add(index, 0, 2000);
+		checkQueries(index);
+
+		// Remove in an order unrelated to the tree layout,
+		// checking around the point where half are removed
+		for (std::size_t i=0; i<2000; ++i)
+		{
+			std::size_t k = (i * 7919) % 2000;
+			remove(index, k);
+			if ( i == 999 || i == 1000 || i == 1001 || i == 1500
+			     || i == 1990 )
+				checkQueries(index);
+		}
+		checkQueries(index);
+
+		// Refill the emptied index
+		add(index, 0, 500);
+		checkQueries(index);
+	}
+
+} // namespace tut
+
@@ -0,0 +1,159 @@
+//
+// Test Suite for geos::simplify::TaggedLinesSimplifier
+
+#include <tut.hpp>
+// geos
+#include <geos/io/WKTReader.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/simplify/TaggedLinesSimplifier.h>
+#include <geos/simplify/TaggedLineString.h>
+// std
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tut
+{
+	using namespace geos::simplify;
+
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_taggedlinessimplifier_data
+	{
+		geos::geom::PrecisionModel pm;
+		geos::geom::GeometryFactory gf;
+		geos::io::WKTReader wktreader;
+
+		typedef geos::geom::Geometry::AutoPtr GeomPtr;
+		typedef std::vector<TaggedLineString*> LineVect;
+		typedef std::vector< std::vector<std::size_t> > Clusters;
+
+		GeomPtr geom;
+
+		test_taggedlinessimplifier_data()
+			: pm(1.0), gf(&pm), wktreader(&gf)
+		{
+			// Zig-zags crossed by a stick under their apex, which
+			// stops them from being simplified to a straight line,
+			// in two clusters given in interleaved order, and a
+			// lone zig-zag
+			geom.reset(wktreader.read(
+				"MULTILINESTRING("
+				"(0 0, 5 3, 10 0, 15 3, 20 0),"
+				"(100 0, 105 3, 110 0, 115 3, 120 0),"
+				"(5 -1, 5 1),"
+				"(105 -1, 105 1),"
+				"(200 0, 205 3, 210 0, 215 3, 220 0))"));
+		}
+
+		void makeLines(LineVect& lines)
+		{
+			for (std::size_t i=0; i<geom->getNumGeometries(); ++i)
+			{
+				const geos::geom::LineString* ls =
+					dynamic_cast<const geos::geom::LineString*>(
+						geom->getGeometryN(i));
+				lines.push_back(new TaggedLineString(ls, 2));
+			}
+		}
+
+		static void deleteLines(LineVect& lines)
+		{
+			for (std::size_t i=0; i<lines.size(); ++i) delete lines[i];
+			lines.clear();
+		}
+
+		static std::string result(const TaggedLineString& line)
+		{
+			return line.getResultCoordinates()->toString();
+		}
+	};
+
+	typedef test_group<test_taggedlinessimplifier_data> group;
+	typedef group::object object;
+
+	group test_taggedlinessimplifier_group("geos::simplify::TaggedLinesSimplifier");
+
+	//
+	// Test Cases
+	//
+
+	// Clusters of lines with intersecting envelopes
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		LineVect lines;
+		makeLines(lines);
+
+		Clusters clusters;
+		TaggedLinesSimplifier::computeClusters(lines, clusters);
+		deleteLines(lines);
+
+		ensure_equals(clusters.size(), 3u);
+		ensure_equals(clusters[0].size(), 2u);
+		ensure_equals(clusters[0][0], 0u);
+		ensure_equals(clusters[0][1], 2u);
+		ensure_equals(clusters[1].size(), 2u);
+		ensure_equals(clusters[1][0], 1u);
+		ensure_equals(clusters[1][1], 3u);
+		ensure_equals(clusters[2].size(), 1u);
+		ensure_equals(clusters[2][0], 4u);
+
+		// No lines, no clusters
+		Clusters none;
+		TaggedLinesSimplifier::computeClusters(lines, none);
+		ensure(none.empty());
+	}
+
+	// Simplifying each cluster on its own, in any order, gives
+	// the same lines as simplifying them all together
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		LineVect all;
+		makeLines(all);
+		TaggedLinesSimplifier simplifier;
+		simplifier.setDistanceTolerance(5.0);
+		simplifier.simplify(all.begin(), all.end());
+
+		// The sticks keep the first apex of the zig-zags
+		ensure_equals(all[0]->getResultSize(), 3u);
+		ensure_equals(all[1]->getResultSize(), 3u);
+		ensure_equals(all[4]->getResultSize(), 2u);
+
+		LineVect lines;
+		makeLines(lines);
+		Clusters clusters;
+		TaggedLinesSimplifier::computeClusters(lines, clusters);
+		for (std::size_t i=clusters.size(); i>0; --i)
+		{
+			const std::vector<std::size_t>& cluster = clusters[i-1];
+			LineVect clusterLines;
+			for (std::size_t j=0; j<cluster.size(); ++j)
+				clusterLines.push_back(lines[cluster[j]]);
+
+			TaggedLinesSimplifier clusterSimplifier;
+			clusterSimplifier.setDistanceTolerance(5.0);
+			clusterSimplifier.simplify(clusterLines.begin(),
+			                           clusterLines.end());
+		}
+
+		for (std::size_t i=0; i<all.size(); ++i)
+			ensure_equals(result(*lines[i]), result(*all[i]));
+
+		deleteLines(lines);
+		deleteLines(all);
+	}
+
+} // namespace tut
+
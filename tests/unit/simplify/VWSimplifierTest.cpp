@@ -0,0 +1,167 @@
+//
+// Test Suite for geos::simplify::VWSimplifier
+
+#include <tut.hpp>
+// geos
+#include <geos/io/WKTReader.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/simplify/VWSimplifier.h>
+#include <geos/simplify/VWLineSimplifier.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <string>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+namespace tut
+{
+	using namespace geos::simplify;
+	using geos::geom::Coordinate;
+
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_vwsimp_data
+	{
+		geos::geom::PrecisionModel pm;
+		geos::geom::GeometryFactory gf;
+		geos::io::WKTReader wktreader;
+
+		typedef geos::geom::Geometry::AutoPtr GeomPtr;
+
+		test_vwsimp_data()
+			:
+			pm(geos::geom::PrecisionModel::FLOATING),
+			gf(&pm),
+			wktreader(&gf)
+		{}
+
+		static double area(const Coordinate& a, const Coordinate& b,
+		                   const Coordinate& c)
+		{
+			return std::fabs( (b.x - a.x) * (c.y - a.y) -
+			                  (c.x - a.x) * (b.y - a.y) ) / 2.0;
+		}
+
+		// Straightforward quadratic Visvalingam-Whyatt
+		static std::vector<Coordinate> naiveSimplify(
+				std::vector<Coordinate> pts, double tolerance)
+		{
+			double areaTolerance = tolerance * tolerance;
+			while ( pts.size() > 2 )
+			{
+				std::size_t minIndex = 1;
+				double minArea = area(pts[0], pts[1], pts[2]);
+				for (std::size_t i=2; i<pts.size()-1; ++i)
+				{
+					double a = area(pts[i-1], pts[i], pts[i+1]);
+					if ( a < minArea ) { minArea = a; minIndex = i; }
+				}
+				if ( minArea >= areaTolerance ) break;
+				pts.erase(pts.begin() + minIndex);
+			}
+			return pts;
+		}
+	};
+
+	typedef test_group<test_vwsimp_data> group;
+	typedef group::object object;
+
+	group test_vwsimp_group("geos::simplify::VWSimplifier");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - LineReduction
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		GeomPtr g(wktreader.read("LINESTRING (0 0, 1 0.1, 2 0, 3 5, 4 0)"));
+		GeomPtr expected(wktreader.read("LINESTRING (0 0, 2 0, 3 5, 4 0)"));
+
+		GeomPtr simplified = VWSimplifier::simplify(g.get(), 1.0);
+
+		ensure( simplified->equalsExact(expected.get()) );
+	}
+
+	// 2 - PolygonReduction
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		std::string wkt_in("POLYGON ((120 120, 121 121, 122 122, 220 120, \
+					180 199, 160 200, 140 199, 120 120))");
+
+		// (160 200) only forms a triangle of area 20 with its neighbours,
+		// while (122 122) is kept although close to the shell
+		std::string wkt_ex("POLYGON ((120 120, 140 199, 180 199, 220 120, 122 122, 120 120))");
+
+		GeomPtr g(wktreader.read(wkt_in));
+		GeomPtr expected(wktreader.read(wkt_ex));
+
+		GeomPtr simplified = VWSimplifier::simplify(g.get(), 5.0);
+
+		ensure( simplified->isValid() );
+		ensure( simplified->equalsExact(expected.get()) );
+	}
+
+	// 3 - Zero tolerance keeps all vertices, negative one is rejected
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		GeomPtr g(wktreader.read("LINESTRING (0 0, 1 0, 2 0, 2 2)"));
+
+		GeomPtr simplified = VWSimplifier::simplify(g.get(), 0.0);
+		ensure( simplified->equalsExact(g.get()) );
+
+		try {
+			VWSimplifier::simplify(g.get(), -1.0);
+			fail("IllegalArgumentException expected");
+		} catch (const geos::util::IllegalArgumentException&) {
+		}
+	}
+
+	// 4 - Heap elimination and effective areas match the naive algorithm
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		std::vector<Coordinate> pts;
+		for (int i=0; i<500; ++i)
+		{
+			double x = i;
+			double y = 50 * std::sin(i / 40.0) + ((i * 7919) % 13) / 4.0;
+			pts.push_back(Coordinate(x, y));
+		}
+
+		VWLineSimplifier::AreasVectAutoPtr areas =
+			VWLineSimplifier::getEffectiveAreas(pts);
+		ensure_equals( areas->size(), pts.size() );
+		ensure( areas->front() > 1e300 );
+		ensure( areas->back() > 1e300 );
+
+		const double tolerances[] = { 0.5, 1.0, 2.0, 5.0, 20.0 };
+		for (std::size_t t=0; t<5; ++t)
+		{
+			std::vector<Coordinate> expected =
+				naiveSimplify(pts, tolerances[t]);
+
+			VWLineSimplifier::CoordsVectAutoPtr simp =
+				VWLineSimplifier::simplify(pts, tolerances[t]);
+			ensure( *simp == expected );
+
+			simp = VWLineSimplifier::simplify(pts, *areas, tolerances[t]);
+			ensure( *simp == expected );
+		}
+	}
+
+} // namespace tut
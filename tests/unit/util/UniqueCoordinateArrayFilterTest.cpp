@@ -85,5 +85,29 @@ namespace tut
 		ensure_equals( coords.at(2)->y, 30 );
     }	
 
+    // Test of filter_ro() on many coordinates, with signed zeros
+    template<>
+    template<>
+    void object::test<2>()
+    {
+		using geos::geom::Coordinate;
+
+		std::vector<Coordinate> pts;
+		pts.push_back(Coordinate(0.0, -0.0));
+		for (int i=0; i<1000; ++i)
+			pts.push_back(Coordinate(i % 100, i / 100, i));
+		pts.push_back(Coordinate(-0.0, 0.0, 5));
+
+		Coordinate::ConstVect coords;
+		geos::util::UniqueCoordinateArrayFilter filter(coords);
+		for (std::size_t i=0; i<pts.size(); ++i) filter.filter_ro(&pts[i]);
+
+		// first occurrences, in input order
+		ensure_equals( coords.size(), 1000u );
+		ensure( coords.at(0) == &pts[0] );
+		for (std::size_t i=1; i<coords.size(); ++i)
+			ensure( coords.at(i) == &pts[i+1] );
+    }
+
 } // namespace tut
 
@@ -1079,6 +1079,22 @@ XMLTester::parseTest(const TiXmlNode* node)
 			success = checkSingleSidedBufferSuccess(*gRes,
 					*gRealRes, dist);
 
+			// The offset curve, as given by the C API, must
+			// match the same expected result
+			BufferBuilder curveBuilder( params ) ;
+			GeomAutoPtr gCurveRes( curveBuilder.offsetCurve(
+			                             gT, dist, leftSide ) ) ;
+			gCurveRes->normalize();
+			if ( testValidOutput )
+				success &= testValid(gCurveRes.get(), "offset curve");
+			if ( ! checkSingleSidedBufferSuccess(*gRes,
+					*gCurveRes, dist) )
+			{
+				std::cerr << "offsetCurve FAILED" << std::endl;
+				if ( success ) gRealRes = gCurveRes;
+				success = 0;
+			}
+
 			actual_result=printGeom(gRealRes.get());
 			expected_result=printGeom(gRes.get());
 